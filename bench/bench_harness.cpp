@@ -0,0 +1,328 @@
+#include "bench_harness.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <thread>
+#include <unistd.h>
+
+namespace bench {
+
+namespace {
+
+struct Benchmark {
+  std::string name;
+  Function function;
+  int64_t arg;
+};
+
+std::vector<Benchmark> &registry() {
+  static std::vector<Benchmark> benchmarks;
+  return benchmarks;
+}
+
+struct Options {
+  std::string filter;
+  double minTime;
+  int repetitions;
+  std::string outPath;
+};
+
+// One timed run (or an aggregate of several), times per iteration in ns
+struct Result {
+  std::string name;
+  std::string aggregate; // Empty for a plain run
+  int repetitionIndex;
+  int64_t iterations;
+  double realTime;
+  double cpuTime;
+  double itemsPerSecond; // 0 when not reported
+  double bytesPerSecond;
+  std::string error;
+};
+
+const char *flagValue(const char *arg, const char *flag) {
+  size_t length = std::strlen(flag);
+  if (std::strncmp(arg, flag, length) == 0 && arg[length] == '=')
+    return arg + length + 1;
+  return nullptr;
+}
+
+std::string escapeJson(const std::string &text) {
+  std::string escaped;
+  for (char c : text) {
+    if (c == '"' || c == '\\')
+      escaped += '\\';
+    escaped += c;
+  }
+  return escaped;
+}
+
+double mean(const std::vector<double> &values) {
+  double total = 0.0;
+  for (double value : values)
+    total += value;
+  return values.empty() ? 0.0 : total / values.size();
+}
+
+double median(const std::vector<double> &unsorted) {
+  if (unsorted.empty())
+    return 0.0;
+  std::vector<double> values(unsorted);
+  std::sort(values.begin(), values.end());
+  size_t middle = values.size() / 2;
+  return values.size() % 2 ? values[middle]
+                           : 0.5 * (values[middle - 1] + values[middle]);
+}
+
+double stddev(const std::vector<double> &values) {
+  if (values.size() < 2)
+    return 0.0;
+  double average = mean(values), sum = 0.0;
+  for (double value : values)
+    sum += (value - average) * (value - average);
+  return std::sqrt(sum / (values.size() - 1));
+}
+
+void writeJson(const Options &options, const char *executable,
+               const std::vector<Result> &results) {
+  std::ofstream out(options.outPath, std::ios::trunc);
+  if (!out) {
+    std::fprintf(stderr, "Cannot write %s\n", options.outPath.c_str());
+    return;
+  }
+  out.precision(10);
+
+  char date[64];
+  std::time_t now = std::time(nullptr);
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+  char host[256] = "unknown";
+  gethostname(host, sizeof(host) - 1);
+
+  out << "{\n  \"context\": {\n"
+      << "    \"date\": \"" << date << "\",\n"
+      << "    \"host_name\": \"" << escapeJson(host) << "\",\n"
+      << "    \"executable\": \"" << escapeJson(executable) << "\",\n"
+      << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+#ifdef NDEBUG
+      << "    \"library_build_type\": \"release\"\n"
+#else
+      << "    \"library_build_type\": \"debug\"\n"
+#endif
+      << "  },\n  \"benchmarks\": [";
+
+  for (size_t i = 0; i < results.size(); i++) {
+    const Result &result = results[i];
+    std::string runName = escapeJson(result.name);
+    std::string name = runName;
+    if (!result.aggregate.empty())
+      name += "_" + result.aggregate;
+
+    out << (i ? ",\n" : "\n") << "    {\n"
+        << "      \"name\": \"" << name << "\",\n"
+        << "      \"run_name\": \"" << runName << "\",\n"
+        << "      \"run_type\": \""
+        << (result.aggregate.empty() ? "iteration" : "aggregate") << "\",\n"
+        << "      \"repetitions\": " << options.repetitions << ",\n"
+        << "      \"repetition_index\": " << result.repetitionIndex << ",\n";
+    if (!result.aggregate.empty())
+      out << "      \"aggregate_name\": \"" << result.aggregate << "\",\n";
+    if (!result.error.empty()) {
+      out << "      \"error_occurred\": true,\n"
+          << "      \"error_message\": \"" << escapeJson(result.error)
+          << "\",\n";
+    }
+    out << "      \"iterations\": " << result.iterations << ",\n"
+        << "      \"real_time\": " << result.realTime << ",\n"
+        << "      \"cpu_time\": " << result.cpuTime << ",\n";
+    if (result.itemsPerSecond > 0.0)
+      out << "      \"items_per_second\": " << result.itemsPerSecond << ",\n";
+    if (result.bytesPerSecond > 0.0)
+      out << "      \"bytes_per_second\": " << result.bytesPerSecond << ",\n";
+    out << "      \"time_unit\": \"ns\"\n    }";
+  }
+  out << "\n  ]\n}\n";
+}
+
+void printResult(const Result &result) {
+  std::string name = result.name;
+  if (!result.aggregate.empty())
+    name += "_" + result.aggregate;
+  if (!result.error.empty()) {
+    std::printf("%-40s ERROR: %s\n", name.c_str(), result.error.c_str());
+    return;
+  }
+  std::printf("%-40s %14.1f %14.1f %12lld", name.c_str(), result.realTime,
+              result.cpuTime, (long long)result.iterations);
+  if (result.itemsPerSecond > 0.0)
+    std::printf("  %10.3gM items/s", result.itemsPerSecond * 1e-6);
+  if (result.bytesPerSecond > 0.0)
+    std::printf("  %10.1f MB/s", result.bytesPerSecond * 1e-6);
+  std::printf("\n");
+}
+
+} // namespace
+
+State::State(int64_t iterations, int64_t arg)
+    : maxIterations(iterations), remaining(iterations), arg(arg),
+      itemsProcessed(0), bytesProcessed(0), timing(false), realSeconds(0.0),
+      cpuSeconds(0.0), cpuStart(0) {}
+
+void State::startTimer() {
+  timing = true;
+  cpuStart = std::clock();
+  realStart = std::chrono::steady_clock::now();
+}
+
+void State::stopTimer() {
+  if (!timing)
+    return;
+  realSeconds = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - realStart)
+                    .count();
+  cpuSeconds = (double)(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+  timing = false;
+}
+
+void State::skipWithError(const std::string &message) {
+  error = message;
+  remaining = 0;
+}
+
+struct Runner {
+  // Times one run of `iterations` iterations
+  static Result run(const Benchmark &benchmark, int64_t iterations) {
+    State state(iterations, benchmark.arg);
+    benchmark.function(state);
+    state.stopTimer(); // In case the loop was left early
+    double seconds = state.realSeconds;
+    double cpuSeconds = state.cpuSeconds;
+
+    Result result;
+    result.name = benchmark.name;
+    result.repetitionIndex = 0;
+    result.iterations = iterations;
+    result.realTime = 1e9 * seconds / iterations;
+    result.cpuTime = 1e9 * cpuSeconds / iterations;
+    result.itemsPerSecond =
+        seconds > 0.0 ? state.itemsProcessed / seconds : 0.0;
+    result.bytesPerSecond =
+        seconds > 0.0 ? state.bytesProcessed / seconds : 0.0;
+    result.error = state.error;
+    return result;
+  }
+
+  // Grows the iteration count until a run lasts minTime, like Google
+  // Benchmark, and returns that run
+  static Result measure(const Benchmark &benchmark, double minTime) {
+    int64_t iterations = 1;
+    while (true) {
+      Result result = run(benchmark, iterations);
+      double seconds = result.realTime * 1e-9 * iterations;
+      if (!result.error.empty() || seconds >= minTime ||
+          iterations >= 1000000000)
+        return result;
+      double scale = seconds > 0.0 ? 1.4 * minTime / seconds : 10.0;
+      iterations = std::max(iterations + 1,
+                            (int64_t)(iterations * std::min(scale, 10.0)));
+    }
+  }
+};
+
+void add(const std::string &name, Function function) {
+  registry().push_back({name, function, 0});
+}
+
+void add(const std::string &name, Function function, int64_t arg) {
+  registry().push_back({name, function, arg});
+}
+
+void add(const std::string &name, Function function,
+         std::initializer_list<int64_t> args) {
+  for (int64_t arg : args)
+    registry().push_back({name + "/" + std::to_string(arg), function, arg});
+}
+
+int runAll(int argc, char **argv) {
+  Options options;
+  options.minTime = 0.5;
+  options.repetitions = 1;
+  for (int i = 1; i < argc; i++) {
+    const char *value;
+    if ((value = flagValue(argv[i], "--benchmark_filter"))) {
+      options.filter = value;
+    } else if ((value = flagValue(argv[i], "--benchmark_min_time"))) {
+      options.minTime = std::max(0.0, std::atof(value));
+    } else if ((value = flagValue(argv[i], "--benchmark_repetitions"))) {
+      options.repetitions = std::max(1, std::atoi(value));
+    } else if ((value = flagValue(argv[i], "--benchmark_out"))) {
+      options.outPath = value;
+    } else {
+      std::fprintf(stderr,
+                   "Usage: %s [--benchmark_filter=TEXT] "
+                   "[--benchmark_min_time=SEC] [--benchmark_repetitions=N] "
+                   "[--benchmark_out=FILE]\n",
+                   argv[0]);
+      return 1;
+    }
+  }
+
+  std::printf("%-40s %14s %14s %12s\n", "Benchmark", "Time (ns)", "CPU (ns)",
+              "Iterations");
+  std::vector<Result> results;
+  bool failed = false;
+  for (const Benchmark &benchmark : registry()) {
+    if (!options.filter.empty() &&
+        benchmark.name.find(options.filter) == std::string::npos)
+      continue;
+
+    std::vector<Result> runs;
+    for (int repetition = 0; repetition < options.repetitions; repetition++) {
+      Result result = Runner::measure(benchmark, options.minTime);
+      result.repetitionIndex = repetition;
+      printResult(result);
+      runs.push_back(result);
+      results.push_back(result);
+      if (!result.error.empty()) {
+        failed = true;
+        break;
+      }
+    }
+    if (runs.size() < 2 || !runs.back().error.empty())
+      continue;
+
+    // Aggregates over the repetitions
+    std::vector<double> real, cpu, items, bytes;
+    for (const Result &run : runs) {
+      real.push_back(run.realTime);
+      cpu.push_back(run.cpuTime);
+      items.push_back(run.itemsPerSecond);
+      bytes.push_back(run.bytesPerSecond);
+    }
+    const char *names[] = {"mean", "median", "stddev"};
+    double (*functions[])(const std::vector<double> &) = {mean, median,
+                                                          stddev};
+    for (int i = 0; i < 3; i++) {
+      Result aggregate = runs.back();
+      aggregate.aggregate = names[i];
+      aggregate.repetitionIndex = 0;
+      aggregate.iterations = (int64_t)runs.size();
+      aggregate.realTime = functions[i](real);
+      aggregate.cpuTime = functions[i](cpu);
+      aggregate.itemsPerSecond = functions[i](items);
+      aggregate.bytesPerSecond = functions[i](bytes);
+      printResult(aggregate);
+      results.push_back(aggregate);
+    }
+  }
+
+  if (!options.outPath.empty())
+    writeJson(options, argv[0], results);
+  return failed ? 1 : 0;
+}
+
+} // namespace bench
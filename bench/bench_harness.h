@@ -0,0 +1,93 @@
+// Minimal in-tree benchmark harness, modeled on Google Benchmark so results
+// can be tracked with the same tooling: benchmarks loop on
+// State::keepRunning(), the harness grows the iteration count until a run
+// takes --benchmark_min_time, and --benchmark_out writes Google Benchmark's
+// JSON format.
+//
+// Flags:
+//   --benchmark_filter=TEXT     Only names containing TEXT
+//   --benchmark_min_time=SEC    Shortest timed run (default 0.5)
+//   --benchmark_repetitions=N   Repeat each benchmark, report mean/median/
+//                               stddev aggregates as well (default 1)
+//   --benchmark_out=FILE        Write the results as JSON
+
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+class State {
+public:
+  State(int64_t iterations, int64_t arg);
+
+  // True while the timed loop should run another iteration. Only the loop
+  // is timed, not the setup before it.
+  bool keepRunning() {
+    if (remaining > 0) {
+      if (remaining-- == maxIterations)
+        startTimer();
+      return true;
+    }
+    stopTimer();
+    return false;
+  }
+
+  int64_t range() const { return arg; }
+  int64_t iterations() const { return maxIterations; }
+
+  // Throughput: totals over every iteration
+  void setItemsProcessed(int64_t items) { itemsProcessed = items; }
+  void setBytesProcessed(int64_t bytes) { bytesProcessed = bytes; }
+
+  // Reports the benchmark as failed (call before the loop, then return)
+  void skipWithError(const std::string &message);
+
+private:
+  friend struct Runner;
+  void startTimer();
+  void stopTimer();
+
+  int64_t maxIterations;
+  int64_t remaining;
+  int64_t arg;
+  int64_t itemsProcessed;
+  int64_t bytesProcessed;
+  std::string error;
+  bool timing;
+  double realSeconds;
+  double cpuSeconds;
+  std::chrono::steady_clock::time_point realStart;
+  std::clock_t cpuStart;
+};
+
+typedef void (*Function)(State &state);
+
+// Registers `name` once, or once per argument as "name/arg"
+void add(const std::string &name, Function function);
+void add(const std::string &name, Function function, int64_t arg);
+void add(const std::string &name, Function function,
+         std::initializer_list<int64_t> args);
+
+// Runs everything registered; returns the process exit code
+int runAll(int argc, char **argv);
+
+// Keeps the compiler from discarding a result the benchmark never uses
+template <typename T> inline void doNotOptimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void *sink;
+  sink = &value;
+#endif
+}
+
+} // namespace bench
+
+#endif
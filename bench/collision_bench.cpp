@@ -0,0 +1,127 @@
+// Microbenchmark: player sphere against every wall box, comparing the
+// per-wall Physics::checkSphereAABBCollision loop with the batched
+// Physics::sphereAABBBatch. Needs no window or GL context.
+//
+// Usage: collision_bench [iterations]
+
+#include "Physics.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Scene {
+  std::vector<AABB> boxes;
+  AABBArray packed;
+  std::vector<Sphere> queries;
+};
+
+// Walls scattered over a level-sized area, similar in size to the ones the
+// levels build (thin, a few units long)
+Scene makeScene(size_t wallCount, size_t queryCount, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> position(-40.0f, 40.0f);
+  std::uniform_real_distribution<float> length(1.0f, 8.0f);
+  std::uniform_real_distribution<float> height(0.0f, 4.0f);
+
+  Scene scene;
+  scene.packed.resize(wallCount);
+  for (size_t i = 0; i < wallCount; i++) {
+    glm::vec3 center(position(rng), 2.0f, position(rng));
+    glm::vec3 size = (i % 2 == 0) ? glm::vec3(length(rng), 4.0f, 1.0f)
+                                  : glm::vec3(1.0f, 4.0f, length(rng));
+    AABB box = Physics::createAABBFromTransform(center, size);
+    scene.boxes.push_back(box);
+    scene.packed.set(i, box);
+  }
+  for (size_t i = 0; i < queryCount; i++) {
+    scene.queries.push_back(
+        Sphere(glm::vec3(position(rng), height(rng), position(rng)), 0.6f));
+  }
+  return scene;
+}
+
+size_t perWall(const Scene &scene, const Sphere &sphere,
+               std::vector<uint32_t> &hitMask) {
+  hitMask.assign((scene.boxes.size() + 31) / 32, 0u);
+  size_t hits = 0;
+  for (size_t i = 0; i < scene.boxes.size(); i++) {
+    if (Physics::checkSphereAABBCollision(sphere, scene.boxes[i])) {
+      hitMask[i / 32] |= 1u << (i % 32);
+      hits++;
+    }
+  }
+  return hits;
+}
+
+template <typename Fn>
+double timeNsPerTest(const Scene &scene, int iterations, size_t &checksum,
+                     Fn fn) {
+  std::vector<uint32_t> hitMask;
+  auto start = std::chrono::steady_clock::now();
+  for (int it = 0; it < iterations; it++) {
+    for (const Sphere &sphere : scene.queries) {
+      checksum += fn(sphere, hitMask);
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  double ns = std::chrono::duration<double, std::nano>(end - start).count();
+  return ns / ((double)iterations * scene.queries.size() * scene.boxes.size());
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  int iterations = argc > 1 ? std::atoi(argv[1]) : 200;
+  if (iterations <= 0)
+    iterations = 200;
+
+  const size_t wallCounts[] = {16, 64, 256, 1024, 4096};
+  const size_t queryCount = 256;
+
+  std::printf("%8s %14s %14s %9s\n", "walls", "per-wall ns", "batch ns",
+              "speedup");
+
+  for (size_t wallCount : wallCounts) {
+    Scene scene = makeScene(wallCount, queryCount, 1234u);
+
+    // Both paths must agree before their timings mean anything
+    std::vector<uint32_t> expected, actual;
+    for (const Sphere &sphere : scene.queries) {
+      perWall(scene, sphere, expected);
+      Physics::sphereAABBBatch(sphere, scene.packed, actual);
+      if (expected != actual) {
+        std::fprintf(stderr, "Hit masks differ for %zu walls\n", wallCount);
+        return 1;
+      }
+    }
+
+    size_t scalarChecksum = 0, batchChecksum = 0;
+    double scalarNs =
+        timeNsPerTest(scene, iterations, scalarChecksum,
+                      [&scene](const Sphere &sphere,
+                               std::vector<uint32_t> &hitMask) {
+                        return perWall(scene, sphere, hitMask);
+                      });
+    double batchNs =
+        timeNsPerTest(scene, iterations, batchChecksum,
+                      [&scene](const Sphere &sphere,
+                               std::vector<uint32_t> &hitMask) {
+                        return Physics::sphereAABBBatch(sphere, scene.packed,
+                                                        hitMask);
+                      });
+
+    if (scalarChecksum != batchChecksum) {
+      std::fprintf(stderr, "Hit counts differ for %zu walls\n", wallCount);
+      return 1;
+    }
+
+    std::printf("%8zu %14.3f %14.3f %8.2fx\n", wallCount, scalarNs, batchNs,
+                scalarNs / batchNs);
+  }
+
+  return 0;
+}
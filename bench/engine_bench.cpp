@@ -0,0 +1,186 @@
+// Engine microbenchmarks: collision tests, particle simulation, shape
+// generation, transform matrices and WAV decoding. Links the engine sources
+// directly; needs no window or GL context. Run it from the build directory
+// so the audio benchmarks find assets/sounds.
+//
+// Usage: engine_bench [--benchmark_filter=TEXT] [--benchmark_out=FILE] ...
+// (flags in bench_harness.h)
+
+#include "Mesh.h"
+#include "ParticleSystem.h"
+#include "Physics.h"
+#include "Transform.h"
+#include "WavDecoder.h"
+#include "bench_harness.h"
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Query pairs per iteration of the physics benchmarks
+const int kPhysicsPairs = 1024;
+
+struct PhysicsScene {
+  std::vector<AABB> boxes;
+  std::vector<Sphere> spheres;
+  std::vector<glm::vec3> rayOrigins;
+  std::vector<glm::vec3> rayDirections;
+};
+
+// Level-sized scatter of wall boxes with spheres and rays around them; about
+// a third of the pairs hit
+const PhysicsScene &physicsScene() {
+  static PhysicsScene scene;
+  if (!scene.boxes.empty())
+    return scene;
+
+  std::mt19937 rng(1234u);
+  std::uniform_real_distribution<float> position(-40.0f, 40.0f);
+  std::uniform_real_distribution<float> length(1.0f, 8.0f);
+  std::uniform_real_distribution<float> offset(-3.0f, 3.0f);
+  for (int i = 0; i < kPhysicsPairs; i++) {
+    glm::vec3 center(position(rng), 2.0f, position(rng));
+    glm::vec3 size(length(rng), 4.0f, 1.0f);
+    scene.boxes.push_back(Physics::createAABBFromTransform(center, size));
+
+    glm::vec3 near(center.x + offset(rng), 1.0f, center.z + offset(rng));
+    scene.spheres.push_back(Sphere(near, 0.6f));
+    scene.rayOrigins.push_back(near + glm::vec3(0.0f, 0.0f, 10.0f));
+    scene.rayDirections.push_back(
+        glm::normalize(center - scene.rayOrigins.back() +
+                       glm::vec3(offset(rng), 0.0f, 0.0f)));
+  }
+  return scene;
+}
+
+void physicsSphereAABB(bench::State &state) {
+  const PhysicsScene &scene = physicsScene();
+  while (state.keepRunning()) {
+    int hits = 0;
+    for (int i = 0; i < kPhysicsPairs; i++)
+      hits += Physics::checkSphereAABBCollision(scene.spheres[i],
+                                                scene.boxes[i]);
+    bench::doNotOptimize(hits);
+  }
+  state.setItemsProcessed(state.iterations() * kPhysicsPairs);
+}
+
+void physicsRayAABB(bench::State &state) {
+  const PhysicsScene &scene = physicsScene();
+  while (state.keepRunning()) {
+    float total = 0.0f;
+    for (int i = 0; i < kPhysicsPairs; i++) {
+      float t;
+      if (Physics::rayIntersectAABB(scene.rayOrigins[i],
+                                    scene.rayDirections[i], scene.boxes[i],
+                                    t))
+        total += t;
+    }
+    bench::doNotOptimize(total);
+  }
+  state.setItemsProcessed(state.iterations() * kPhysicsPairs);
+}
+
+// A full pool of long-lived particles, stepped at the game's tick rate
+void particlesUpdate(bench::State &state) {
+  const int count = (int)state.range();
+  ParticleSystem particles(count);
+  std::srand(1);
+  particles.emit(glm::vec3(0.0f, 5.0f, 0.0f), glm::vec3(0.0f, 4.0f, 0.0f),
+                 glm::vec4(1.0f), 0.2f, 1e9f, count);
+  while (state.keepRunning()) {
+    particles.update(1.0f / 120.0f);
+    bench::doNotOptimize(particles.getParticles()[0]);
+  }
+  state.setItemsProcessed(state.iterations() * count);
+}
+
+void meshSphere(bench::State &state) {
+  const int sectors = (int)state.range();
+  size_t vertices = 0;
+  while (state.keepRunning()) {
+    MeshData mesh = Mesh::generateSphere(1.0f, sectors, sectors / 2);
+    vertices = mesh.vertices.size();
+    bench::doNotOptimize(mesh.indices.data());
+  }
+  state.setItemsProcessed(state.iterations() * (int64_t)vertices);
+}
+
+void meshCylinder(bench::State &state) {
+  const int sectors = (int)state.range();
+  size_t vertices = 0;
+  while (state.keepRunning()) {
+    MeshData mesh = Mesh::generateCylinder(1.0f, 2.0f, sectors);
+    vertices = mesh.vertices.size();
+    bench::doNotOptimize(mesh.indices.data());
+  }
+  state.setItemsProcessed(state.iterations() * (int64_t)vertices);
+}
+
+void transformModelMatrix(bench::State &state) {
+  const int count = 1024;
+  std::mt19937 rng(7u);
+  std::uniform_real_distribution<float> value(-10.0f, 10.0f);
+  std::vector<Transform> transforms(count);
+  for (Transform &transform : transforms) {
+    transform.position = glm::vec3(value(rng), value(rng), value(rng));
+    transform.setRotation(glm::vec3(value(rng), value(rng), value(rng)));
+    transform.scale = glm::vec3(1.0f + std::abs(value(rng)));
+  }
+
+  while (state.keepRunning()) {
+    for (const Transform &transform : transforms) {
+      glm::mat4 model = transform.getModelMatrix();
+      bench::doNotOptimize(model);
+    }
+  }
+  state.setItemsProcessed(state.iterations() * count);
+}
+
+// One sound of each sample format the game ships
+const char *const kWavFiles[] = {
+    "assets/sounds/door_open.wav",    // 8-bit
+    "assets/sounds/coin_collect.wav", // 16-bit
+    "assets/sounds/win_jingle.wav",   // 24-bit
+    "assets/sounds/thud_hit.wav",     // 32-bit
+};
+const char *const kWavFormats[] = {"8bit", "16bit", "24bit", "32bit"};
+
+// Decoding only: the file is read before the timed loop
+void audioDecodeWav(bench::State &state) {
+  const char *path = kWavFiles[state.range()];
+  std::ifstream file(path, std::ios::binary);
+  std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(file)),
+                                   std::istreambuf_iterator<char>());
+  if (bytes.empty()) {
+    state.skipWithError(std::string("cannot read ") + path);
+    return;
+  }
+
+  std::vector<short> samples;
+  int sampleRate = 0;
+  while (state.keepRunning()) {
+    decodeWav(bytes.data(), bytes.size(), samples, sampleRate, path);
+    bench::doNotOptimize(samples.data());
+  }
+  state.setBytesProcessed(state.iterations() * (int64_t)bytes.size());
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  bench::add("Physics/SphereAABB", physicsSphereAABB);
+  bench::add("Physics/RayAABB", physicsRayAABB);
+  bench::add("ParticleSystem/Update", particlesUpdate, {1000, 10000, 100000});
+  bench::add("Mesh/GenerateSphere", meshSphere, {12, 36, 96});
+  bench::add("Mesh/GenerateCylinder", meshCylinder, {12, 36, 96});
+  bench::add("Transform/GetModelMatrix", transformModelMatrix);
+  for (int i = 0; i < 4; i++) {
+    bench::add(std::string("Audio/DecodeWav/") + kWavFormats[i],
+               audioDecodeWav, i);
+  }
+  return bench::runAll(argc, argv);
+}
@@ -0,0 +1,23 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstddef>
+
+// Debug heap allocation counter. When the project is configured with
+// -DCHRONO_TRACK_ALLOCATIONS=ON, AllocationCounter.cpp replaces the global
+// operator new/delete and counts every heap allocation; otherwise all
+// counts read as zero and the hooks cost nothing.
+class AllocationCounter {
+public:
+  static bool isEnabled();
+
+  // Total allocations since program start
+  static size_t totalAllocations();
+  static size_t totalBytes();
+
+  // Per-frame bookkeeping - endFrame() returns allocations since beginFrame()
+  static void beginFrame();
+  static size_t endFrame();
+};
+
+#endif
@@ -63,8 +63,6 @@ private:
                         float duration, int sampleRate);
   void generateNoiseWave(std::vector<short> &buffer, float duration,
                          int sampleRate);
-  bool loadWavFile(const std::string &filename, std::vector<short> &buffer,
-                   int &sampleRate);
   ALuint createBuffer(const std::vector<short> &data, int sampleRate);
   ALuint createSource();
 };
@@ -36,6 +36,8 @@ public:
     
     void setFirstPersonMode(const glm::vec3& playerPos);
     void setThirdPersonMode(const glm::vec3& playerPos);
+    // Free camera (scripted paths): first person at `eye`, looking along `direction`
+    void setFreeView(const glm::vec3& eye, const glm::vec3& direction);
     void toggleMode();
 
 private:
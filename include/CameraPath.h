@@ -0,0 +1,39 @@
+#ifndef CAMERA_PATH_H
+#define CAMERA_PATH_H
+
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+
+// A timed camera path: keys of (time, position, look-at target), played back
+// as a Catmull-Rom spline through them. Saved as text, one key per line:
+//
+//   time  x y z  targetX targetY targetZ
+//
+// Lines starting with '#' are comments. Paths are recorded from play with
+// --record-path and replayed by the flythrough benchmark.
+class CameraPath {
+public:
+  struct Key {
+    float time; // Seconds from the start of the path
+    glm::vec3 position;
+    glm::vec3 target;
+  };
+
+  void addKey(float time, const glm::vec3 &position, const glm::vec3 &target);
+  void clear() { keys.clear(); }
+
+  bool load(const std::string &path);
+  bool save(const std::string &path) const;
+
+  size_t getKeyCount() const { return keys.size(); }
+  float getDuration() const { return keys.empty() ? 0.0f : keys.back().time; }
+
+  // Position and view direction at `time`, clamped to the path's ends
+  void sample(float time, glm::vec3 &position, glm::vec3 &front) const;
+
+private:
+  std::vector<Key> keys; // Sorted by time
+};
+
+#endif
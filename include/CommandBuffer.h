@@ -0,0 +1,48 @@
+#ifndef COMMAND_BUFFER_H
+#define COMMAND_BUFFER_H
+
+#include "AudioManager.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+class ParticleSystem;
+
+// Deferred side effects recorded from inside parallel jobs. Each thread of
+// the JobSystem writes only to its own buffer; flushAll() replays every
+// buffer in thread order on the main thread once the parallel section is
+// done, so AudioManager and ParticleSystem are never touched concurrently.
+class CommandBuffer {
+public:
+  // Buffer belonging to the calling thread
+  static CommandBuffer &local();
+
+  // Replay and clear all buffers (main thread only)
+  static void flushAll(ParticleSystem *particles);
+
+  void playSound(SoundEffect effect, float volume);
+  void emit(const glm::vec3 &position, const glm::vec3 &velocity,
+            const glm::vec4 &color, float size, float lifetime, int count);
+  void emitExplosion(const glm::vec3 &position, const glm::vec3 &color,
+                     int count);
+
+private:
+  enum class CommandType { PLAY_SOUND, EMIT, EMIT_EXPLOSION };
+
+  struct Command {
+    CommandType type;
+    SoundEffect sound;
+    float volume;
+    glm::vec3 position;
+    glm::vec3 velocity;
+    glm::vec4 color;
+    float size;
+    float lifetime;
+    int count;
+  };
+
+  void flush(ParticleSystem *particles);
+
+  std::vector<Command> commands;
+};
+
+#endif
@@ -0,0 +1,163 @@
+#ifndef ENTITY_STORE_H
+#define ENTITY_STORE_H
+
+#include "Mesh.h"
+#include "Physics.h"
+#include "StateBuffer.h"
+#include "Transform.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct RenderInstance;
+struct RenderSnapshot;
+class Player;
+class ParticleSystem;
+
+// Per-entity draw parameters (mesh is shared and owned by the store)
+struct RenderInfo {
+  Mesh *mesh;
+  glm::vec3 color;
+  float transparency;
+  float emissive;
+  int materialType;
+  bool active;
+
+  RenderInfo()
+      : mesh(nullptr), color(1.0f), transparency(1.0f), emissive(0.0f),
+        materialType(0), active(true) {}
+};
+
+// Hazard motion is a pure function of the store clock, so any hazard can be
+// evaluated at any time without replaying the ticks in between.
+
+// Swinging pendulum blades, one array per parameter. The swing angle at time
+// t is sin(phase + swingSpeed * t) * maxAngle.
+struct PendulumParams {
+  std::vector<glm::vec3> pivotPoint;
+  std::vector<float> length;
+  std::vector<float> phase;
+  std::vector<float> swingSpeed;
+  std::vector<float> maxAngle; // Radians
+
+  size_t size() const { return phase.size(); }
+  void clear();
+};
+
+// Falling stalactite. Falls start at random times, so each fall is anchored
+// to the clock time it started; the drop itself is closed-form.
+struct StalactiteState {
+  glm::vec3 originalPosition;
+  double fallAt; // Clock time the next (or current) fall starts
+  bool isFalling;
+  uint32_t rngState; // Per-entity RNG so updates can run on any thread
+};
+
+// Geyser vent. Erupts for eruptDuration at the end of every
+// eruptInterval + eruptDuration cycle.
+struct GeyserState {
+  float eruptDuration;
+  float eruptInterval;
+  float phase; // Seconds into the cycle at time 0
+  glm::vec3 pushForce;
+};
+
+// Activity culling. Entities far from the player and off screen sleep: no
+// update, no bounds maintenance, no draw. Their motion depends only on the
+// clock, so on waking they are simply evaluated at the current time.
+struct ActivityState {
+  AABB bounds; // Everything the entity can reach or show, over its motion
+  bool awake;
+};
+
+// Dense storage for the level's animated hazards. Shared components live in
+// arrays indexed by entity id; each hazard kind keeps its state in its own
+// array alongside the list of entity ids it applies to, so the update, draw
+// and collision systems walk contiguous memory of a single type instead of
+// chasing pointers through a virtual hierarchy.
+class EntityStore {
+public:
+  // Shared components, indexed by entity id
+  std::vector<Transform> transforms;
+  std::vector<AABB> boxes;
+  std::vector<Sphere> spheres;
+  std::vector<RenderInfo> render;
+  std::vector<ActivityState> activity;
+
+  // Per-kind state, parallel to the matching id list
+  std::vector<uint32_t> pendulumIds;
+  PendulumParams pendulums;
+  OBBArray pendulumBoxes; // Oriented blade boxes, for the batched test
+  std::vector<uint32_t> stalactiteIds;
+  std::vector<StalactiteState> stalactites;
+  std::vector<uint32_t> geyserIds;
+  std::vector<GeyserState> geysers;
+
+  EntityStore();
+  EntityStore(const EntityStore &) = delete;
+  EntityStore &operator=(const EntityStore &) = delete;
+
+  uint32_t addPendulum(const glm::vec3 &pivot, float length, float swingSpeed,
+                       float swingAngle, const glm::vec3 &scale);
+  uint32_t addStalactite(const glm::vec3 &position, const glm::vec3 &scale);
+  uint32_t addGeyser(const glm::vec3 &position);
+
+  // Grow every array once before adding a known number of hazards
+  void reserve(size_t pendulumCount, size_t stalactiteCount,
+               size_t geyserCount);
+
+  size_t size() const { return transforms.size(); }
+  void clear();
+
+  // Everything that changes after the hazards are added (per-entity
+  // components, stalactite falls, the clock); parameters are left alone
+  void saveState(StateBuffer &state) const;
+  void restoreState(StateBuffer &state);
+
+  // Wake entities near the player or in view, put the rest to sleep. Call
+  // once per tick before update().
+  void updateActivity(const glm::vec3 &playerPosition, const Frustum &view);
+  size_t getAwakeCount() const;
+
+  // Closed-form queries at an arbitrary clock time
+  double getClock() const { return clock; }
+  float getPendulumAngle(size_t index, double time) const;
+  bool isGeyserErupting(size_t index, double time) const;
+  bool isGeyserErupting(size_t index) const {
+    return isGeyserErupting(index, clock);
+  }
+
+  // Systems (update runs each kind as a parallel-for on the JobSystem)
+  void update(float deltaTime);
+  void draw(RenderSnapshot &snapshot) const;
+  void checkPlayerCollisions(Player *player, ParticleSystem *particles);
+
+  // Start a stalactite falling (index into stalactites, not an entity id)
+  void triggerStalactite(size_t index);
+
+private:
+  uint32_t addEntity(const Transform &transform, Mesh *mesh,
+                     const glm::vec3 &color);
+
+  double clock; // Simulated seconds since the store was filled
+
+  void refreshActivity(uint32_t id, const glm::vec3 &playerPosition,
+                       const Frustum &view);
+
+  // Evaluate awake entities at the current clock
+  void updatePendulums(size_t begin, size_t end);
+  void updateStalactites(size_t begin, size_t end);
+  void updateGeysers(size_t begin, size_t end);
+  void poseBlade(size_t index); // Transform and boxes at the current clock
+  RenderInstance &drawEntity(RenderSnapshot &snapshot, uint32_t id,
+                             const glm::vec3 &color) const;
+
+  // One mesh per hazard kind, shared by every instance
+  std::unique_ptr<Mesh> pendulumMesh;
+  std::unique_ptr<Mesh> stalactiteMesh;
+  std::unique_ptr<Mesh> geyserMesh;
+
+  std::vector<uint32_t> hitMask; // Scratch for checkPlayerCollisions
+};
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef FRAME_ALLOCATOR_H
+#define FRAME_ALLOCATOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+// Linear (bump) allocator for data that only lives for one frame.
+// Memory is handed out by advancing an offset and released all at once by
+// reset() at the start of the next frame. If a frame needs more than the
+// current capacity, the overflow is served from the heap and the buffer is
+// grown to the observed peak on the next reset, so steady-state frames never
+// touch the heap. Only trivially destructible types should be placed here.
+class FrameAllocator {
+public:
+  static FrameAllocator &getInstance() {
+    static FrameAllocator instance;
+    return instance;
+  }
+
+  void *allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+    uintptr_t base = reinterpret_cast<uintptr_t>(buffer.get());
+    uintptr_t aligned = (base + offset + alignment - 1) & ~(alignment - 1);
+    size_t newOffset = (aligned - base) + size;
+
+    if (newOffset <= capacity) {
+      offset = newOffset;
+      peak = std::max(peak, offset);
+      return reinterpret_cast<void *>(aligned);
+    }
+
+    // Out of space this frame - fall back to the heap and remember how much
+    // we would have needed
+    overflowBytes += size + alignment;
+    peak = std::max(peak, capacity + overflowBytes);
+    overflow.emplace_back(new unsigned char[size + alignment]);
+    uintptr_t raw = reinterpret_cast<uintptr_t>(overflow.back().get());
+    return reinterpret_cast<void *>((raw + alignment - 1) & ~(alignment - 1));
+  }
+
+  template <typename T> T *allocArray(size_t count) {
+    return static_cast<T *>(allocate(sizeof(T) * count, alignof(T)));
+  }
+
+  // Release everything allocated since the last reset
+  void reset() {
+    if (!overflow.empty()) {
+      overflow.clear();
+      grow(peak);
+    }
+    offset = 0;
+    overflowBytes = 0;
+  }
+
+  size_t bytesUsed() const { return offset + overflowBytes; }
+  size_t getCapacity() const { return capacity; }
+  size_t peakBytes() const { return peak; }
+
+private:
+  FrameAllocator() : capacity(0), offset(0), peak(0), overflowBytes(0) {
+    grow(256 * 1024); // 256 KB is plenty for the shipped levels
+    overflow.reserve(16);
+  }
+  FrameAllocator(const FrameAllocator &) = delete;
+  FrameAllocator &operator=(const FrameAllocator &) = delete;
+
+  void grow(size_t newCapacity) {
+    if (newCapacity <= capacity)
+      return;
+    buffer.reset(new unsigned char[newCapacity]);
+    capacity = newCapacity;
+  }
+
+  std::unique_ptr<unsigned char[]> buffer;
+  size_t capacity;
+  size_t offset;
+  size_t peak;
+  size_t overflowBytes;
+  std::vector<std::unique_ptr<unsigned char[]>> overflow;
+};
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+#include <GL/glew.h>
+#include <string>
+#include <vector>
+
+// Saves rendered frames as PNG files without stalling the pipeline.
+// capture() only starts an asynchronous copy of the framebuffer into one of
+// a ring of pixel buffer objects; the pixels are mapped and written by a
+// later poll(), once the GPU has finished the copy. With the ring deep
+// enough, the CPU never waits for the GPU.
+class FrameCapture {
+public:
+  FrameCapture();
+  ~FrameCapture();
+
+  // Allocates the pixel buffers (GL context required)
+  void init(int width, int height);
+  void cleanup();
+
+  // Reads the current read framebuffer (color attachment 0 of an FBO, or
+  // the back buffer before the swap) into `path` later
+  void capture(const std::string &path);
+
+  // Writes the captures whose copy has finished; with `wait` set, blocks
+  // until every queued capture is written
+  void poll(bool wait);
+
+private:
+  static const int kBufferCount = 3;
+
+  struct Slot {
+    GLuint pixelBuffer;
+    GLsync fence; // Null when the slot is free
+    std::string path;
+  };
+
+  Slot slots[kBufferCount];
+  int nextSlot;
+  int width;
+  int height;
+
+  // Writes the slot's file if its copy is done (or always, with `wait`)
+  bool finish(Slot &slot, bool wait);
+};
+
+#endif
@@ -2,20 +2,28 @@
 #define GAME_H
 
 #include "Camera.h"
+#include "CameraPath.h"
+#include "GameSettings.h"
+#include "HeadlessContext.h"
+#include "Input.h"
 #include "Level.h"
 #include "ParticleSystem.h"
 #include "Player.h"
-#include "Shader.h"
+#include "RenderSnapshot.h"
+#include "Renderer.h"
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
-
-enum class GameState { START_SCREEN, MENU, LEVEL1, LEVEL2, WIN, GAME_OVER };
+#include <thread>
 
 class Game {
 public:
-  Game();
+  Game(const GameSettings &settings = GameSettings());
   ~Game();
 
   bool init();
@@ -30,23 +38,24 @@ public:
   static Game *instance; // Singleton for GLFW callbacks
 
 private:
-  GLFWwindow *window;
+  GameSettings settings;
+  GLFWwindow *window; // Null with --headless
+  HeadlessContext headlessContext;
   int screenWidth;
   int screenHeight;
 
-  std::unique_ptr<Shader> mainShader;
-  std::unique_ptr<Shader> particleShader;
-  std::unique_ptr<Shader> startScreenShader;
-  std::unique_ptr<Shader> gameOverShader;
-  std::unique_ptr<Shader> winScreenShader;
+  Renderer renderer;
   std::unique_ptr<Camera> camera;
   std::unique_ptr<Player> player;
-  std::unique_ptr<Level> currentLevel;
+  Level *currentLevel; // One of `levels`, or null outside the levels
+
+  // Levels are built once and kept; replaying one restores the state it had
+  // right after init() instead of rebuilding it
+  static const int kLevelCount = 2;
+  std::unique_ptr<Level> levels[kLevelCount];
   std::unique_ptr<ParticleSystem> particles;
 
-  // Start screen / Game over / Win screen (share VAO/VBO)
-  GLuint startScreenVAO;
-  GLuint startScreenVBO;
+  // Screen animation timers
   float startScreenTime;
   float gameOverTime;
   float winScreenTime;
@@ -55,28 +64,69 @@ private:
   int currentLevelIndex;
 
   float deltaTime;
-  float lastFrame;
   bool running;
 
-  void processInput();
-  void update();
-  void render();
+  // Simulation / render split. Each frame the main thread kicks the
+  // simulation thread, which catches up in fixed steps and publishes a
+  // RenderSnapshot per tick; the main thread owns the window, GL and input,
+  // and draws the newest snapshots.
+  SnapshotQueue snapshots;
+  std::thread simThread;
+  std::mutex simMutex;
+  std::condition_variable simWake;
+  InputFrame pendingInput; // Input gathered since the last tick started
+  bool frameRequested;
+  bool simBusy;
+  bool simStopping;
+  double lastTickTime;
+  uint64_t tickCount;
+  std::atomic<size_t> scratchPeakBytes; // For the allocation report
+  std::atomic<float> viewAspect; // Window aspect ratio, for sim-side culling
+
+  // --record-path: camera keys sampled while playing, saved on exit
+  CameraPath recordedPath;
+  double recordClock;
+  double nextRecordTime;
+
+  // Fixed-step simulation
+  double fixedStep;                     // Seconds per tick (1 / tick rate)
+  double accumulator;                   // Real time not yet simulated
+  InputFrame tickInput;                 // Input not yet consumed by a tick
+  std::atomic<uint64_t> ticksSimulated; // For the stats report
+
+  // Level changes create and destroy GL objects, so the simulation only
+  // records them here and the main thread performs them while it is parked
+  static const int kNoLevelRequest = -1;
+  static const int kUnloadLevel = -2; // Back to the start screen
+  int pendingLevel;
 
+  // init() without a window (EGL), and the part both paths share: GL
+  // state, audio, renderer, camera, player and particles
+  bool initHeadless();
+  bool initWorld();
+
+  void simulationLoop();
+  void stopSimulation();
+  void advance(const InputFrame &input);
+  void simulate(const InputFrame &input, float dt);
+  void publishSnapshot(double time, float tickFraction);
+  void buildSnapshot(RenderSnapshot &snapshot) const;
+  void applyLevelRequest();
+  // Draws the newest snapshots; returns the state that was drawn
+  GameState renderFrame();
+
+  void processInput(const InputFrame &input);
+  void update(const InputFrame &input);
+
+  // --flythrough: render a level along a camera path, no simulation thread
+  void runFlythrough();
+
+  void requestLevel(int levelIndex);
   void loadLevel(int levelIndex);
   void restartLevel();
   void nextLevel();
-  
-  void initStartScreen();
-  void renderStartScreen();
-  void renderGameOver();
-  void renderWinScreen();
-  void renderHearts(); // Render heart UI
-  bool anyKeyPressed();
-
-  glm::vec3 getMovementInput();
-  
-  // Heart model for UI
-  std::unique_ptr<Model> heartModel;
+
+  glm::vec3 getMovementInput(const InputFrame &input) const;
 };
 
 #endif
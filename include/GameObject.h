@@ -5,12 +5,13 @@
 #include "Mesh.h"
 #include "Model.h"
 #include "Physics.h"
+#include "StateBuffer.h"
 #include "Texture.h"
 #include "Transform.h"
 #include <memory>
 #include <string>
 
-class Shader; // Forward declaration
+struct RenderSnapshot; // Forward declaration
 
 enum class GameObjectType {
   STATIC_WALL,
@@ -41,7 +42,9 @@ public:
   bool isTrigger;
 
   // Collision
-  AABB boundingBox;
+  AABB boundingBox; // Encloses orientedBox when the object is rotated
+  OBB orientedBox;
+  bool isRotated; // Collide against orientedBox instead of boundingBox
   Sphere boundingSphere;
   bool useSphereCollision;
 
@@ -53,27 +56,18 @@ public:
   loadCachedModel(const std::string &path); // Use cached model for efficiency
 
   virtual void update(float deltaTime);
-  virtual void draw(Shader *shader);
+  virtual void draw(RenderSnapshot &snapshot) const;
   virtual void onTrigger() {}
 
+  // Mutable state (everything except GPU resources) for in-place restarts.
+  // Subclasses append their own fields after calling the base version.
+  virtual void saveState(StateBuffer &state) const;
+  virtual void restoreState(StateBuffer &state);
+
   void updateBoundingBox();
   void updateBoundingSphere(float radius);
 };
 
-// Swinging Pendulum
-class Pendulum : public GameObject {
-public:
-  float swingAngle;
-  float swingSpeed;
-  float maxAngle;
-  glm::vec3 pivotPoint;
-  float length;
-
-  Pendulum(const glm::vec3 &pivot, float length);
-  void update(float deltaTime) override;
-  void draw(Shader *shader) override;
-};
-
 // Crumbling Tile
 class CrumblingTile : public GameObject {
 public:
@@ -86,33 +80,8 @@ public:
   CrumblingTile(const glm::vec3 &position);
   void update(float deltaTime) override;
   void onTrigger() override;
-};
-
-// Falling Stalactite
-class Stalactite : public GameObject {
-public:
-  bool isFalling;
-  float fallSpeed;
-  float fallTimer; // Timer for random falling
-  glm::vec3 originalPosition;
-
-  Stalactite(const glm::vec3 &position);
-  void update(float deltaTime) override;
-  void onTrigger() override;
-};
-
-// Geyser Vent
-class Geyser : public GameObject {
-public:
-  float eruptTimer;
-  float eruptDuration;
-  float eruptInterval;
-  bool isErupting;
-  glm::vec3 pushForce;
-
-  Geyser(const glm::vec3 &position);
-  void update(float deltaTime) override;
-  void draw(Shader *shader) override;
+  void saveState(StateBuffer &state) const override;
+  void restoreState(StateBuffer &state) override;
 };
 
 // Collectible (Crystal/Gemstone)
@@ -139,8 +108,11 @@ public:
   Collectible(const glm::vec3 &position, const glm::vec3 &color);
   // void loadModel(const std::string& path); // Moved to GameObject
   void update(float deltaTime) override;
-  void draw(Shader *shader) override;
+  void draw(RenderSnapshot &snapshot) const override;
   void collect();
+  float getBobHeight() const; // Vertical bob offset at the current phase
+  void saveState(StateBuffer &state) const override;
+  void restoreState(StateBuffer &state) override;
 };
 
 // Health Pickup (Heart power-up)
@@ -154,8 +126,10 @@ public:
 
   HealthPickup(const glm::vec3 &position);
   void update(float deltaTime) override;
-  void draw(Shader *shader) override;
+  void draw(RenderSnapshot &snapshot) const override;
   void collect();
+  void saveState(StateBuffer &state) const override;
+  void restoreState(StateBuffer &state) override;
 };
 
 #endif
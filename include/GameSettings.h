@@ -0,0 +1,67 @@
+#ifndef GAME_SETTINGS_H
+#define GAME_SETTINGS_H
+
+#include <cstdint>
+#include <string>
+
+// Object counts for the procedurally generated stress level
+struct StressLevelConfig {
+  uint32_t seed;
+  int walls;
+  int pendulums;
+  int stalactites;
+  int geysers;
+  int lights;
+  int particles; // Kept alive in the particle system at all times
+
+  StressLevelConfig()
+      : seed(1), walls(10000), pendulums(5000), stalactites(1000),
+        geysers(1000), lights(500), particles(100000) {}
+
+  // Every count multiplied by `factor` (at least one of each)
+  StressLevelConfig scaled(float factor) const;
+};
+
+// Start-up options, filled from the command line
+struct GameSettings {
+  int windowWidth;
+  int windowHeight;
+  bool threadedSimulation; // Run the simulation on its own thread
+  int tickRate;            // Fixed simulation steps per second
+  bool showStats;          // Print frame rate and ticks per frame
+  bool showHelp;           // --help was passed, print usage and exit
+  bool hotReload;          // Rebuild shaders when their files change
+  float menuScale;         // Start/game over/win screen resolution factor
+  int menuFps;             // Frame rate cap on those screens, 0 = none
+
+  // Scalability testing
+  bool stressLevel;         // Play the generated stress level as level 1
+  StressLevelConfig stress; // Its object counts
+  std::string stressBenchmarkPath; // Run the headless benchmark, CSV here
+  int benchmarkTicks;              // Timed ticks per benchmark step
+
+  // Render benchmark: fly a camera path through a level
+  std::string flythroughPath; // Run the flythrough, per-frame CSV here
+  std::string cameraPath;     // Path to fly (default levels/levelN.path)
+  int flythroughLevel;        // 1 or 2
+  int flythroughFrames;
+  bool offscreen;             // Hidden window, render into an FBO
+  std::string recordPath;     // Record the camera path while playing
+
+  // No window system: EGL context, offscreen rendering (benchmarks only)
+  bool headless;
+  std::string captureDir; // Save flythrough frames as PNG here
+  int captureEvery;       // Every Nth frame
+
+  GameSettings()
+      : windowWidth(1280), windowHeight(720), threadedSimulation(true),
+        tickRate(120), showStats(false), showHelp(false), hotReload(false),
+        menuScale(0.5f), menuFps(30), stressLevel(false),
+        benchmarkTicks(300), flythroughLevel(1), flythroughFrames(1000),
+        offscreen(false), headless(false), captureEvery(1) {}
+
+  static GameSettings fromArgs(int argc, char **argv);
+  static void printUsage(const char *program);
+};
+
+#endif
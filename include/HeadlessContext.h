@@ -0,0 +1,29 @@
+#ifndef HEADLESS_CONTEXT_H
+#define HEADLESS_CONTEXT_H
+
+// OpenGL 3.3 core context with no window system behind it, for machines
+// without a display server or GPU (CI). It is created through EGL on Mesa's
+// surfaceless platform, so with LIBGL_ALWAYS_SOFTWARE=1 it runs on llvmpipe.
+// There is no default framebuffer: everything must be drawn into an FBO.
+//
+// The backend is compiled in with CHRONO_HEADLESS (on when CMake finds
+// EGL); without it, create() just reports that it is missing.
+class HeadlessContext {
+public:
+  HeadlessContext();
+  ~HeadlessContext();
+  HeadlessContext(const HeadlessContext &) = delete;
+  HeadlessContext &operator=(const HeadlessContext &) = delete;
+
+  // Creates the context, makes it current and initializes GLEW
+  bool create();
+  void destroy();
+
+  bool isCreated() const { return context != nullptr; }
+
+private:
+  void *display; // EGLDisplay
+  void *context; // EGLContext
+};
+
+#endif
@@ -23,6 +23,58 @@
 #define MOUSE_BUTTON_RIGHT GLFW_MOUSE_BUTTON_RIGHT
 #define MOUSE_BUTTON_MIDDLE GLFW_MOUSE_BUTTON_MIDDLE
 
+// Input gathered on the main thread for one simulation tick. The simulation
+// thread never reads Input directly, it only sees these frames.
+struct InputFrame {
+  // Held state (latest sample wins when frames are merged)
+  bool moveForward;
+  bool moveBack;
+  bool moveLeft;
+  bool moveRight;
+  bool rotateLeft;
+  bool rotateRight;
+
+  // Edges and "any key" (kept if seen in any merged frame)
+  bool jumpPressed;
+  bool restartPressed;
+  bool toggleCameraPressed;
+  bool anyKeyPressed; // Any key or mouse button except ESC
+
+  glm::vec2 mouseDelta; // Summed across merged frames
+
+  InputFrame()
+      : moveForward(false), moveBack(false), moveLeft(false),
+        moveRight(false), rotateLeft(false), rotateRight(false),
+        jumpPressed(false), restartPressed(false),
+        toggleCameraPressed(false), anyKeyPressed(false), mouseDelta(0.0f) {}
+
+  // Fold a newer frame into this one when the simulation fell behind
+  void merge(const InputFrame &next) {
+    moveForward = next.moveForward;
+    moveBack = next.moveBack;
+    moveLeft = next.moveLeft;
+    moveRight = next.moveRight;
+    rotateLeft = next.rotateLeft;
+    rotateRight = next.rotateRight;
+
+    jumpPressed = jumpPressed || next.jumpPressed;
+    restartPressed = restartPressed || next.restartPressed;
+    toggleCameraPressed = toggleCameraPressed || next.toggleCameraPressed;
+    anyKeyPressed = anyKeyPressed || next.anyKeyPressed;
+
+    mouseDelta += next.mouseDelta;
+  }
+
+  // Presses and mouse motion count for one simulation tick only
+  void clearEdges() {
+    jumpPressed = false;
+    restartPressed = false;
+    toggleCameraPressed = false;
+    anyKeyPressed = false;
+    mouseDelta = glm::vec2(0.0f);
+  }
+};
+
 class Input {
 public:
   static Input &getInstance() {
@@ -34,6 +86,10 @@ public:
   void update();
   void clearMouseDelta();
 
+  // Snapshot this frame's input, then advance to the next frame (clears the
+  // mouse delta and the just-pressed state). Main thread only.
+  InputFrame sample();
+
   bool isKeyPressed(int key) const;
   bool isKeyJustPressed(int key) const;
   bool isMouseButtonPressed(int button) const;
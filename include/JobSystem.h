@@ -0,0 +1,113 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing job scheduler. A fixed pool of workers (one per core, minus
+// the calling thread) each own a deque: the owner pops from the back, idle
+// threads steal from the front of other deques. The thread that issues a
+// parallelFor helps run jobs until its range is finished, so nested
+// parallelFor calls from inside a job are fine.
+class JobSystem {
+public:
+  static JobSystem &getInstance() {
+    static JobSystem instance;
+    return instance;
+  }
+
+  // Calls fn(begin, end) over [0, count). Ranges at or below grainSize (or a
+  // machine with a single core) run inline on the calling thread.
+  template <typename Fn>
+  void parallelFor(size_t count, size_t grainSize, const Fn &fn) {
+    if (count == 0)
+      return;
+    if (workers.empty() || count <= grainSize) {
+      fn(size_t(0), count);
+      return;
+    }
+
+    size_t chunks = (count + grainSize - 1) / grainSize;
+    size_t maxChunks = getThreadCount() * 4; // Some slack for stealing
+    if (chunks > maxChunks)
+      chunks = maxChunks;
+    size_t chunkSize = (count + chunks - 1) / chunks;
+
+    std::atomic<size_t> pending(0);
+    unsigned self = getThreadIndex();
+    unsigned queue = self;
+    for (size_t begin = 0; begin < count; begin += chunkSize) {
+      Job job;
+      job.invoke = &invokeRange<Fn>;
+      job.fn = &fn;
+      job.begin = begin;
+      job.end = begin + chunkSize < count ? begin + chunkSize : count;
+      job.pending = &pending;
+      pending.fetch_add(1, std::memory_order_relaxed);
+      push(queue, job);
+      queue = (queue + 1) % getThreadCount();
+    }
+    wakeWorkers();
+
+    // Help out until every chunk of this range has finished
+    while (pending.load(std::memory_order_acquire) > 0) {
+      if (!runOne(self))
+        std::this_thread::yield();
+    }
+  }
+
+  // Workers plus the main thread
+  unsigned getThreadCount() const { return (unsigned)queues.size(); }
+
+  // 0 for the main thread, 1..N for workers
+  static unsigned getThreadIndex();
+
+  void shutdown();
+
+private:
+  struct Job {
+    void (*invoke)(const void *fn, size_t begin, size_t end);
+    const void *fn;
+    size_t begin;
+    size_t end;
+    std::atomic<size_t> *pending;
+  };
+
+  struct WorkQueue {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+  };
+
+  template <typename Fn>
+  static void invokeRange(const void *fn, size_t begin, size_t end) {
+    (*static_cast<const Fn *>(fn))(begin, end);
+  }
+
+  JobSystem();
+  ~JobSystem();
+  JobSystem(const JobSystem &) = delete;
+  JobSystem &operator=(const JobSystem &) = delete;
+
+  void push(unsigned queue, const Job &job);
+  bool pop(unsigned queue, Job &job);
+  bool steal(unsigned thief, Job &job);
+  bool runOne(unsigned self);
+  void wakeWorkers();
+  void workerLoop(unsigned index);
+
+  std::vector<std::unique_ptr<WorkQueue>> queues; // [0] belongs to main
+  std::vector<std::thread> workers;
+
+  std::mutex sleepMutex;
+  std::condition_variable wakeCondition;
+  std::atomic<int> queuedJobs;
+  std::atomic<bool> stopping;
+};
+
+#endif
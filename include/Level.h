@@ -1,11 +1,15 @@
 #ifndef LEVEL_H
 #define LEVEL_H
 
+#include "EntityStore.h"
 #include "GameObject.h"
+#include "LevelArena.h"
+#include "LevelData.h"
 #include "Model.h"
 #include "ParticleSystem.h"
 #include "Player.h"
 #include <memory>
+#include <string>
 #include <vector>
 
 struct Light {
@@ -26,10 +30,23 @@ struct Light {
 
 class Level {
 public:
-  std::vector<std::unique_ptr<GameObject>> objects;
-  std::vector<std::unique_ptr<GameObject>> walls;
-  std::vector<std::unique_ptr<GameObject>> lightFixtures;  // For fallback/extra parts
+  // Owns the memory of every object below; declared first so it is
+  // released after they are destroyed
+  LevelArena arena;
+
+  std::vector<ArenaPtr<GameObject>> objects;
+  std::vector<ArenaPtr<GameObject>> walls;
+  std::vector<ArenaPtr<GameObject>> lightFixtures;  // For fallback/extra parts
   std::vector<Light> lights;
+
+  // Animated hazards (pendulums, stalactites, geysers) in dense storage
+  EntityStore entities;
+
+  // Typed views into `objects`, maintained by addObject()
+  std::vector<Collectible *> collectibles;
+  std::vector<CrumblingTile *> crumblingTiles;
+  std::vector<HealthPickup *> healthPickups;
+  std::vector<GameObject *> triggers; // Other objects flagged isTrigger
   
   // Light fixture model (shared across all fixtures)
   std::unique_ptr<Model> lightFixtureModel;
@@ -49,15 +66,51 @@ public:
   virtual void init() = 0;
   virtual void update(float deltaTime, Player *player,
                       ParticleSystem *particles);
-  virtual void draw(class Shader *shader);
-  virtual void drawLights(class Shader *shader);
-  void drawLightFixtureModels(class Shader *shader);  // Draw the orb models
+  // Append this tick's drawables and lights to a render snapshot
+  virtual void draw(struct RenderSnapshot &snapshot) const;
+  virtual void drawLights(struct RenderSnapshot &snapshot) const;
+  void drawLightFixtureModels(struct RenderSnapshot &snapshot) const;  // Draw the orb models
+
+  // The camera frustum for this tick; hazards outside it and far from the
+  // player sleep (see EntityStore::updateActivity)
+  void setActivityView(const Frustum &view) { activityView = view; }
+
+  // Restart support: record the state init() produced, and later put the
+  // level back to it in place, keeping every mesh, model and texture
+  void captureInitialState();
+  void restoreInitialState();
+
+  // Print how much memory the level's objects take
+  void printMemoryReport(const char *name) const;
+
+  // Seconds spent in each part of the last update(), recorded only while
+  // profiling is on (see StressBenchmark)
+  struct UpdateProfile {
+    double objects;    // Object updates
+    double hazards;    // Activity culling and EntityStore::update
+    double effects;    // Deferred sounds and particles, light flicker
+    double collisions; // checkCollisions and checkTriggers
+  };
+  void setProfiling(bool enabled) { profiling = enabled; }
+  const UpdateProfile &getLastProfile() const { return lastProfile; }
 
   void checkCollisions(Player *player, ParticleSystem *particles);
   void checkCameraCollision(glm::vec3 &cameraPos, const glm::vec3 &targetPos);
   void checkTriggers(Player *player);
 
 protected:
+  // Mutable level state. Subclasses with their own progress (counters,
+  // cutscenes) append it after calling the base version.
+  virtual void saveState(StateBuffer &state) const;
+  virtual void restoreState(StateBuffer &state);
+
+  // Adds to `objects` and registers the object in the typed views
+  GameObject *addObject(ArenaPtr<GameObject> obj);
+
+  // Places everything in a layout file (basePath + ".lvl", or the ".txt"
+  // source; see LevelData.h). Returns false if the layout can't be loaded.
+  bool loadLayout(const std::string &basePath);
+
   void loadLightFixtureModel();  // Load the fractured orb model
   void createWall(const glm::vec3 &position, const glm::vec3 &scale,
                   const glm::vec3 &color, int materialType = 0);
@@ -65,6 +118,23 @@ protected:
                    const glm::vec3 &color);
   void createLightFixture(const glm::vec3 &position, const glm::vec3 &lightColor,
                           float scale = 1.0f);
+
+  Frustum activityView;
+  StateBuffer initialState;
+  bool profiling;
+  UpdateProfile lastProfile;
+
+  // Wall broadphase, rebuilt when the wall list changes. Walls are static,
+  // so their boxes are also packed once for the batched resting-contact test.
+  UniformGrid wallGrid;
+  AABBArray wallBoxes;
+  std::vector<uint32_t> wallCandidates; // Query scratch, reused every tick
+  std::vector<uint32_t> wallHits;       // Hit mask scratch (bit per wall)
+  void rebuildWallGrid();
+
+  // Moves the player from previousPosition to its current position through
+  // the walls, sliding along the first walls it touches
+  void sweepPlayer(Player *player, ParticleSystem *particles);
 };
 
 #endif
@@ -10,12 +10,13 @@ public:
   void update(float deltaTime, Player *player,
               ParticleSystem *particles) override;
 
+protected:
+  void saveState(StateBuffer &state) const override;
+  void restoreState(StateBuffer &state) override;
+
 private:
   void createChamber();
-  void createMazeWalls();
-  void createPendulums();
   void createCrumblingTiles();
-  void createCollectible();
   void createForceFieldDoor();
   void createCheckeredFloor();
 
@@ -10,14 +10,15 @@ public:
   void update(float deltaTime, Player *player,
               ParticleSystem *particles) override;
 
+protected:
+  void saveState(StateBuffer &state) const override;
+  void restoreState(StateBuffer &state) override;
+
 private:
   void createCavern();
-  void createStalactites();
-  void createGeysers();
   void createSkeletons();
   void createCollectible();
   void createPedestal();
-  void createScatteredRocks();
   void setupLighting();
 
   GameObject *pedestal;
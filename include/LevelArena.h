@@ -0,0 +1,91 @@
+#ifndef LEVEL_ARENA_H
+#define LEVEL_ARENA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Runs the destructor of an arena-allocated object but leaves its memory to
+// the arena. Not templated, so an ArenaPtr<Derived> converts to an
+// ArenaPtr<Base> just like std::unique_ptr does.
+struct ArenaDeleter {
+  template <typename T> void operator()(T *object) const {
+    if (object)
+      object->~T();
+  }
+};
+
+template <typename T> using ArenaPtr = std::unique_ptr<T, ArenaDeleter>;
+
+// Monotonic allocator tied to a level's lifetime. Objects are bump-allocated
+// out of large blocks in creation order, so objects built together sit
+// together in memory, and all of it goes back in one release when the arena
+// is destroyed. Memory is never reused before then. Every ArenaPtr must be
+// destroyed before its arena.
+class LevelArena {
+public:
+  explicit LevelArena(size_t blockSize = 64 * 1024)
+      : blockSize(blockSize), offset(0), blockCapacity(0), bytesUsed(0),
+        bytesReserved(0), objectCount(0) {}
+  LevelArena(const LevelArena &) = delete;
+  LevelArena &operator=(const LevelArena &) = delete;
+
+  void *allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+    if (!blocks.empty()) {
+      uintptr_t base = reinterpret_cast<uintptr_t>(blocks.back().get());
+      uintptr_t aligned = (base + offset + alignment - 1) & ~(alignment - 1);
+      size_t newOffset = (aligned - base) + size;
+      if (newOffset <= blockCapacity) {
+        bytesUsed += newOffset - offset;
+        offset = newOffset;
+        return reinterpret_cast<void *>(aligned);
+      }
+    }
+
+    // Start a new block (oversized requests get a block of their own)
+    blockCapacity = std::max(blockSize, size + alignment);
+    blocks.emplace_back(new unsigned char[blockCapacity]);
+    bytesReserved += blockCapacity;
+    offset = 0;
+    return allocate(size, alignment);
+  }
+
+  // Make the next `size` bytes come from one block, so a batch of objects
+  // created together (a level layout) is carved out of a single allocation
+  void reserve(size_t size) {
+    if (!blocks.empty() && blockCapacity - offset >= size)
+      return;
+    blockCapacity = std::max(blockSize, size);
+    blocks.emplace_back(new unsigned char[blockCapacity]);
+    bytesReserved += blockCapacity;
+    offset = 0;
+  }
+
+  template <typename T, typename... Args> ArenaPtr<T> make(Args &&...args) {
+    void *memory = allocate(sizeof(T), alignof(T));
+    T *object = new (memory) T(std::forward<Args>(args)...);
+    objectCount++;
+    return ArenaPtr<T>(object);
+  }
+
+  // Usage report
+  size_t getBytesUsed() const { return bytesUsed; } // Including padding
+  size_t getBytesReserved() const { return bytesReserved; }
+  size_t getBlockCount() const { return blocks.size(); }
+  size_t getObjectCount() const { return objectCount; }
+
+private:
+  size_t blockSize;
+  std::vector<std::unique_ptr<unsigned char[]>> blocks;
+  size_t offset;        // Into the newest block
+  size_t blockCapacity; // Size of the newest block
+  size_t bytesUsed;
+  size_t bytesReserved;
+  size_t objectCount;
+};
+
+#endif
@@ -0,0 +1,170 @@
+#ifndef LEVEL_DATA_H
+#define LEVEL_DATA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Level layout files.
+//
+// Layouts are written as text (levels/*.txt) and compiled by levelc into a
+// binary image (levels/*.lvl) that is mapped straight into memory at load
+// time. The text has one placement per line, '#' starts a comment:
+//
+//   wall       x y z  sx sy sz  r g b  [material]
+//   pendulum   px py pz  length swingSpeed phase  sx sy sz
+//   stalactite x y z  sx sy sz
+//   geyser     x y z
+//   light      x y z  r g b  intensity  [fixtureScale]
+//   prop       model  x y z  scale yawDegrees  r g b  material
+//              [solid sx sy sz]
+//   coin       model  x y z  r g b  scale rotationSpeed  pickup|coin|gem
+//
+// The binary is a header, a section table and one packed array of fixed-size
+// records per section; records only hold floats and 32-bit integers, so the
+// mapped file is used in place without parsing. Model paths live in a string table and records refer
+// to them by byte offset.
+//
+// The record layouts below ARE the file format: change one and bump
+// kLevelFormatVersion, and the loader will reject stale .lvl files (the game
+// then falls back to compiling the text source).
+
+const uint32_t kLevelFormatVersion = 1;
+
+enum class LevelSectionType : uint32_t {
+  STRINGS = 0, // Null-terminated model paths
+  WALLS,
+  PENDULUMS,
+  STALACTITES,
+  GEYSERS,
+  LIGHTS,
+  PROPS,
+  COINS,
+  COUNT
+};
+
+struct LevelFileHeader {
+  char magic[4]; // "CGLV"
+  uint32_t version;
+  uint32_t sectionCount;
+  uint32_t fileSize;
+};
+
+struct LevelSection {
+  uint32_t type;   // LevelSectionType
+  uint32_t count;  // Records (bytes for STRINGS)
+  uint32_t offset; // From the start of the file, 4-byte aligned
+  uint32_t stride; // sizeof the record type when written
+};
+
+// Cube wall, same as Level::createWall
+struct WallRecord {
+  float position[3];
+  float size[3];
+  float color[3];
+  int32_t materialType;
+};
+
+struct PendulumRecord {
+  float pivot[3];
+  float length;
+  float swingSpeed;
+  float phase; // Radians
+  float size[3];
+};
+
+struct StalactiteRecord {
+  float position[3];
+  float size[3];
+};
+
+struct GeyserRecord {
+  float position[3];
+};
+
+struct LightRecord {
+  float position[3];
+  float color[3];
+  float intensity;
+  float fixtureScale; // 0 = no hanging fixture
+};
+
+enum LevelPropFlags : uint32_t {
+  PROP_SOLID = 1 << 0, // Goes in the wall list with the collision box below
+};
+
+// Static model placement (rocks, debris)
+struct PropRecord {
+  uint32_t model; // String table offset
+  float position[3];
+  float scale;
+  float yaw; // Radians
+  float color[3];
+  int32_t materialType;
+  uint32_t flags;         // LevelPropFlags
+  float collisionSize[3]; // Box size for PROP_SOLID props
+};
+
+enum class LevelSound : uint32_t { PICKUP = 0, COIN, GEM };
+
+// Spinning model collectible
+struct CoinRecord {
+  uint32_t model; // String table offset
+  float position[3];
+  float color[3];
+  float scale;
+  float rotationSpeed;
+  uint32_t sound; // LevelSound
+};
+
+// Read-only view of a level layout. Record pointers stay valid for the
+// lifetime of the LevelData.
+class LevelData {
+public:
+  LevelData();
+  ~LevelData();
+  LevelData(const LevelData &) = delete;
+  LevelData &operator=(const LevelData &) = delete;
+
+  // Loads basePath + ".lvl", or compiles basePath + ".txt" if the binary is
+  // missing or out of date
+  bool load(const std::string &basePath);
+  bool loadBinary(const std::string &path);
+  bool loadText(const std::string &path);
+
+  // Text source to binary image. On failure `error` names the line.
+  static bool compile(const std::string &source,
+                      std::vector<unsigned char> &binary, std::string &error);
+
+  const char *getString(uint32_t offset) const;
+  size_t getByteSize() const { return size; }
+
+  const WallRecord *walls;
+  uint32_t wallCount;
+  const PendulumRecord *pendulums;
+  uint32_t pendulumCount;
+  const StalactiteRecord *stalactites;
+  uint32_t stalactiteCount;
+  const GeyserRecord *geysers;
+  uint32_t geyserCount;
+  const LightRecord *lights;
+  uint32_t lightCount;
+  const PropRecord *props;
+  uint32_t propCount;
+  const CoinRecord *coins;
+  uint32_t coinCount;
+
+private:
+  void release();
+  bool bind(const unsigned char *bytes, size_t byteCount,
+            const std::string &name);
+
+  void *mapping; // mmap'd file, if any
+  size_t size;
+  std::vector<unsigned char> owned; // Compiled or read image otherwise
+  const char *strings;
+  uint32_t stringBytes;
+};
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <GL/glew.h>
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <vector>
 
 struct Vertex {
@@ -11,11 +12,32 @@ struct Vertex {
     glm::vec2 texCoord;
 };
 
+// Compact GPU vertex (16 bytes instead of 32). Positions are snorm16
+// quantized to the mesh bounds, normals are octahedral snorm16 and UVs are
+// half floats. vertex.glsl does the decoding.
+struct PackedVertex {
+    int16_t position[4];  // xyz + padding to keep 4-byte alignment
+    int16_t normal[2];    // Octahedral encoded unit normal
+    uint16_t texCoord[2]; // IEEE half floats
+};
+
+// Vertices and triangle list of a shape, before upload
+struct MeshData {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+};
+
 class Mesh {
 public:
     std::vector<Vertex> vertices;
     std::vector<unsigned int> indices;
     GLuint VAO, VBO, EBO;
+    GLenum indexType;   // GL_UNSIGNED_SHORT when every index fits in 16 bits
+    GLsizei indexCount;
+
+    // Dequantization for the snorm16 positions: pos = offset + scale * snorm
+    glm::vec3 positionScale;
+    glm::vec3 positionOffset;
 
     Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
     ~Mesh();
@@ -30,6 +52,18 @@ public:
     static Mesh* createCone(float radius = 1.0f, float height = 2.0f, int sectors = 36);
     static Mesh* createHeart(float size = 1.0f); // Heart shape for UI
 
+    // CPU-only generation behind the helpers above (MeshGeometry.cpp); no
+    // GL context needed
+    static MeshData generateCube(float size = 1.0f);
+    static MeshData generateSphere(float radius = 1.0f, int sectors = 36, int stacks = 18);
+    static MeshData generatePlane(float width = 1.0f, float height = 1.0f);
+    static MeshData generateCylinder(float radius = 1.0f, float height = 2.0f, int sectors = 36);
+    static MeshData generateCone(float radius = 1.0f, float height = 2.0f, int sectors = 36);
+    static MeshData generateHeart(float size = 1.0f);
+
+    static PackedVertex packVertex(const Vertex& v, const glm::vec3& offset,
+                                   const glm::vec3& invScale);
+
 private:
     void setupMesh();
 };
@@ -0,0 +1,51 @@
+#ifndef MESH_OPTIMIZER_H
+#define MESH_OPTIMIZER_H
+
+#include "Mesh.h"
+#include <vector>
+
+// Post-load index/vertex reordering for imported meshes:
+//  1. Tipsify vertex cache optimization (Sander et al. 2007)
+//  2. Cluster ordering for overdraw (outward-facing clusters first)
+//  3. Vertex fetch reordering (vertices in first-use order)
+namespace MeshOptimizer {
+
+struct Stats {
+  float acmrBefore; // Average cache miss ratio (transforms per triangle)
+  float acmrAfter;
+  size_t triangleCount;
+  size_t vertexCountBefore;
+  size_t vertexCountAfter;
+};
+
+// Simulated post-transform cache size used for both optimization and ACMR
+constexpr int kCacheSize = 16;
+
+// FIFO cache simulation - lower is better, 0.5 is the practical optimum
+float computeACMR(const std::vector<unsigned int> &indices, size_t vertexCount,
+                  int cacheSize = kCacheSize);
+
+// Reorders triangles for post-transform cache locality. Returns the first
+// triangle of every hard cluster boundary in the new order.
+std::vector<size_t> optimizeVertexCache(std::vector<unsigned int> &indices,
+                                        size_t vertexCount,
+                                        int cacheSize = kCacheSize);
+
+// Sorts the clusters produced by optimizeVertexCache so triangles facing
+// away from the mesh center are drawn first
+void optimizeOverdraw(std::vector<unsigned int> &indices,
+                      const std::vector<Vertex> &vertices,
+                      const std::vector<size_t> &clusterStarts,
+                      size_t minClusterTriangles = 64);
+
+// Rewrites vertices in first-use order and drops unreferenced ones
+void optimizeVertexFetch(std::vector<Vertex> &vertices,
+                         std::vector<unsigned int> &indices);
+
+// Runs all three passes in order
+Stats optimize(std::vector<Vertex> &vertices,
+               std::vector<unsigned int> &indices);
+
+} // namespace MeshOptimizer
+
+#endif
@@ -23,19 +23,31 @@ public:
 
     void emit(const glm::vec3& position, const glm::vec3& velocity, const glm::vec4& color, 
               float size, float lifetime, int count = 1);
+    // Same particle parameters emitted from several origins in one call
+    void emitBatch(const glm::vec3* origins, int originCount, const glm::vec3& velocity,
+                   const glm::vec4& color, float size, float lifetime, int countPerOrigin);
     void update(float deltaTime);
-    void draw(const glm::mat4& view, const glm::mat4& projection);
+    // Uploads and draws particles copied out of a render snapshot, so the
+    // simulation can keep updating the pool while the GPU side runs
+    void draw(const Particle* data, int count);
 
     void clear();
     void emitExplosion(const glm::vec3& position, const glm::vec3& color, int count);
 
+    int getParticleCount() const { return particleCount; }
+    const Particle* getParticles() const { return particles.data(); }
+
 private:
+    // Fixed pool allocated once - live particles are packed in [0, particleCount)
     std::vector<Particle> particles;
+    int particleCount;
     int maxParticles;
+    // Created by the first draw(), so a pool that is only simulated
+    // (benchmarks, tools) needs no GL context
     GLuint VAO, VBO;
 
     void setupBuffers();
-    void updateBuffers();
+    void updateBuffers(const Particle* data, int count);
 };
 
 #endif
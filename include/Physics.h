@@ -2,6 +2,8 @@
 #define PHYSICS_H
 
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cstdint>
 #include <vector>
 
 struct AABB {
@@ -16,6 +18,56 @@ struct AABB {
     glm::vec3 getSize() const { return max - min; }
 };
 
+// Six planes (a, b, c, d with a*x + b*y + c*z + d >= 0 inside) extracted from
+// a view-projection matrix. A default-constructed frustum contains everything.
+struct Frustum {
+    glm::vec4 planes[6];
+
+    Frustum();
+    static Frustum fromMatrix(const glm::mat4& viewProjection);
+
+    bool intersects(const AABB& box) const; // Conservative near the corners
+};
+
+// Boxes in structure-of-arrays form for batched tests (see OBBArray)
+struct AABBArray {
+    std::vector<float> min[3]; // x, y, z
+    std::vector<float> max[3];
+
+    size_t size() const { return min[0].size(); }
+    void resize(size_t count);
+    void clear() { resize(0); }
+    void set(size_t index, const AABB& box);
+};
+
+// Oriented bounding box: a center, three orthonormal axes and the half size
+// along each axis
+struct OBB {
+    glm::vec3 center;
+    glm::vec3 axes[3];
+    glm::vec3 halfExtents;
+
+    OBB();
+    OBB(const glm::vec3& center, const glm::quat& rotation, const glm::vec3& halfExtents);
+
+    glm::vec3 closestPoint(const glm::vec3& point) const;
+    AABB getBounds() const; // Smallest AABB that contains the box
+    bool intersects(const OBB& other) const; // Separating axis test
+};
+
+// Boxes in structure-of-arrays form for batched tests: one float array per
+// component, so a SIMD register loads the same component of four boxes
+struct OBBArray {
+    std::vector<float> center[3];  // x, y, z
+    std::vector<float> axis[3][3]; // axis[k][c] = component c of axis k
+    std::vector<float> halfExtent[3];
+
+    size_t size() const { return center[0].size(); }
+    void resize(size_t count);
+    void clear() { resize(0); }
+    void set(size_t index, const OBB& box);
+};
+
 struct Sphere {
     glm::vec3 center;
     float radius;
@@ -25,6 +77,7 @@ struct Sphere {
 
     bool intersects(const Sphere& other) const;
     bool intersects(const AABB& box) const;
+    bool intersects(const OBB& box) const;
 };
 
 class Physics {
@@ -32,15 +85,65 @@ public:
     static bool checkAABBCollision(const AABB& a, const AABB& b);
     static bool checkSphereCollision(const Sphere& a, const Sphere& b);
     static bool checkSphereAABBCollision(const Sphere& sphere, const AABB& box);
+    static bool checkSphereOBBCollision(const Sphere& sphere, const OBB& box);
+    static bool checkOBBCollision(const OBB& a, const OBB& b);
+
+    // One sphere against every box, four boxes per step on SSE. Sets bit i
+    // of hitMask (word i / 32) when box i overlaps and returns the hit count.
+    static size_t sphereOBBBatch(const Sphere& sphere, const OBBArray& boxes,
+                                 std::vector<uint32_t>& hitMask);
+    // Same for axis-aligned boxes, eight per step on AVX and four on SSE
+    static size_t sphereAABBBatch(const Sphere& sphere, const AABBArray& boxes,
+                                  std::vector<uint32_t>& hitMask);
     
     static glm::vec3 resolveAABBCollision(const AABB& moving, const AABB& stationary, const glm::vec3& velocity);
     static glm::vec3 resolveSphereCollision(const Sphere& a, const Sphere& b);
     
     static AABB createAABBFromTransform(const glm::vec3& position, const glm::vec3& size);
     static Sphere createSphereFromTransform(const glm::vec3& position, float radius);
+    static OBB createOBBFromTransform(const glm::vec3& position, const glm::quat& rotation,
+                                      const glm::vec3& size);
     
     // Raycasting
     static bool rayIntersectAABB(const glm::vec3& rayOrigin, const glm::vec3& rayDir, const AABB& box, float& t);
+
+    // Continuous collision: moves the sphere by `displacement` and reports the
+    // first contact as a fraction t of the displacement, with the normal
+    // pointing out of the box. A sphere that already overlaps the box only
+    // hits it when moving further in (t = 0).
+    static bool sweepSphereAABB(const Sphere& sphere, const glm::vec3& displacement,
+                                const AABB& box, float& t, glm::vec3& normal);
+    static bool sweepSphereOBB(const Sphere& sphere, const glm::vec3& displacement,
+                               const OBB& box, float& t, glm::vec3& normal);
+};
+
+// Broadphase for static boxes: a uniform grid where each cell lists the boxes
+// overlapping it. Queries return candidates only, callers still run the exact
+// test.
+class UniformGrid {
+public:
+    UniformGrid();
+
+    void build(const std::vector<AABB>& boxes, float cellSize);
+    void clear();
+
+    // Indices of boxes sharing a cell with `region`, sorted and unique.
+    // `results` is cleared first and keeps its capacity between calls.
+    void query(const AABB& region, std::vector<uint32_t>& results) const;
+
+    size_t getBoxCount() const { return boxCount; }
+
+private:
+    glm::vec3 origin;
+    float cellSize;
+    int dims[3];
+    size_t boxCount;
+
+    // Cell c owns cellItems[cellStart[c] .. cellStart[c + 1])
+    std::vector<uint32_t> cellStart;
+    std::vector<uint32_t> cellItems;
+
+    void cellRange(const AABB& box, int lo[3], int hi[3]) const;
 };
 
 #endif
@@ -9,6 +9,8 @@
 #include <memory>
 #include <vector>
 
+struct RenderSnapshot;
+
 class Player {
 public:
   Transform transform;
@@ -20,6 +22,7 @@ public:
   float bobAmount;
 
   glm::vec3 velocity;
+  glm::vec3 previousPosition; // Last position resolved against the walls
   bool isFlashing;
   float flashTimer;
 
@@ -46,8 +49,8 @@ public:
   Player();
   ~Player();
 
-  void update(float deltaTime, const glm::vec3 &moveInput);
-  void draw(class Shader *shader);
+  void update(float deltaTime, const glm::vec3 &moveInput, bool jumpPressed);
+  void draw(RenderSnapshot &snapshot) const; // Append to the render snapshot
 
   void onWallCollision(const glm::vec3 &normal, ParticleSystem *particles);
   void onObstacleHit(const glm::vec3 &knockbackDir, ParticleSystem *particles);
@@ -57,6 +60,7 @@ public:
   void setCameraYaw(float yaw) { cameraYaw = yaw; }
   void reset(const glm::vec3 &startPos) {
     transform.position = startPos;
+    previousPosition = startPos;
     velocity = glm::vec3(0.0f);
     isFlashing = false;
     flashTimer = 0.0f;
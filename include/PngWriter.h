@@ -0,0 +1,16 @@
+#ifndef PNG_WRITER_H
+#define PNG_WRITER_H
+
+#include <string>
+
+// Writes 8-bit RGBA pixels as a PNG file. The image data is stored without
+// compression (deflate "stored" blocks), which keeps the writer tiny and
+// dependency-free; files are large but lossless and byte-for-byte
+// reproducible, which is what frame captures and golden images need.
+//
+// `pixels` holds `height` rows of `width` RGBA texels. GL reads framebuffers
+// bottom row first, so pass flipVertically to get an upright image.
+bool writePng(const std::string &path, int width, int height,
+              const unsigned char *pixels, bool flipVertically);
+
+#endif
@@ -0,0 +1,178 @@
+#ifndef RENDER_SNAPSHOT_H
+#define RENDER_SNAPSHOT_H
+
+#include "Camera.h"
+#include "ParticleSystem.h"
+#include "Transform.h"
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+class Mesh;
+class Model;
+class Texture;
+
+enum class GameState { START_SCREEN, MENU, LEVEL1, LEVEL2, WIN, GAME_OVER };
+
+// One drawable produced by the simulation. The final model matrix is
+// transform.getModelMatrix() * post, where `post` carries fixed offsets
+// (model re-centering, attached parts) that are not interpolated.
+struct RenderInstance {
+  uint64_t key; // Stable id of the source, pairs instances across ticks
+  const Mesh *mesh;
+  const Model *model;
+  Texture *texture;
+  Transform transform;
+  glm::mat4 post;
+
+  glm::vec3 color;
+  float transparency;
+  float emissive;
+  float shininess;
+  int materialType;
+  bool doubleSided; // Imported models are drawn with culling disabled
+};
+
+struct LightState {
+  glm::vec3 position;
+  glm::vec3 color;
+  float intensity;
+};
+
+// Immutable (once published) copy of everything the renderer needs for one
+// simulation tick. The simulation never hands out pointers into live game
+// state except to GPU resources (meshes, models, textures), which only
+// change while the simulation is parked for a level load.
+struct RenderSnapshot {
+  uint64_t tick;
+  double publishTime;  // glfwGetTime() when the tick was taken
+  float tickFraction; // Unsimulated time left at publishTime, in ticks
+
+  GameState state;
+  float screenTime; // Timer driving the start/game over/win screen shaders
+
+  // Camera
+  glm::vec3 cameraPosition;
+  glm::vec3 cameraFront;
+  glm::vec3 cameraUp;
+  float cameraFov;
+  CameraMode cameraMode;
+
+  // Lighting
+  glm::vec3 ambientLight;
+  std::vector<LightState> lights;
+
+  std::vector<RenderInstance> instances;
+  std::vector<Particle> particles;
+
+  // UI
+  int hearts;
+  int maxHearts;
+  float damageFlash;
+
+  RenderSnapshot()
+      : tick(0), publishTime(0.0), tickFraction(0.0f), state(GameState::START_SCREEN),
+        screenTime(0.0f), cameraPosition(0.0f), cameraFront(0.0f, 0.0f, -1.0f),
+        cameraUp(0.0f, 1.0f, 0.0f), cameraFov(45.0f), cameraMode(THIRD_PERSON),
+        ambientLight(0.2f), hearts(0), maxHearts(0), damageFlash(0.0f) {}
+
+  // Reset for reuse without giving back vector capacity
+  void clear() {
+    lights.clear();
+    instances.clear();
+    particles.clear();
+    hearts = maxHearts = 0;
+    damageFlash = 0.0f;
+  }
+
+  // Append an instance with default material settings
+  RenderInstance &addInstance(const void *source, const Transform &transform,
+                              const glm::vec3 &color, unsigned part = 0) {
+    RenderInstance instance;
+    instance.key = (uint64_t)(uintptr_t)source + part;
+    instance.mesh = nullptr;
+    instance.model = nullptr;
+    instance.texture = nullptr;
+    instance.transform = transform;
+    instance.post = glm::mat4(1.0f);
+    instance.color = color;
+    instance.transparency = 1.0f;
+    instance.emissive = 0.0f;
+    instance.shininess = 32.0f;
+    instance.materialType = 0;
+    instance.doubleSided = false;
+    instances.push_back(instance);
+    return instances.back();
+  }
+};
+
+// Hands snapshots from the simulation thread to the render thread. The
+// renderer holds the two newest ticks it has seen (for interpolation), the
+// simulation writes into a free slot, and the last two finished ticks wait
+// in `ready` / `readyPrevious` until the renderer picks them up. Keeping the
+// tick before `ready` means the renderer always interpolates between two
+// consecutive ticks, even when several ticks ran between two frames, and
+// neither side ever waits on the other.
+class SnapshotQueue {
+public:
+  SnapshotQueue()
+      : writing(-1), ready(-1), readyPrevious(-1), current(-1), previous(-1) {}
+
+  // Simulation side
+  RenderSnapshot &beginWrite() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int i = 0; i < kSlotCount; i++) {
+      if (i != ready && i != readyPrevious && i != current && i != previous) {
+        writing = i;
+        break;
+      }
+    }
+    slots[writing].clear();
+    return slots[writing];
+  }
+
+  void publish() {
+    std::lock_guard<std::mutex> lock(mutex);
+    readyPrevious = ready; // -1 if the renderer already took it
+    ready = writing;
+    writing = -1;
+  }
+
+  // Render side - returns true when a new tick became current
+  bool acquire() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (ready < 0)
+      return false;
+    previous = readyPrevious >= 0 ? readyPrevious : current;
+    current = ready;
+    ready = readyPrevious = -1;
+    return true;
+  }
+
+  const RenderSnapshot *getCurrent() const {
+    return current >= 0 ? &slots[current] : nullptr;
+  }
+  const RenderSnapshot *getPrevious() const {
+    return previous >= 0 ? &slots[previous] : nullptr;
+  }
+
+  // Drop every snapshot (they may reference meshes of an unloaded level).
+  // Only call while the simulation is parked.
+  void reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    writing = ready = readyPrevious = current = previous = -1;
+  }
+
+private:
+  static const int kSlotCount = 5;
+
+  RenderSnapshot slots[kSlotCount];
+  int writing;
+  int ready;
+  int readyPrevious;
+  int current;
+  int previous;
+  std::mutex mutex;
+};
+
+#endif
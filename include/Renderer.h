@@ -1,7 +1,151 @@
 #ifndef RENDERER_H
 #define RENDERER_H
 
-// Placeholder for future renderer abstraction
-// Currently rendering is handled directly in Game class
+#include "Camera.h"
+#include "Mesh.h"
+#include "Model.h"
+#include "RenderSnapshot.h"
+#include "Shader.h"
+#include "ShaderWatcher.h"
+#include <GL/glew.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class ParticleSystem;
+
+// What one render() call submitted
+struct RenderStats {
+  uint32_t drawCalls;
+  uint64_t triangles;
+  // Program and texture binds plus enable/disable toggles (vertex array
+  // binds are one per draw call, so they are not counted again)
+  uint32_t stateChanges;
+
+  RenderStats() : drawCalls(0), triangles(0), stateChanges(0) {}
+};
+
+// Draws render snapshots. Owns every shader and UI mesh, and is the only
+// code that issues GL calls during a frame, so it always runs on the thread
+// that owns the GL context.
+class Renderer {
+public:
+  Renderer();
+  ~Renderer();
+
+  // Where init() loads the shaders from (default "shaders", the copy next
+  // to the executable)
+  void setShaderDirectory(const std::string &directory) {
+    shaderDirectory = directory;
+  }
+  bool init();
+  void cleanup();
+
+  // Draw `current`, blended from `previous` by alpha (0 = previous tick,
+  // 1 = current tick). `previous` may be null.
+  void render(const RenderSnapshot *previous, const RenderSnapshot &current,
+              float alpha, int width, int height, ParticleSystem *particles);
+
+  const RenderStats &getLastStats() const { return stats; }
+  uint64_t getFrameNumber() const { return frameNumber; } // Next render()
+
+  // Clock for shader animation. Scripted runs pass their own time so the
+  // same frame always renders the same image; negative means glfwGetTime().
+  void setSceneTime(double seconds) { sceneTime = seconds; }
+
+  // GPU time per frame from GL timer queries. Results arrive a few frames
+  // after the frame was submitted; collectGpuTimes appends the ones that are
+  // ready as (frame number, seconds), and with `wait` set blocks until every
+  // timed frame has reported. Frames are numbered by render() call.
+  void setGpuTiming(bool enabled);
+  void collectGpuTimes(std::vector<std::pair<uint64_t, double>> &times,
+                       bool wait);
+
+  // The start, game over and win screens are drawn at `scale` times the
+  // framebuffer resolution and stretched to fit (1 draws them directly)
+  void setScreenScale(float scale);
+
+  // Rebuild shaders whose files change on disk (--hot-reload). Call
+  // updateShaders() once per frame; it never waits on a compile.
+  void setShaderHotReload(bool enabled);
+  void updateShaders();
+
+private:
+  std::string shaderDirectory;
+  std::unique_ptr<Shader> mainShader; // Every material, chosen by uniform
+  std::unique_ptr<ShaderPermutations> materialShaders; // One per material
+  std::unique_ptr<Shader> particleShader;
+  std::unique_ptr<Shader> startScreenShader;
+  std::unique_ptr<Shader> gameOverShader;
+  std::unique_ptr<Shader> winScreenShader;
+  static const int kShaderCount = 5;
+  Shader *shaders[kShaderCount]; // All of the above
+
+  std::unique_ptr<ShaderWatcher> shaderWatcher;
+  std::vector<std::string> changedShaderFiles;
+
+  // Start screen / Game over / Win screen (share VAO/VBO)
+  GLuint screenQuadVAO;
+  GLuint screenQuadVBO;
+
+  // Reduced-resolution target for those screens, sized on first use
+  float screenScale;
+  GLuint screenFBO;
+  GLuint screenColor; // Renderbuffer
+  int screenTargetWidth;
+  int screenTargetHeight;
+
+  // Heart model for UI
+  std::unique_ptr<Model> heartModel;
+
+  // Overlay meshes (damage flash edges, heart icons)
+  std::unique_ptr<Mesh> flashQuad;
+  std::unique_ptr<Mesh> heartMesh;
+
+  // Interpolated view for the frame being drawn
+  Camera camera;
+
+  // Scene instances sorted by shader variant: variant << 32 | index
+  std::vector<uint64_t> drawOrder;
+
+  RenderStats stats;
+  uint64_t frameNumber;
+  double sceneTime;
+
+  // Ring of GL_TIME_ELAPSED queries, deep enough that reading the oldest
+  // one back never waits on the GPU in practice
+  static const int kTimerQueryCount = 8;
+  bool gpuTiming;
+  GLuint timerQueries[kTimerQueryCount];
+  uint64_t timerFrames[kTimerQueryCount];
+  bool timerPending[kTimerQueryCount];
+  int nextTimerQuery;
+  std::vector<std::pair<uint64_t, double>> readyGpuTimes;
+
+  void renderContents(const RenderSnapshot *previous,
+                      const RenderSnapshot &current, float alpha, int width,
+                      int height, ParticleSystem *particles);
+  void readTimerQuery(int slot);
+  void countDraw(const Mesh &mesh);
+
+  void initScreenQuad();
+  void renderScreen(Shader *shader, float time, int width, int height);
+  void drawScreen(Shader *shader, float time);
+  bool resizeScreenTarget(int width, int height);
+  void renderScene(const RenderSnapshot *previous,
+                   const RenderSnapshot &current, float alpha, int width,
+                   int height, ParticleSystem *particles);
+  void renderDamageFlash(float intensity);
+  void renderHearts(int hearts, int maxHearts);
+
+  void beginMaterialBatch(Shader *shader, const glm::mat4 &projection,
+                          const glm::mat4 &view, float time,
+                          const RenderSnapshot &snapshot);
+  void applyLights(Shader *shader, const RenderSnapshot &snapshot);
+  void drawInstance(Shader *shader, const RenderInstance &instance,
+                    const Transform &transform);
+};
 
 #endif
@@ -3,18 +3,51 @@
 
 #include <GL/glew.h>
 #include <glm/glm.hpp>
+#include <cstdint>
+#include <map>
+#include <memory>
 #include <string>
 #include <fstream>
 #include <sstream>
 #include <iostream>
 
+// A vertex + fragment program. Linked programs are cached on disk as driver
+// binaries (shader_cache/), keyed by the sources and the GL driver, so later
+// launches skip compiling. Anything the driver rejects is rebuilt from source.
+//
+// Building is two-phase so several programs compile at once where the driver
+// supports KHR_parallel_shader_compile: the constructor only submits the
+// work, finish() waits for it and reports errors. Call finish() before use.
+//
+// reload() rebuilds from the files without blocking; update() swaps the new
+// program in once it linked, carrying the uniform values over, and keeps the
+// old one when it failed.
 class Shader {
 public:
     GLuint ID;
 
-    Shader(const char* vertexPath, const char* fragmentPath);
+    // `defines` ("#define NAME VALUE" lines) are inserted after the #version
+    // line of both stages
+    Shader(const char* vertexPath, const char* fragmentPath,
+           const std::string& defines = std::string());
     ~Shader();
 
+    // True once finish() would not block
+    bool isReady() const;
+    // Waits for the compile, prints any errors and caches the binary; false
+    // when the program failed to build
+    bool finish();
+    // The program in use linked (a failed reload keeps the old one)
+    bool isLinked() const { return linked; }
+
+    // Hot reload: start a rebuild from the files, then call update() every
+    // frame; true on the frame the new program took over
+    void reload();
+    bool update();
+    bool usesFile(const std::string& path) const;
+    const std::string& getVertexPath() const { return vertexPath; }
+    const std::string& getFragmentPath() const { return fragmentPath; }
+
     void use() const;
     void setBool(const std::string& name, bool value) const;
     void setInt(const std::string& name, int value) const;
@@ -25,7 +58,56 @@ public:
     void setMat3(const std::string& name, const glm::mat3& mat) const;
 
 private:
-    void checkCompileErrors(GLuint shader, const std::string& type);
+    bool readSources(std::string& vertexCode, std::string& fragmentCode) const;
+    void build(const std::string& vertexCode, const std::string& fragmentCode);
+    void compile(const std::string& vertexCode, const std::string& fragmentCode);
+    void discardBuild();
+    void adopt(GLuint program);
+    bool loadBinary();
+    void saveBinary() const;
+    bool checkCompileErrors(GLuint shader, const std::string& type);
+
+    std::string vertexPath;
+    std::string fragmentPath;
+    std::string defines;
+
+    // Build in flight, 0 once finished; ID stays usable meanwhile
+    GLuint buildProgram;
+    GLuint vertexShader;
+    GLuint fragmentShader;
+    bool pending;
+    bool linked;
+    uint64_t cacheKey;
+};
+
+// Specialized builds of one vertex + fragment pair, one per key. A key's
+// #define block comes from `definesFor`; its program is built the first time
+// the key is asked for and kept from then on (and in the binary cache).
+class ShaderPermutations {
+public:
+    typedef std::string (*DefinesFunction)(uint32_t key);
+
+    ShaderPermutations(const char* vertexPath, const char* fragmentPath,
+                       DefinesFunction definesFor);
+
+    // Starts building `key` without waiting, so several first-time builds
+    // compile at once
+    void prepare(uint32_t key);
+    // The finished program for `key`, or null when it failed to build
+    Shader* get(uint32_t key);
+
+    size_t size() const { return variants.size(); }
+
+    // Hot reload, see Shader
+    bool usesFile(const std::string& path) const;
+    void reload();
+    void update();
+
+private:
+    std::string vertexPath;
+    std::string fragmentPath;
+    DefinesFunction definesFor;
+    std::map<uint32_t, std::unique_ptr<Shader>> variants;
 };
 
 #endif
@@ -0,0 +1,43 @@
+#ifndef SHADER_WATCHER_H
+#define SHADER_WATCHER_H
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Reports shader files that changed on disk. Uses inotify on Linux (one
+// non-blocking read per poll) and falls back to comparing modification times
+// twice a second elsewhere or when inotify is unavailable.
+class ShaderWatcher {
+public:
+  ShaderWatcher();
+  ~ShaderWatcher();
+  ShaderWatcher(const ShaderWatcher &) = delete;
+  ShaderWatcher &operator=(const ShaderWatcher &) = delete;
+
+  // Watches `path`; paths are reported back exactly as given here
+  void watch(const std::string &path);
+
+  // Appends each watched path written since the last poll, once
+  void poll(std::vector<std::string> &changed);
+
+private:
+  struct File {
+    std::string path;
+    std::string directory;
+    std::string name;
+    std::filesystem::file_time_type modified;
+  };
+  std::vector<File> files;
+
+  int inotifyFd; // -1 when polling modification times
+  std::vector<std::pair<int, std::string>> watchedDirectories; // wd, path
+
+  std::chrono::steady_clock::time_point nextScan;
+
+  void pollInotify(std::vector<std::string> &changed);
+  void pollModificationTimes(std::vector<std::string> &changed);
+};
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef STATE_BUFFER_H
+#define STATE_BUFFER_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// Flat byte buffer for saving and restoring mutable game state in place.
+// Values are copied raw, so only trivially copyable types go in; whatever
+// writes a sequence of values must read them back in the same order.
+// Pointers (textures, models, meshes) may be stored as long as the objects
+// they point to outlive the buffer - they are never owned here.
+class StateBuffer {
+public:
+  StateBuffer() : readOffset(0) {}
+
+  template <typename T> void write(const T &value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "StateBuffer only stores trivially copyable types");
+    size_t offset = bytes.size();
+    bytes.resize(offset + sizeof(T));
+    std::memcpy(bytes.data() + offset, &value, sizeof(T));
+  }
+
+  template <typename T> void read(T &value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "StateBuffer only stores trivially copyable types");
+    assert(readOffset + sizeof(T) <= bytes.size() &&
+           "StateBuffer read past the end (save/restore order mismatch?)");
+    std::memcpy(&value, bytes.data() + readOffset, sizeof(T));
+    readOffset += sizeof(T);
+  }
+
+  // Vectors are stored as a count followed by the elements
+  template <typename T> void write(const std::vector<T> &values) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "StateBuffer only stores trivially copyable types");
+    write(values.size());
+    if (values.empty())
+      return;
+    size_t offset = bytes.size();
+    bytes.resize(offset + values.size() * sizeof(T));
+    std::memcpy(bytes.data() + offset, values.data(),
+                values.size() * sizeof(T));
+  }
+
+  template <typename T> void read(std::vector<T> &values) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "StateBuffer only stores trivially copyable types");
+    size_t count;
+    read(count);
+    assert(readOffset + count * sizeof(T) <= bytes.size() &&
+           "StateBuffer read past the end (save/restore order mismatch?)");
+    values.resize(count);
+    if (count == 0)
+      return;
+    std::memcpy(values.data(), bytes.data() + readOffset, count * sizeof(T));
+    readOffset += count * sizeof(T);
+  }
+
+  void clear() {
+    bytes.clear();
+    readOffset = 0;
+  }
+  void rewind() { readOffset = 0; }
+
+  bool empty() const { return bytes.empty(); }
+  size_t size() const { return bytes.size(); }
+
+private:
+  std::vector<unsigned char> bytes;
+  size_t readOffset;
+};
+
+#endif
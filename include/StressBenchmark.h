@@ -0,0 +1,17 @@
+#ifndef STRESS_BENCHMARK_H
+#define STRESS_BENCHMARK_H
+
+#include "GameSettings.h"
+
+// Headless scalability benchmark. Builds the stress level at 1/16, 1/8, 1/4,
+// 1/2 and the full configured counts, runs a scripted player through each
+// for a fixed number of ticks, and times every simulation subsystem per
+// tick (level update phases, particles, snapshot building). Results go to a
+// CSV with one row per size and subsystem, ready to chart cost against N.
+//
+// Nothing is rendered, but meshes upload to the GPU when they are created,
+// so an invisible window provides a GL context. Returns the process exit
+// code.
+int runStressBenchmark(const GameSettings &settings);
+
+#endif
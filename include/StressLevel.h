@@ -0,0 +1,36 @@
+#ifndef STRESS_LEVEL_H
+#define STRESS_LEVEL_H
+
+#include "GameSettings.h"
+#include "Level.h"
+#include <random>
+
+// Procedurally generated level for scalability testing. Walls, hazards and
+// lights are scattered over a square floor sized to keep their density about
+// the same at any count, and the particle system is kept topped up to the
+// configured number of live particles. The same seed always generates the
+// same level.
+class StressLevel : public Level {
+public:
+  explicit StressLevel(const StressLevelConfig &config);
+  void init() override;
+  void update(float deltaTime, Player *player,
+              ParticleSystem *particles) override;
+
+  const StressLevelConfig &getConfig() const { return config; }
+  float getHalfSize() const { return halfSize; }
+
+private:
+  void createWalls();
+  void createHazards();
+  void createLights();
+
+  // A random floor position at least `clearance` from the player start
+  glm::vec3 randomPosition(float y, float clearance);
+
+  StressLevelConfig config;
+  float halfSize; // The floor spans [-halfSize, halfSize] in x and z
+  std::mt19937 rng;
+};
+
+#endif
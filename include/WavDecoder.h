@@ -0,0 +1,21 @@
+#ifndef WAV_DECODER_H
+#define WAV_DECODER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// RIFF/WAVE decoding to signed 16-bit samples, for AudioManager's buffers.
+// Handles 8, 16 and 24-bit PCM, 32-bit PCM and 32-bit float; channels stay
+// interleaved as stored.
+
+// Decodes a whole file image. `name` only labels error messages.
+bool decodeWav(const unsigned char *data, size_t size,
+               std::vector<short> &samples, int &sampleRate,
+               const std::string &name);
+
+// Reads and decodes a file
+bool loadWav(const std::string &path, std::vector<short> &samples,
+             int &sampleRate);
+
+#endif
@@ -22,9 +22,16 @@ uniform int numLights;
 uniform vec3 ambientLight;
 
 uniform float transparency;
-uniform int materialType; // 0=None, 1=Brick, 2=Checkered, 3=Rock, 4=Organic
-uniform float time; // For animations
+#ifdef MATERIAL_TYPE
+// Specialized variant: material and texture use are constants, so the
+// compiler drops the code of every other material
+const int materialType = MATERIAL_TYPE;
+const bool useTexture = USE_TEXTURE;
+#else
+uniform int materialType; // 0=None, 1=Brick, 2=Checkered, 3=Rock, 4=Cave, 5=Mud
 uniform bool useTexture; // Whether to use texture
+#endif
+uniform float time; // For animations
 uniform sampler2D textureSampler; // Texture sampler
 
 // Pseudo-random function
@@ -1,10 +1,12 @@
 #version 330 core
 layout (location = 0) in vec3 aPos;
+layout (location = 3) in vec3 aPosScale;
+layout (location = 4) in vec3 aPosOffset;
 
 uniform mat4 lightSpaceMatrix;
 uniform mat4 model;
 
 void main()
 {
-    gl_Position = lightSpaceMatrix * model * vec4(aPos, 1.0);
+    gl_Position = lightSpaceMatrix * model * vec4(aPosOffset + aPosScale * aPos, 1.0);
 }
@@ -1,8 +1,10 @@
 #version 330 core
 
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aNormal;
-layout (location = 2) in vec2 aTexCoord;
+layout (location = 0) in vec3 aPos;       // snorm16, quantized to mesh bounds
+layout (location = 1) in vec2 aNormal;    // Octahedral snorm16
+layout (location = 2) in vec2 aTexCoord;  // Half float
+layout (location = 3) in vec3 aPosScale;  // Per-mesh dequantization (constant)
+layout (location = 4) in vec3 aPosOffset;
 
 out vec3 FragPos;
 out vec3 Normal;
@@ -13,10 +15,21 @@ uniform mat4 view;
 uniform mat4 projection;
 uniform mat3 normalMatrix;
 
+vec3 decodeOctahedral(vec2 e)
+{
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0) {
+        vec2 s = vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+        n.xy = (1.0 - abs(n.yx)) * s;
+    }
+    return normalize(n);
+}
+
 void main()
 {
-    FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = normalize(normalMatrix * aNormal);
+    vec3 position = aPosOffset + aPosScale * aPos;
+    FragPos = vec3(model * vec4(position, 1.0));
+    Normal = normalize(normalMatrix * decodeOctahedral(aNormal));
     TexCoord = aTexCoord;
     
     gl_Position = projection * view * vec4(FragPos, 1.0);
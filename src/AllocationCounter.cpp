@@ -0,0 +1,69 @@
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<size_t> allocationCount{0};
+std::atomic<size_t> allocatedBytes{0};
+size_t frameStartCount = 0;
+} // namespace
+
+#ifdef CHRONO_TRACK_ALLOCATIONS
+
+namespace {
+void *countedAlloc(std::size_t size) {
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+  if (size == 0)
+    size = 1;
+  return std::malloc(size);
+}
+} // namespace
+
+void *operator new(std::size_t size) {
+  if (void *p = countedAlloc(size))
+    return p;
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) {
+  if (void *p = countedAlloc(size))
+    return p;
+  throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  return countedAlloc(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+  return countedAlloc(size);
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+bool AllocationCounter::isEnabled() { return true; }
+
+#else
+
+bool AllocationCounter::isEnabled() { return false; }
+
+#endif
+
+size_t AllocationCounter::totalAllocations() {
+  return allocationCount.load(std::memory_order_relaxed);
+}
+
+size_t AllocationCounter::totalBytes() {
+  return allocatedBytes.load(std::memory_order_relaxed);
+}
+
+void AllocationCounter::beginFrame() { frameStartCount = totalAllocations(); }
+
+size_t AllocationCounter::endFrame() {
+  return totalAllocations() - frameStartCount;
+}
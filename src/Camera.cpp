@@ -129,6 +129,20 @@ void Camera::setThirdPersonMode(const glm::vec3 &playerPos) {
   up = glm::normalize(glm::cross(right, front));
 }
 
+void Camera::setFreeView(const glm::vec3 &eye, const glm::vec3 &direction) {
+  mode = FIRST_PERSON;
+  position = eye;
+
+  // Keep yaw/pitch in step so switching back to mouse look doesn't jump
+  glm::vec3 dir = glm::normalize(direction);
+  pitch = glm::degrees(asin(glm::clamp(dir.y, -1.0f, 1.0f)));
+  yaw = glm::degrees(atan2(dir.z, dir.x));
+
+  front = dir;
+  right = glm::normalize(glm::cross(front, worldUp));
+  up = glm::normalize(glm::cross(right, front));
+}
+
 void Camera::toggleMode() {
   if (mode == FIRST_PERSON) {
     mode = THIRD_PERSON;
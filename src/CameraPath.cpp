@@ -0,0 +1,113 @@
+#include "CameraPath.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+// Uniform Catmull-Rom between p1 and p2, u in [0, 1]
+glm::vec3 catmullRom(const glm::vec3 &p0, const glm::vec3 &p1,
+                     const glm::vec3 &p2, const glm::vec3 &p3, float u) {
+  float u2 = u * u;
+  float u3 = u2 * u;
+  return 0.5f * ((2.0f * p1) + (p2 - p0) * u +
+                 (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * u2 +
+                 (3.0f * p1 - p0 - 3.0f * p2 + p3) * u3);
+}
+} // namespace
+
+void CameraPath::addKey(float time, const glm::vec3 &position,
+                        const glm::vec3 &target) {
+  Key key;
+  key.time = time;
+  key.position = position;
+  key.target = target;
+
+  // Keys normally arrive in order; keep the list sorted if not
+  auto it = std::upper_bound(
+      keys.begin(), keys.end(), time,
+      [](float t, const Key &other) { return t < other.time; });
+  keys.insert(it, key);
+}
+
+bool CameraPath::load(const std::string &path) {
+  std::ifstream file(path);
+  if (!file) {
+    std::cerr << "Cannot open camera path " << path << std::endl;
+    return false;
+  }
+
+  keys.clear();
+  std::string line;
+  int lineNumber = 0;
+  while (std::getline(file, line)) {
+    lineNumber++;
+    if (line.empty() || line[0] == '#')
+      continue;
+    std::istringstream fields(line);
+    float time;
+    glm::vec3 position, target;
+    if (!(fields >> time >> position.x >> position.y >> position.z >>
+          target.x >> target.y >> target.z)) {
+      std::cerr << path << ":" << lineNumber << ": bad camera key"
+                << std::endl;
+      return false;
+    }
+    addKey(time, position, target);
+  }
+
+  if (keys.size() < 2) {
+    std::cerr << "Camera path " << path << " needs at least two keys"
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool CameraPath::save(const std::string &path) const {
+  std::ofstream file(path);
+  if (!file) {
+    std::cerr << "Cannot write camera path " << path << std::endl;
+    return false;
+  }
+  file << "# time  x y z  targetX targetY targetZ\n";
+  for (const Key &key : keys) {
+    file << key.time << "  " << key.position.x << ' ' << key.position.y << ' '
+         << key.position.z << "  " << key.target.x << ' ' << key.target.y
+         << ' ' << key.target.z << '\n';
+  }
+  return static_cast<bool>(file);
+}
+
+void CameraPath::sample(float time, glm::vec3 &position,
+                        glm::vec3 &front) const {
+  if (keys.empty()) {
+    position = glm::vec3(0.0f);
+    front = glm::vec3(0.0f, 0.0f, -1.0f);
+    return;
+  }
+
+  // Segment [i, i + 1] containing time
+  size_t last = keys.size() - 1;
+  size_t i = 0;
+  while (i + 1 < last && keys[i + 1].time <= time)
+    i++;
+  size_t next = std::min(i + 1, last);
+
+  float span = keys[next].time - keys[i].time;
+  float u = span > 0.0f ? (time - keys[i].time) / span : 0.0f;
+  u = std::min(std::max(u, 0.0f), 1.0f);
+
+  const Key &k0 = keys[i > 0 ? i - 1 : 0];
+  const Key &k1 = keys[i];
+  const Key &k2 = keys[next];
+  const Key &k3 = keys[std::min(next + 1, last)];
+
+  position = catmullRom(k0.position, k1.position, k2.position, k3.position, u);
+  glm::vec3 target =
+      catmullRom(k0.target, k1.target, k2.target, k3.target, u);
+
+  front = target - position;
+  front = glm::length(front) > 0.001f ? glm::normalize(front)
+                                      : glm::vec3(0.0f, 0.0f, -1.0f);
+}
@@ -0,0 +1,101 @@
+#include "CommandBuffer.h"
+#include "FrameAllocator.h"
+#include "JobSystem.h"
+#include "ParticleSystem.h"
+
+namespace {
+std::vector<CommandBuffer> &threadBuffers() {
+  // Sized once, before any job can run, so threads never resize it
+  static std::vector<CommandBuffer> buffers(
+      JobSystem::getInstance().getThreadCount());
+  return buffers;
+}
+} // namespace
+
+CommandBuffer &CommandBuffer::local() {
+  return threadBuffers()[JobSystem::getThreadIndex()];
+}
+
+void CommandBuffer::flushAll(ParticleSystem *particles) {
+  for (auto &buffer : threadBuffers()) {
+    buffer.flush(particles);
+  }
+}
+
+void CommandBuffer::playSound(SoundEffect effect, float volume) {
+  Command cmd = {};
+  cmd.type = CommandType::PLAY_SOUND;
+  cmd.sound = effect;
+  cmd.volume = volume;
+  commands.push_back(cmd);
+}
+
+void CommandBuffer::emit(const glm::vec3 &position, const glm::vec3 &velocity,
+                         const glm::vec4 &color, float size, float lifetime,
+                         int count) {
+  Command cmd = {};
+  cmd.type = CommandType::EMIT;
+  cmd.position = position;
+  cmd.velocity = velocity;
+  cmd.color = color;
+  cmd.size = size;
+  cmd.lifetime = lifetime;
+  cmd.count = count;
+  commands.push_back(cmd);
+}
+
+void CommandBuffer::emitExplosion(const glm::vec3 &position,
+                                  const glm::vec3 &color, int count) {
+  Command cmd = {};
+  cmd.type = CommandType::EMIT_EXPLOSION;
+  cmd.position = position;
+  cmd.color = glm::vec4(color, 1.0f);
+  cmd.count = count;
+  commands.push_back(cmd);
+}
+
+void CommandBuffer::flush(ParticleSystem *particles) {
+  auto sameEmitter = [](const Command &a, const Command &b) {
+    return a.velocity == b.velocity && a.color == b.color &&
+           a.size == b.size && a.lifetime == b.lifetime && a.count == b.count;
+  };
+
+  size_t i = 0;
+  while (i < commands.size()) {
+    const Command &cmd = commands[i];
+
+    switch (cmd.type) {
+    case CommandType::PLAY_SOUND:
+      AudioManager::getInstance().playSound(cmd.sound, cmd.volume);
+      i++;
+      break;
+
+    case CommandType::EMIT_EXPLOSION:
+      particles->emitExplosion(cmd.position, glm::vec3(cmd.color), cmd.count);
+      i++;
+      break;
+
+    case CommandType::EMIT: {
+      // Merge a run of emits that only differ by origin into one batch
+      size_t end = i + 1;
+      while (end < commands.size() && commands[end].type == CommandType::EMIT &&
+             sameEmitter(cmd, commands[end])) {
+        end++;
+      }
+
+      glm::vec3 *origins =
+          FrameAllocator::getInstance().allocArray<glm::vec3>(end - i);
+      for (size_t j = i; j < end; j++) {
+        origins[j - i] = commands[j].position;
+      }
+      particles->emitBatch(origins, (int)(end - i), cmd.velocity, cmd.color,
+                           cmd.size, cmd.lifetime, cmd.count);
+      i = end;
+      break;
+    }
+    }
+  }
+
+  // Keep the capacity so steady-state frames don't allocate
+  commands.clear();
+}
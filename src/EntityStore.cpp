@@ -0,0 +1,484 @@
+#include "EntityStore.h"
+#include "CommandBuffer.h"
+#include "JobSystem.h"
+#include "ParticleSystem.h"
+#include "Player.h"
+#include "RenderSnapshot.h"
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+// Smallest range worth handing to another thread
+const size_t kUpdateGrainSize = 32;
+
+// Entities whose activity bounds come this close to the player stay awake
+// even off screen (every hazard interaction happens well inside this)
+const float kWakeDistance = 25.0f;
+
+// Stalactites fall until they drop below kStalactiteResetHeight
+const float kStalactiteGravity = 12.0f;
+const float kStalactiteResetHeight = -10.0f;
+
+// Geyser steam rises about this far above the vent
+const float kGeyserPlumeHeight = 6.0f;
+
+// xorshift32 - cheap, thread-local-state random numbers
+uint32_t nextRandom(uint32_t &state) {
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+float randomFallDelay(uint32_t &state) {
+  return 2.0f + (nextRandom(state) % 600) / 100.0f; // Random 2-8 seconds
+}
+} // namespace
+
+EntityStore::EntityStore() : clock(0.0) {}
+
+void PendulumParams::clear() {
+  pivotPoint.clear();
+  length.clear();
+  phase.clear();
+  swingSpeed.clear();
+  maxAngle.clear();
+}
+
+void EntityStore::reserve(size_t pendulumCount, size_t stalactiteCount,
+                          size_t geyserCount) {
+  size_t total = size() + pendulumCount + stalactiteCount + geyserCount;
+  transforms.reserve(total);
+  boxes.reserve(total);
+  spheres.reserve(total);
+  render.reserve(total);
+  activity.reserve(total);
+
+  pendulumCount += pendulums.size();
+  pendulumIds.reserve(pendulumCount);
+  pendulums.pivotPoint.reserve(pendulumCount);
+  pendulums.length.reserve(pendulumCount);
+  pendulums.phase.reserve(pendulumCount);
+  pendulums.swingSpeed.reserve(pendulumCount);
+  pendulums.maxAngle.reserve(pendulumCount);
+
+  stalactiteIds.reserve(stalactites.size() + stalactiteCount);
+  stalactites.reserve(stalactites.size() + stalactiteCount);
+  geyserIds.reserve(geysers.size() + geyserCount);
+  geysers.reserve(geysers.size() + geyserCount);
+}
+
+uint32_t EntityStore::addEntity(const Transform &transform, Mesh *mesh,
+                                const glm::vec3 &color) {
+  uint32_t id = static_cast<uint32_t>(transforms.size());
+  transforms.push_back(transform);
+  boxes.push_back(
+      Physics::createAABBFromTransform(transform.position, transform.scale));
+  spheres.push_back(Sphere(transform.position, 0.0f));
+
+  RenderInfo info;
+  info.mesh = mesh;
+  info.color = color;
+  render.push_back(info);
+
+  ActivityState state;
+  state.bounds = boxes.back();
+  state.awake = true;
+  activity.push_back(state);
+  return id;
+}
+
+uint32_t EntityStore::addPendulum(const glm::vec3 &pivot, float length,
+                                  float swingSpeed, float swingAngle,
+                                  const glm::vec3 &scale) {
+  if (!pendulumMesh)
+    pendulumMesh.reset(Mesh::createCube(1.0f));
+
+  Transform transform;
+  transform.scale = scale;
+
+  uint32_t id = addEntity(transform, pendulumMesh.get(),
+                          glm::vec3(0.15f, 0.15f, 0.18f)); // Dark metallic
+  pendulumIds.push_back(id);
+
+  // The blade can be anywhere on its arc around the pivot
+  glm::vec3 reach(length + 0.5f * glm::length(scale));
+  activity[id].bounds = AABB(pivot - reach, pivot + reach);
+
+  pendulums.pivotPoint.push_back(pivot);
+  pendulums.length.push_back(length);
+  pendulums.phase.push_back(swingAngle);
+  pendulums.swingSpeed.push_back(swingSpeed);
+  pendulums.maxAngle.push_back(glm::radians(45.0f));
+
+  // Start on the arc, not at the origin: a blade that sleeps from its first
+  // tick keeps this pose (and box) until it wakes
+  pendulumBoxes.resize(pendulums.size());
+  poseBlade(pendulums.size() - 1);
+  return id;
+}
+
+uint32_t EntityStore::addStalactite(const glm::vec3 &position,
+                                    const glm::vec3 &scale) {
+  // Cone: radius 0.6, height 3.75
+  if (!stalactiteMesh)
+    stalactiteMesh.reset(Mesh::createCone(0.6f, 3.75f, 16));
+
+  Transform transform;
+  transform.position = position;
+  transform.scale = scale;
+  transform.rotation =
+      glm::vec3(glm::radians(180.0f), 0.0f, 0.0f); // Point down
+
+  uint32_t id = addEntity(transform, stalactiteMesh.get(),
+                          glm::vec3(0.4f, 0.35f, 0.3f)); // Brown rock
+  spheres[id] = Physics::createSphereFromTransform(position, 0.8f);
+  stalactiteIds.push_back(id);
+
+  // The whole column it falls through
+  activity[id].bounds =
+      AABB(glm::vec3(position.x - 1.0f, kStalactiteResetHeight,
+                     position.z - 1.0f),
+           glm::vec3(position.x + 1.0f, position.y + 0.5f * scale.y,
+                     position.z + 1.0f));
+
+  StalactiteState state;
+  state.originalPosition = position;
+  state.isFalling = false;
+  state.rngState = (uint32_t)rand() | 1u; // Seed must be non-zero
+  state.fallAt = clock + randomFallDelay(state.rngState);
+  stalactites.push_back(state);
+  return id;
+}
+
+uint32_t EntityStore::addGeyser(const glm::vec3 &position) {
+  // Much larger radius for bigger hitbox
+  if (!geyserMesh)
+    geyserMesh.reset(Mesh::createCylinder(1.5f, 0.15f, 16));
+
+  Transform transform;
+  transform.position = position;
+  transform.scale = glm::vec3(1.2f, 0.15f, 1.2f);
+
+  uint32_t id = addEntity(transform, geyserMesh.get(),
+                          glm::vec3(0.45f, 0.35f, 0.25f)); // Brown/orange
+  geyserIds.push_back(id);
+
+  // Vent plus the steam column above it
+  activity[id].bounds =
+      AABB(position - glm::vec3(1.5f, 0.5f, 1.5f),
+           position + glm::vec3(1.5f, kGeyserPlumeHeight, 1.5f));
+
+  GeyserState state;
+  state.eruptDuration = 2.0f;
+  state.eruptInterval = 2.5f;
+  // Start at the beginning of the idle part of the cycle
+  state.phase = -(float)std::fmod(clock, (double)(state.eruptInterval +
+                                                  state.eruptDuration));
+  state.pushForce = glm::vec3(0.0f, 15.0f, 0.0f);
+  geysers.push_back(state);
+  return id;
+}
+
+void EntityStore::clear() {
+  transforms.clear();
+  boxes.clear();
+  spheres.clear();
+  render.clear();
+  activity.clear();
+  clock = 0.0;
+  pendulumIds.clear();
+  pendulums.clear();
+  pendulumBoxes.clear();
+  stalactiteIds.clear();
+  stalactites.clear();
+  geyserIds.clear();
+  geysers.clear();
+}
+
+void EntityStore::saveState(StateBuffer &state) const {
+  state.write(clock);
+  state.write(transforms);
+  state.write(boxes);
+  state.write(spheres);
+  state.write(render);
+  state.write(activity);
+  state.write(stalactites);
+  for (int c = 0; c < 3; c++) {
+    state.write(pendulumBoxes.center[c]);
+    state.write(pendulumBoxes.halfExtent[c]);
+    for (int k = 0; k < 3; k++) {
+      state.write(pendulumBoxes.axis[k][c]);
+    }
+  }
+}
+
+void EntityStore::restoreState(StateBuffer &state) {
+  state.read(clock);
+  state.read(transforms);
+  state.read(boxes);
+  state.read(spheres);
+  state.read(render);
+  state.read(activity);
+  state.read(stalactites);
+  for (int c = 0; c < 3; c++) {
+    state.read(pendulumBoxes.center[c]);
+    state.read(pendulumBoxes.halfExtent[c]);
+    for (int k = 0; k < 3; k++) {
+      state.read(pendulumBoxes.axis[k][c]);
+    }
+  }
+}
+
+void EntityStore::updateActivity(const glm::vec3 &playerPosition,
+                                 const Frustum &view) {
+  for (uint32_t id : pendulumIds) {
+    refreshActivity(id, playerPosition, view);
+  }
+  for (uint32_t id : stalactiteIds) {
+    refreshActivity(id, playerPosition, view);
+  }
+  for (uint32_t id : geyserIds) {
+    refreshActivity(id, playerPosition, view);
+  }
+}
+
+size_t EntityStore::getAwakeCount() const {
+  size_t count = 0;
+  for (const ActivityState &state : activity) {
+    if (state.awake)
+      count++;
+  }
+  return count;
+}
+
+void EntityStore::refreshActivity(uint32_t id, const glm::vec3 &playerPosition,
+                                  const Frustum &view) {
+  ActivityState &state = activity[id];
+
+  glm::vec3 offset =
+      glm::clamp(playerPosition, state.bounds.min, state.bounds.max) -
+      playerPosition;
+  state.awake = glm::dot(offset, offset) < kWakeDistance * kWakeDistance ||
+                view.intersects(state.bounds);
+}
+
+float EntityStore::getPendulumAngle(size_t index, double time) const {
+  // Phase in double so the angle stays exact over long sessions
+  double phase = pendulums.phase[index] + pendulums.swingSpeed[index] * time;
+  return (float)std::sin(phase) * pendulums.maxAngle[index];
+}
+
+bool EntityStore::isGeyserErupting(size_t index, double time) const {
+  const GeyserState &g = geysers[index];
+  double period = g.eruptInterval + g.eruptDuration;
+  double cycle = std::fmod(g.phase + time, period);
+  if (cycle < 0.0)
+    cycle += period;
+  return cycle >= g.eruptInterval;
+}
+
+void EntityStore::update(float deltaTime) {
+  JobSystem &jobs = JobSystem::getInstance();
+  clock += deltaTime;
+
+  // Every entity only writes its own components, so ranges are independent
+  jobs.parallelFor(pendulums.size(), kUpdateGrainSize,
+                   [this](size_t begin, size_t end) {
+                     updatePendulums(begin, end);
+                   });
+  jobs.parallelFor(stalactites.size(), kUpdateGrainSize,
+                   [this](size_t begin, size_t end) {
+                     updateStalactites(begin, end);
+                   });
+  jobs.parallelFor(geysers.size(), kUpdateGrainSize,
+                   [this](size_t begin, size_t end) {
+                     updateGeysers(begin, end);
+                   });
+}
+
+void EntityStore::updatePendulums(size_t begin, size_t end) {
+  for (size_t i = begin; i < end; i++) {
+    uint32_t id = pendulumIds[i];
+    if (!render[id].active || !activity[id].awake)
+      continue;
+
+    poseBlade(i);
+  }
+}
+
+void EntityStore::poseBlade(size_t index) {
+  uint32_t id = pendulumIds[index];
+  float angle = getPendulumAngle(index, clock);
+
+  // Calculate pendulum position
+  const glm::vec3 &pivot = pendulums.pivotPoint[index];
+  float length = pendulums.length[index];
+  Transform &transform = transforms[id];
+  transform.position.x = pivot.x + sin(angle) * length;
+  transform.position.y = pivot.y - cos(angle) * length;
+  transform.position.z = pivot.z;
+
+  // Rotate the blade
+  transform.setRotation(glm::vec3(0.0f, 0.0f, angle));
+
+  // The blade collides as an oriented box; boxes[] keeps its bounds
+  OBB blade = Physics::createOBBFromTransform(
+      transform.position, transform.rotation, transform.scale);
+  pendulumBoxes.set(index, blade);
+  boxes[id] = blade.getBounds();
+}
+
+void EntityStore::updateStalactites(size_t begin, size_t end) {
+  for (size_t i = begin; i < end; i++) {
+    uint32_t id = stalactiteIds[i];
+    if (!render[id].active || !activity[id].awake)
+      continue;
+
+    StalactiteState &s = stalactites[i];
+    Transform &transform = transforms[id];
+
+    // Time to fall from rest to the reset height
+    float dropTime =
+        std::sqrt(2.0f * (s.originalPosition.y - kStalactiteResetHeight) /
+                  kStalactiteGravity);
+
+    // Catch up through any falls that finished since the last evaluation
+    // (several, after a long sleep)
+    for (;;) {
+      if (!s.isFalling) {
+        if (clock < s.fallAt) {
+          transform.position = s.originalPosition;
+          break;
+        }
+        s.isFalling = true;
+      }
+
+      // Gravity (slower fall for dramatic effect)
+      float fallTime = (float)(clock - s.fallAt);
+      if (fallTime < dropTime) {
+        transform.position = s.originalPosition;
+        transform.position.y -=
+            0.5f * kStalactiteGravity * fallTime * fallTime;
+        break;
+      }
+
+      // Reset once it falls below the map (instead of deactivating)
+      s.isFalling = false;
+      s.fallAt += dropTime + randomFallDelay(s.rngState);
+    }
+
+    if (s.isFalling) {
+      spheres[id] =
+          Physics::createSphereFromTransform(transform.position, 0.6f);
+    }
+  }
+}
+
+void EntityStore::updateGeysers(size_t begin, size_t end) {
+  CommandBuffer &commands = CommandBuffer::local();
+
+  for (size_t i = begin; i < end; i++) {
+    uint32_t id = geyserIds[i];
+    if (!render[id].active || !activity[id].awake)
+      continue;
+
+    if (isGeyserErupting(i)) {
+      // White/Grey steam rising from slightly above the vent
+      commands.emit(transforms[id].position + glm::vec3(0.0f, 0.5f, 0.0f),
+                    glm::vec3(0.0f, 5.0f, 0.0f),       // Upward velocity
+                    glm::vec4(0.8f, 0.8f, 0.9f, 0.5f), // White-ish steam
+                    0.3f,                              // Larger particles
+                    1.0f,                              // Lifetime
+                    8); // More particles per frame
+    }
+  }
+}
+
+void EntityStore::triggerStalactite(size_t index) {
+  StalactiteState &s = stalactites[index];
+  if (!s.isFalling) {
+    s.isFalling = true;
+    s.fallAt = clock;
+  }
+}
+
+RenderInstance &EntityStore::drawEntity(RenderSnapshot &snapshot, uint32_t id,
+                                        const glm::vec3 &color) const {
+  // Hazards are untextured and use the default shininess
+  const RenderInfo &info = render[id];
+  RenderInstance &instance =
+      snapshot.addInstance(&transforms[id], transforms[id], color);
+  instance.mesh = info.mesh;
+  instance.transparency = info.transparency;
+  instance.emissive = info.emissive;
+  instance.materialType = info.materialType;
+  return instance;
+}
+
+void EntityStore::draw(RenderSnapshot &snapshot) const {
+  // Emit kind by kind so consecutive draws reuse the same mesh. Sleeping
+  // entities are off screen by definition.
+  for (uint32_t id : pendulumIds) {
+    if (render[id].active && activity[id].awake)
+      drawEntity(snapshot, id, render[id].color);
+  }
+
+  for (uint32_t id : stalactiteIds) {
+    if (render[id].active && activity[id].awake)
+      drawEntity(snapshot, id, render[id].color);
+  }
+
+  for (size_t i = 0; i < geysers.size(); i++) {
+    uint32_t id = geyserIds[i];
+    if (!render[id].active || !activity[id].awake)
+      continue;
+
+    if (isGeyserErupting(i)) {
+      // Visual indicator when erupting - lighter and shinier
+      RenderInstance &instance =
+          drawEntity(snapshot, id, glm::vec3(0.5f, 0.4f, 0.3f));
+      instance.shininess = 64.0f;
+    } else {
+      drawEntity(snapshot, id, render[id].color);
+    }
+  }
+}
+
+void EntityStore::checkPlayerCollisions(Player *player,
+                                        ParticleSystem *particles) {
+  // Pendulum blades (oriented box collision, all blades in one batch)
+  if (Physics::sphereOBBBatch(player->collisionSphere, pendulumBoxes,
+                              hitMask) > 0) {
+    for (size_t i = 0; i < pendulums.size(); i++) {
+      if (!(hitMask[i / 32] & (1u << (i % 32))))
+        continue;
+
+      // A sleeping blade is far away or off screen and its box is stale
+      uint32_t id = pendulumIds[i];
+      if (!render[id].active || !activity[id].awake)
+        continue;
+
+      glm::vec3 knockback =
+          glm::normalize(player->getPosition() - transforms[id].position);
+      player->onObstacleHit(knockback, particles);
+    }
+  }
+
+  // Stalactites are only a hazard while falling (sphere collision)
+  for (size_t i = 0; i < stalactites.size(); i++) {
+    uint32_t id = stalactiteIds[i];
+    if (!render[id].active || !stalactites[i].isFalling)
+      continue;
+
+    if (Physics::checkSphereCollision(player->collisionSphere, spheres[id])) {
+      // Apply pushback/knockback with some upward force too
+      glm::vec3 knockback =
+          glm::normalize(player->getPosition() - transforms[id].position);
+      knockback.y = 0.5f;
+      knockback = glm::normalize(knockback);
+
+      player->onObstacleHit(knockback, particles);
+    }
+  }
+}
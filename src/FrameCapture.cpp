@@ -0,0 +1,99 @@
+#include "FrameCapture.h"
+#include "PngWriter.h"
+#include <iostream>
+
+FrameCapture::FrameCapture() : nextSlot(0), width(0), height(0) {
+  for (Slot &slot : slots) {
+    slot.pixelBuffer = 0;
+    slot.fence = nullptr;
+  }
+}
+
+FrameCapture::~FrameCapture() { cleanup(); }
+
+void FrameCapture::init(int width, int height) {
+  cleanup();
+  this->width = width;
+  this->height = height;
+
+  const GLsizeiptr bytes = (GLsizeiptr)width * height * 4;
+  for (Slot &slot : slots) {
+    glGenBuffers(1, &slot.pixelBuffer);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pixelBuffer);
+    glBufferData(GL_PIXEL_PACK_BUFFER, bytes, nullptr, GL_STREAM_READ);
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+void FrameCapture::cleanup() {
+  for (Slot &slot : slots) {
+    if (slot.fence) {
+      glDeleteSync(slot.fence);
+      slot.fence = nullptr;
+    }
+    if (slot.pixelBuffer) {
+      glDeleteBuffers(1, &slot.pixelBuffer);
+      slot.pixelBuffer = 0;
+    }
+  }
+  nextSlot = 0;
+}
+
+void FrameCapture::capture(const std::string &path) {
+  Slot &slot = slots[nextSlot];
+  if (!slot.pixelBuffer)
+    return;
+  nextSlot = (nextSlot + 1) % kBufferCount;
+
+  // The ring wrapped before the oldest copy was written out
+  if (slot.fence)
+    finish(slot, true);
+
+  // With a pack buffer bound, glReadPixels queues the copy and returns
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pixelBuffer);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  slot.path = path;
+}
+
+void FrameCapture::poll(bool wait) {
+  // Oldest first, so files land in capture order
+  for (int i = 0; i < kBufferCount; i++) {
+    Slot &slot = slots[(nextSlot + i) % kBufferCount];
+    if (slot.fence && !finish(slot, wait))
+      return;
+  }
+}
+
+bool FrameCapture::finish(Slot &slot, bool wait) {
+  GLenum status;
+  if (wait) {
+    status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                              GL_TIMEOUT_IGNORED);
+  } else {
+    status = glClientWaitSync(slot.fence, 0, 0);
+  }
+  if (status == GL_TIMEOUT_EXPIRED)
+    return false;
+  if (status == GL_WAIT_FAILED)
+    std::cerr << "ERROR::FRAME_CAPTURE::WAIT_FAILED " << slot.path << std::endl;
+
+  glDeleteSync(slot.fence);
+  slot.fence = nullptr;
+
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pixelBuffer);
+  const GLsizeiptr bytes = (GLsizeiptr)width * height * 4;
+  const unsigned char *pixels = static_cast<const unsigned char *>(
+      glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bytes, GL_MAP_READ_BIT));
+  if (pixels) {
+    writePng(slot.path, width, height, pixels, true);
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+  } else {
+    std::cerr << "ERROR::FRAME_CAPTURE::MAP_FAILED " << slot.path << std::endl;
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  return true;
+}
@@ -1,24 +1,72 @@
 #include "Game.h"
+#include "AllocationCounter.h"
 #include "AudioManager.h"
-#include "Input.h"
+#include "CameraPath.h"
+#include "FrameAllocator.h"
+#include "FrameCapture.h"
 #include "Level1.h"
 #include "Level2.h"
+#include "StressLevel.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 
+namespace {
+// Longest stretch of real time simulated in one go. After a longer stall
+// (loading, debugger, window drag) the backlog is dropped instead of being
+// replayed as a burst of ticks.
+const double kMaxCatchUpTime = 0.25;
+
+// Q/E camera turn rate, in mouse-delta units per second
+const float kKeyTurnRate = 60.0f;
+
+// --record-path key spacing, in simulated seconds
+const double kRecordInterval = 0.25;
+
+// Value at fraction `p` of sorted samples (nearest rank)
+double percentile(const std::vector<double> &sorted, double p) {
+  if (sorted.empty())
+    return 0.0;
+  return sorted[(size_t)((sorted.size() - 1) * p + 0.5)];
+}
+
+double mean(const std::vector<double> &samples) {
+  if (samples.empty())
+    return 0.0;
+  double total = 0.0;
+  for (double sample : samples)
+    total += sample;
+  return total / samples.size();
+}
+} // namespace
+
 // Initialize static instance pointer
 Game *Game::instance = nullptr;
 
-Game::Game()
-    : window(nullptr), screenWidth(1280), screenHeight(720), startScreenVAO(0),
-      startScreenVBO(0), startScreenTime(0.0f), gameOverTime(0.0f),
-      winScreenTime(0.0f), gameState(GameState::START_SCREEN),
-      currentLevelIndex(0), deltaTime(0.0f), lastFrame(0.0f), running(true) {
+Game::Game(const GameSettings &settings)
+    : settings(settings), window(nullptr), screenWidth(settings.windowWidth),
+      screenHeight(settings.windowHeight), currentLevel(nullptr),
+      startScreenTime(0.0f), gameOverTime(0.0f), winScreenTime(0.0f),
+      gameState(GameState::START_SCREEN), currentLevelIndex(0),
+      deltaTime(0.0f), running(true), frameRequested(false), simBusy(false),
+      simStopping(false), lastTickTime(0.0), tickCount(0),
+      scratchPeakBytes(0),
+      viewAspect((float)settings.windowWidth / settings.windowHeight),
+      recordClock(0.0), nextRecordTime(0.0),
+      fixedStep(1.0 / settings.tickRate),
+      accumulator(0.0), ticksSimulated(0), pendingLevel(kNoLevelRequest) {
   instance = this;
 }
 
 Game::~Game() { cleanup(); }
 
 bool Game::init() {
+  if (settings.headless)
+    return initHeadless();
+
   // Initialize GLFW
   if (!glfwInit()) {
     std::cerr << "Failed to initialize GLFW" << std::endl;
@@ -32,6 +80,8 @@ bool Game::init() {
 #ifdef __APPLE__
   glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 #endif
+  if (settings.offscreen)
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE); // Only for its GL context
 
   // Create window
   window = glfwCreateWindow(screenWidth, screenHeight, "Chrono Guardian",
@@ -51,31 +101,63 @@ bool Game::init() {
     return false;
   }
 
+  // Initialize input system
+  Input::getInstance().init(window);
+
+  if (!initWorld())
+    return false;
+
+  std::cout << "Chrono Guardian - Controls:" << std::endl;
+  std::cout << "  WASD - Move" << std::endl;
+  std::cout << "  Mouse - Look around" << std::endl;
+  std::cout << "  T - Toggle camera view" << std::endl;
+  std::cout << "  R - Restart level" << std::endl;
+  std::cout << "  ESC - Quit" << std::endl;
+
+  return true;
+}
+
+bool Game::initHeadless() {
+  // No GLFW at all: it needs a display server. Only the flythrough runs, and
+  // it draws into its own framebuffer.
+  if (!headlessContext.create())
+    return false;
+  return initWorld();
+}
+
+bool Game::initWorld() {
   // OpenGL configuration
   glEnable(GL_DEPTH_TEST);
   glEnable(GL_CULL_FACE);
   glCullFace(GL_BACK);
   glClearColor(0.2f, 0.3f, 0.4f, 1.0f);
 
-  // Initialize input system
-  Input::getInstance().init(window);
-
   // Initialize audio system
   if (!AudioManager::getInstance().init()) {
     std::cerr << "Warning: Audio system failed to initialize" << std::endl;
   }
 
-  // Load shaders
-  mainShader =
-      std::make_unique<Shader>("shaders/vertex.glsl", "shaders/fragment.glsl");
-  particleShader = std::make_unique<Shader>("shaders/particle_vertex.glsl",
-                                            "shaders/particle_fragment.glsl");
-  startScreenShader = std::make_unique<Shader>(
-      "shaders/start_screen_vertex.glsl", "shaders/start_screen_fragment.glsl");
-  gameOverShader = std::make_unique<Shader>("shaders/game_over_vertex.glsl",
-                                            "shaders/game_over_fragment.glsl");
-  winScreenShader = std::make_unique<Shader>(
-      "shaders/win_screen_vertex.glsl", "shaders/win_screen_fragment.glsl");
+  // Hot reload edits the source tree's shaders, not the copy made at
+  // configure time that the game normally loads
+#ifdef CHRONO_SHADER_SOURCE_DIR
+  if (settings.hotReload) {
+    std::error_code error;
+    if (std::filesystem::is_directory(CHRONO_SHADER_SOURCE_DIR, error))
+      renderer.setShaderDirectory(CHRONO_SHADER_SOURCE_DIR);
+    else
+      std::cerr << "Shader sources not found at " CHRONO_SHADER_SOURCE_DIR
+                   ", watching the copy in shaders/"
+                << std::endl;
+  }
+#endif
+
+  // Shaders, screen quads and UI meshes
+  if (!renderer.init()) {
+    std::cerr << "Failed to initialize renderer" << std::endl;
+    return false;
+  }
+  renderer.setShaderHotReload(settings.hotReload);
+  renderer.setScreenScale(settings.menuScale);
 
   // Create camera
   camera = std::make_unique<Camera>();
@@ -83,60 +165,474 @@ bool Game::init() {
   // Create player
   player = std::make_unique<Player>();
 
-  // Create particle system
-  particles = std::make_unique<ParticleSystem>(2000);
-
-  // Initialize start screen
-  initStartScreen();
-
-  // Load heart model for UI
-  heartModel = std::make_unique<Model>("assets/models/aztec_stone_heart.glb");
-
-  std::cout << "Chrono Guardian - Controls:" << std::endl;
-  std::cout << "  WASD - Move" << std::endl;
-  std::cout << "  Mouse - Look around" << std::endl;
-  std::cout << "  T - Toggle camera view" << std::endl;
-  std::cout << "  R - Restart level" << std::endl;
-  std::cout << "  ESC - Quit" << std::endl;
+  // Create particle system (the stress level keeps its own load alive)
+  int maxParticles = 2000;
+  if (settings.stressLevel)
+    maxParticles = std::max(maxParticles, settings.stress.particles);
+  particles = std::make_unique<ParticleSystem>(maxParticles);
 
   return true;
 }
 
 void Game::run() {
+  if (!settings.flythroughPath.empty()) {
+    runFlythrough();
+    return;
+  }
+
+  // Allocation report (only active with CHRONO_TRACK_ALLOCATIONS)
+  const int warmupFrames = 120; // Ignore level loading and first-use caches
+  int frameCount = 0;
+  size_t reportAllocations = 0;
+  int reportFrames = 0;
+  float reportTimer = 0.0f;
+
+  // Stats report (--stats)
+  int statsFrames = 0;
+  float statsTimer = 0.0f;
+  uint64_t statsTicks = 0;
+
+  // Something to draw before the first tick finishes
+  lastTickTime = glfwGetTime();
+  publishSnapshot(lastTickTime, 0.0f);
+
+  std::cout << "Simulation tick rate: " << settings.tickRate << " Hz"
+            << std::endl;
+  if (settings.threadedSimulation) {
+    simThread = std::thread(&Game::simulationLoop, this);
+    std::cout << "Simulation running on its own thread" << std::endl;
+  }
+
+  // Menu frame cap (--menu-fps)
+  std::chrono::steady_clock::time_point nextMenuFrame =
+      std::chrono::steady_clock::now();
+
+  float lastFrame = glfwGetTime();
   while (!glfwWindowShouldClose(window)) {
-    // Calculate delta time
     float currentFrame = glfwGetTime();
-    deltaTime = currentFrame - lastFrame;
+    float frameTime = currentFrame - lastFrame;
     lastFrame = currentFrame;
 
-    processInput();
-    update();
-    render();
+    AllocationCounter::beginFrame();
+
+    InputFrame input = Input::getInstance().sample();
+    if (Input::getInstance().isKeyPressed(KEY_ESC)) {
+      glfwSetWindowShouldClose(window, true);
+    }
+
+    if (settings.threadedSimulation) {
+      // Kick the simulation. If it is still busy with the last frame, this
+      // frame's input is folded into the pending frame.
+      {
+        std::lock_guard<std::mutex> lock(simMutex);
+        if (!simBusy && pendingLevel != kNoLevelRequest) {
+          applyLevelRequest();
+        }
+        pendingInput.merge(input);
+        frameRequested = true;
+      }
+      simWake.notify_one();
+    } else {
+      advance(input);
+      if (pendingLevel != kNoLevelRequest) {
+        applyLevelRequest();
+      }
+    }
+
+    renderer.updateShaders();
+    GameState drawn = renderFrame();
 
     glfwSwapBuffers(window);
     glfwPollEvents();
+
+    // The menu screens animate fine at a low rate; sleeping instead of
+    // drawing them as fast as possible leaves the GPU (and battery) idle
+    bool menu = drawn == GameState::START_SCREEN ||
+                drawn == GameState::GAME_OVER || drawn == GameState::WIN;
+    if (menu && settings.menuFps > 0) {
+      nextMenuFrame += std::chrono::microseconds(1000000 / settings.menuFps);
+      std::chrono::steady_clock::time_point now =
+          std::chrono::steady_clock::now();
+      if (nextMenuFrame < now)
+        nextMenuFrame = now; // Fell behind (or just entered a menu)
+      else
+        std::this_thread::sleep_until(nextMenuFrame);
+    }
+
+    if (settings.showStats) {
+      statsFrames++;
+      statsTimer += frameTime;
+      if (statsTimer >= 2.0f) {
+        uint64_t ticks = ticksSimulated.load(std::memory_order_relaxed);
+        std::cout << "FPS: " << statsFrames / statsTimer << ", ticks per frame: "
+                  << (float)(ticks - statsTicks) / statsFrames << std::endl;
+        statsTicks = ticks;
+        statsFrames = 0;
+        statsTimer = 0.0f;
+      }
+    }
+
+    size_t frameAllocations = AllocationCounter::endFrame();
+    if (AllocationCounter::isEnabled() && ++frameCount > warmupFrames) {
+      reportAllocations += frameAllocations;
+      reportFrames++;
+      reportTimer += frameTime;
+      if (reportTimer >= 2.0f) {
+        std::cout << "Heap allocations per frame: "
+                  << (float)reportAllocations / reportFrames
+                  << " (frame scratch peak "
+                  << scratchPeakBytes.load(std::memory_order_relaxed) / 1024
+                  << " KB)" << std::endl;
+        reportAllocations = 0;
+        reportFrames = 0;
+        reportTimer = 0.0f;
+      }
+    }
+  }
+
+  stopSimulation();
+
+  if (!settings.recordPath.empty()) {
+    if (recordedPath.getKeyCount() < 2) {
+      std::cerr << "Camera path not saved: play a level to record one"
+                << std::endl;
+    } else if (recordedPath.save(settings.recordPath)) {
+      std::cout << "Saved " << recordedPath.getKeyCount()
+                << " camera keys to " << settings.recordPath << std::endl;
+    }
   }
 }
 
+void Game::runFlythrough() {
+  int levelIndex = settings.flythroughLevel - 1;
+  std::string pathFile = settings.cameraPath;
+  if (pathFile.empty())
+    pathFile = "levels/level" + std::to_string(levelIndex + 1) + ".path";
+
+  CameraPath path;
+  if (!path.load(pathFile))
+    return;
+
+  std::ofstream csv(settings.flythroughPath, std::ios::trunc);
+  if (!csv) {
+    std::cerr << "ERROR::FLYTHROUGH::CANNOT_WRITE " << settings.flythroughPath
+              << std::endl;
+    return;
+  }
+
+  loadLevel(levelIndex);
+  player->controlsEnabled = false;
+  if (window)
+    glfwSwapInterval(0); // Measure the frame, not the display
+
+  // Offscreen: draw into a framebuffer of the window's size and never swap
+  GLuint fbo = 0;
+  GLuint renderbuffers[2] = {0, 0};
+  int width = screenWidth;
+  int height = screenHeight;
+  if (settings.offscreen) {
+    width = settings.windowWidth;
+    height = settings.windowHeight;
+    glGenFramebuffers(1, &fbo);
+    glGenRenderbuffers(2, renderbuffers);
+    glBindRenderbuffer(GL_RENDERBUFFER, renderbuffers[0]);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, renderbuffers[1]);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                              GL_RENDERBUFFER, renderbuffers[0]);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT,
+                              GL_RENDERBUFFER, renderbuffers[1]);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+      std::cerr << "ERROR::FLYTHROUGH::FRAMEBUFFER_INCOMPLETE" << std::endl;
+    }
+    glViewport(0, 0, width, height);
+  }
+
+  // The path is spread over the frames, and the level simulated in step
+  // with it, so every run renders the same scenes whatever the frame rate
+  const int frameCount = settings.flythroughFrames;
+  const float frameStep = path.getDuration() / frameCount;
+  std::cout << "Flythrough: level " << levelIndex + 1 << ", " << pathFile
+            << " (" << path.getDuration() << " s), " << frameCount
+            << " frames" << (settings.offscreen ? " offscreen" : "")
+            << std::endl;
+
+  struct FrameRecord {
+    double cpuSeconds;
+    double gpuSeconds; // Negative until the timer query reports
+    RenderStats stats;
+  };
+  std::vector<FrameRecord> frames(frameCount);
+  std::vector<std::pair<uint64_t, double>> gpuTimes;
+  const uint64_t firstFrame = renderer.getFrameNumber();
+  renderer.setGpuTiming(true);
+
+  // --capture: frames read back through pixel buffers, written a few
+  // frames later so the readback never waits on the GPU
+  FrameCapture capture;
+  if (!settings.captureDir.empty()) {
+    std::error_code error;
+    std::filesystem::create_directories(settings.captureDir, error);
+    capture.init(width, height);
+  }
+
+  RenderSnapshot snapshot;
+  for (int i = 0; i < frameCount && !(window && glfwWindowShouldClose(window));
+       i++) {
+    auto start = std::chrono::steady_clock::now();
+
+    FrameAllocator::getInstance().reset();
+    float time = i * frameStep;
+    glm::vec3 eye, front;
+    path.sample(time, eye, front);
+    camera->setFreeView(eye, front);
+
+    float aspect = (float)width / height;
+    currentLevel->setActivityView(Frustum::fromMatrix(
+        camera->getProjectionMatrix(aspect) * camera->getViewMatrix()));
+    currentLevel->update(frameStep, player.get(), particles.get());
+    particles->update(frameStep);
+
+    snapshot.tick = i;
+    snapshot.publishTime = time;
+    snapshot.tickFraction = 0.0f;
+    snapshot.clear();
+    buildSnapshot(snapshot);
+    renderer.setSceneTime(time);
+    renderer.render(nullptr, snapshot, 1.0f, width, height, particles.get());
+
+    if (!settings.captureDir.empty() && i % settings.captureEvery == 0) {
+      char name[32];
+      std::snprintf(name, sizeof(name), "/frame_%05d.png", i);
+      capture.capture(settings.captureDir + name);
+    }
+
+    if (!settings.offscreen)
+      glfwSwapBuffers(window);
+    if (window)
+      glfwPollEvents();
+
+    frames[i].cpuSeconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+            .count();
+    frames[i].gpuSeconds = -1.0;
+    frames[i].stats = renderer.getLastStats();
+    renderer.collectGpuTimes(gpuTimes, false);
+    capture.poll(false);
+  }
+
+  glFinish();
+  renderer.collectGpuTimes(gpuTimes, true);
+  renderer.setGpuTiming(false);
+  renderer.setSceneTime(-1.0);
+  capture.poll(true);
+  capture.cleanup();
+  for (const auto &gpuTime : gpuTimes) {
+    uint64_t frame = gpuTime.first - firstFrame;
+    if (gpuTime.first >= firstFrame && frame < frames.size())
+      frames[frame].gpuSeconds = gpuTime.second;
+  }
+
+  if (fbo) {
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteRenderbuffers(2, renderbuffers);
+  }
+
+  // Per-frame rows, then the summary
+  std::vector<double> cpuMs, gpuMs, drawCalls, triangles, stateChanges;
+  csv << "frame,cpu_ms,gpu_ms,draw_calls,triangles,state_changes\n";
+  for (size_t i = 0; i < frames.size(); i++) {
+    const FrameRecord &frame = frames[i];
+    if (frame.cpuSeconds <= 0.0)
+      break; // Window closed early
+    csv << i << ',' << 1000.0 * frame.cpuSeconds << ',';
+    if (frame.gpuSeconds >= 0.0) {
+      csv << 1000.0 * frame.gpuSeconds;
+      gpuMs.push_back(1000.0 * frame.gpuSeconds);
+    }
+    csv << ',' << frame.stats.drawCalls << ',' << frame.stats.triangles << ','
+        << frame.stats.stateChanges << '\n';
+    cpuMs.push_back(1000.0 * frame.cpuSeconds);
+    drawCalls.push_back(frame.stats.drawCalls);
+    triangles.push_back((double)frame.stats.triangles);
+    stateChanges.push_back(frame.stats.stateChanges);
+  }
+
+  const char *names[] = {"cpu_ms", "gpu_ms", "draw_calls", "triangles",
+                         "state_changes"};
+  std::vector<double> *columns[] = {&cpuMs, &gpuMs, &drawCalls, &triangles,
+                                    &stateChanges};
+  std::string summaryPath = settings.flythroughPath + ".summary.csv";
+  std::ofstream summary(summaryPath, std::ios::trunc);
+  summary << "metric,mean,p95,p99\n";
+  std::printf("  %-14s %12s %12s %12s\n", "metric", "mean", "p95", "p99");
+  for (int i = 0; i < 5; i++) {
+    std::vector<double> &column = *columns[i];
+    std::sort(column.begin(), column.end());
+    double average = mean(column);
+    double p95 = percentile(column, 0.95);
+    double p99 = percentile(column, 0.99);
+    std::printf("  %-14s %12.3f %12.3f %12.3f\n", names[i], average, p95,
+                p99);
+    summary << names[i] << ',' << average << ',' << p95 << ',' << p99 << '\n';
+  }
+  std::cout << "Wrote " << cpuMs.size() << " frames to "
+            << settings.flythroughPath << " and " << summaryPath << std::endl;
+}
+
+void Game::simulationLoop() {
+  // This thread takes over index 0 of the JobSystem (and its CommandBuffer)
+  // from the main thread, which never schedules jobs while it runs
+  std::unique_lock<std::mutex> lock(simMutex);
+  while (true) {
+    simWake.wait(lock, [this] {
+      return simStopping ||
+             (frameRequested && pendingLevel == kNoLevelRequest);
+    });
+    if (simStopping)
+      return;
+
+    InputFrame input = pendingInput;
+    pendingInput = InputFrame();
+    frameRequested = false;
+    simBusy = true;
+    lock.unlock();
+
+    advance(input);
+
+    lock.lock();
+    simBusy = false;
+  }
+}
+
+void Game::stopSimulation() {
+  if (!simThread.joinable())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(simMutex);
+    simStopping = true;
+  }
+  simWake.notify_one();
+  simThread.join();
+}
+
+void Game::advance(const InputFrame &input) {
+  double now = glfwGetTime();
+  accumulator += now - lastTickTime;
+  lastTickTime = now;
+  if (accumulator > kMaxCatchUpTime)
+    accumulator = kMaxCatchUpTime;
+
+  // Input carries over until a tick consumes it
+  tickInput.merge(input);
+
+  while (accumulator >= fixedStep) {
+    accumulator -= fixedStep;
+
+    // Per-tick scratch memory from the last tick is no longer referenced
+    FrameAllocator::getInstance().reset();
+
+    simulate(tickInput, (float)fixedStep);
+    tickInput.clearEdges();
+    tickCount++;
+    ticksSimulated.fetch_add(1, std::memory_order_relaxed);
+
+    // The main thread loads the level and publishes a fresh snapshot
+    if (pendingLevel != kNoLevelRequest)
+      break;
+
+    // Only the last two ticks are ever drawn (interpolated between), so
+    // skip building snapshots for the rest of a catch-up burst
+    if (accumulator < 2.0 * fixedStep)
+      publishSnapshot(now, (float)(accumulator / fixedStep));
+  }
+
+  scratchPeakBytes.store(FrameAllocator::getInstance().peakBytes(),
+                         std::memory_order_relaxed);
+}
+
+void Game::publishSnapshot(double time, float tickFraction) {
+  RenderSnapshot &snapshot = snapshots.beginWrite();
+  snapshot.tick = tickCount;
+  snapshot.publishTime = time;
+  snapshot.tickFraction = tickFraction;
+  buildSnapshot(snapshot);
+  snapshots.publish();
+}
+
+void Game::applyLevelRequest() {
+  if (pendingLevel == kUnloadLevel) {
+    currentLevel = nullptr; // Leave the level (it stays cached)
+    currentLevelIndex = 0; // Reset to beginning
+  } else {
+    loadLevel(pendingLevel);
+  }
+  pendingLevel = kNoLevelRequest;
+
+  // Older snapshots may reference meshes of the level that was replaced
+  snapshots.reset();
+
+  // Loading time is not simulated time
+  lastTickTime = glfwGetTime();
+  accumulator = 0.0;
+  publishSnapshot(lastTickTime, 0.0f);
+}
+
+GameState Game::renderFrame() {
+  snapshots.acquire();
+  const RenderSnapshot *current = snapshots.getCurrent();
+  const RenderSnapshot *previous = snapshots.getPrevious();
+  if (!current)
+    return GameState::START_SCREEN;
+
+  // Draw the time between the previous and current tick that was left
+  // unsimulated, plus however long ago that tick was published (frames
+  // without a tick keep advancing smoothly)
+  float alpha = 1.0f;
+  if (previous) {
+    double elapsed = glfwGetTime() - current->publishTime;
+    alpha = current->tickFraction + (float)(elapsed / fixedStep);
+    alpha = std::min(std::max(alpha, 0.0f), 1.0f);
+  }
+
+  renderer.render(previous, *current, alpha, screenWidth, screenHeight,
+                  particles.get());
+  return current->state;
+}
+
 void Game::framebufferSizeCallback(GLFWwindow *window, int width, int height) {
   if (instance) {
     instance->screenWidth = width;
     instance->screenHeight = height;
+    if (height > 0) {
+      instance->viewAspect.store((float)width / height,
+                                 std::memory_order_relaxed);
+    }
     glViewport(0, 0, width, height);
   }
 }
 
-void Game::processInput() {
-  Input &input = Input::getInstance();
+void Game::simulate(const InputFrame &input, float dt) {
+  deltaTime = dt;
 
-  if (input.isKeyPressed(KEY_ESC)) {
-    glfwSetWindowShouldClose(window, true);
-  }
+  processInput(input);
+
+  // A level change was requested - the rest waits for the new level
+  if (pendingLevel != kNoLevelRequest)
+    return;
 
+  update(input);
+}
+
+void Game::processInput(const InputFrame &input) {
   // Handle start screen - any key starts the game
   if (gameState == GameState::START_SCREEN) {
-    if (anyKeyPressed()) {
-      loadLevel(0); // Start the game
+    if (input.anyKeyPressed) {
+      requestLevel(0); // Start the game
     }
     return; // Don't process other input on start screen
   }
@@ -145,20 +641,19 @@ void Game::processInput() {
   if (gameState == GameState::GAME_OVER) {
     gameOverTime += deltaTime;
     if (gameOverTime > 1.0f &&
-        anyKeyPressed()) { // 1 second delay before accepting input
+        input.anyKeyPressed) { // 1 second delay before accepting input
       // Reset the entire game
       player->resetHealth(); // Reset hearts to full
-      loadLevel(0);          // Restart from Level 1
+      requestLevel(0);       // Restart from Level 1
     }
     return; // Don't process other input on game over screen
   }
 
   // Handle win screen - any key goes back to start screen
   if (gameState == GameState::WIN) {
-    if (anyKeyPressed()) {
+    if (input.anyKeyPressed) {
       // Reset the entire game state
-      currentLevel.reset();  // Clear the current level
-      currentLevelIndex = 0; // Reset to beginning
+      requestLevel(kUnloadLevel); // Clear the current level
       gameState = GameState::START_SCREEN;
       AudioManager::getInstance().stopAllSounds(); // Stop win jingle
       startScreenTime = 0.0f;                      // Reset start screen timer
@@ -166,61 +661,56 @@ void Game::processInput() {
     return; // Don't process other input on win screen
   }
 
-  if (input.isKeyJustPressed(KEY_R)) {
+  if (input.restartPressed) {
     restartLevel();
   }
 
   // Camera toggle with T key or Right Mouse Button
-  if (input.isKeyJustPressed(KEY_T) ||
-      input.isMouseButtonJustPressed(MOUSE_BUTTON_RIGHT)) {
+  if (input.toggleCameraPressed) {
     camera->toggleMode();
   }
 
   // Camera rotation with Q and E keys
-  if (input.isKeyPressed(KEY_Q)) {
-    camera->processMouseMovement(-1.0f, 0.0f); // Rotate left
+  if (input.rotateLeft) {
+    camera->processMouseMovement(-kKeyTurnRate * deltaTime, 0.0f); // Left
   }
-  if (input.isKeyPressed(KEY_E)) {
-    camera->processMouseMovement(1.0f, 0.0f); // Rotate right
+  if (input.rotateRight) {
+    camera->processMouseMovement(kKeyTurnRate * deltaTime, 0.0f); // Right
   }
 
   // Mouse look
-  glm::vec2 mouseDelta = input.getMouseDelta();
-  if (glm::length(mouseDelta) > 0.01f) {
-    camera->processMouseMovement(mouseDelta.x, mouseDelta.y);
+  if (glm::length(input.mouseDelta) > 0.01f) {
+    camera->processMouseMovement(input.mouseDelta.x, input.mouseDelta.y);
   }
 
   // No need to manually warp pointer, GLFW handles it with GLFW_CURSOR_DISABLED
 }
 
-void Game::update() {
+void Game::update(const InputFrame &input) {
   // Update start screen timer
   if (gameState == GameState::START_SCREEN) {
     startScreenTime += deltaTime;
-    Input::getInstance().update();
     return;
   }
 
   // Update game over timer
   if (gameState == GameState::GAME_OVER) {
     gameOverTime += deltaTime;
-    Input::getInstance().update();
     return;
   }
 
   // Update win screen timer
   if (gameState == GameState::WIN) {
     winScreenTime += deltaTime;
-    Input::getInstance().update();
     return;
   }
 
   if (gameState == GameState::LEVEL1 || gameState == GameState::LEVEL2) {
     // Get movement input
-    glm::vec3 moveInput = getMovementInput();
+    glm::vec3 moveInput = getMovementInput(input);
 
     // Update player
-    player->update(deltaTime, moveInput);
+    player->update(deltaTime, moveInput, input.jumpPressed);
 
     // Update camera
     if (camera->mode == CameraMode::FIRST_PERSON) {
@@ -237,17 +727,30 @@ void Game::update() {
     }
     camera->updateCameraVectors();
 
+    if (!settings.recordPath.empty()) {
+      recordClock += deltaTime;
+      if (recordClock >= nextRecordTime) {
+        recordedPath.addKey((float)recordClock, camera->position,
+                            camera->position + camera->front * 10.0f);
+        nextRecordTime = recordClock + kRecordInterval;
+      }
+    }
+
     // Update player's camera yaw for model rotation
     player->setCameraYaw(camera->yaw);
 
     // Update level
     if (currentLevel) {
+      float aspect = viewAspect.load(std::memory_order_relaxed);
+      currentLevel->setActivityView(
+          Frustum::fromMatrix(camera->getProjectionMatrix(aspect) *
+                              camera->getViewMatrix()));
       currentLevel->update(deltaTime, player.get(), particles.get());
 
       // Check if should reset to Level 1 (e.g., 3 stalactite hits in Level 2)
       if (currentLevel->shouldResetToLevel1) {
         AudioManager::getInstance().playSound(SoundEffect::TILE_CRACK, 0.4f);
-        loadLevel(0); // Reset to Level 1
+        requestLevel(0); // Reset to Level 1
         return;
       }
 
@@ -267,6 +770,7 @@ void Game::update() {
       // Check level completion
       if (currentLevel->levelComplete) {
         nextLevel();
+        return;
       }
     }
 
@@ -291,253 +795,70 @@ void Game::update() {
       AudioManager::getInstance().playSound(SoundEffect::GAME_OVER, 1.5f);
     }
   }
-
-  // Clear mouse delta AFTER processing
-  Input::getInstance().clearMouseDelta();
-
-  // Update input state for next frame
-  Input::getInstance().update();
 }
 
-void Game::renderText(float x, float y, const std::string &text) {
-  // Text rendering is temporarily disabled during GLFW migration
-  // as GLUT bitmap fonts are not available.
-  // TODO: Implement FreeType or similar font rendering.
-}
+void Game::buildSnapshot(RenderSnapshot &snapshot) const {
+  snapshot.state = gameState;
 
-void Game::render() {
-  // Render start screen
-  if (gameState == GameState::START_SCREEN) {
-    renderStartScreen();
+  switch (gameState) {
+  case GameState::START_SCREEN:
+    snapshot.screenTime = startScreenTime;
     return;
-  }
-
-  // Render game over screen
-  if (gameState == GameState::GAME_OVER) {
-    renderGameOver();
+  case GameState::GAME_OVER:
+    snapshot.screenTime = gameOverTime;
     return;
-  }
-
-  // Render win screen
-  if (gameState == GameState::WIN) {
-    renderWinScreen();
+  case GameState::WIN:
+    snapshot.screenTime = winScreenTime;
+    return;
+  case GameState::LEVEL1:
+  case GameState::LEVEL2:
+    break;
+  default:
     return;
   }
 
-  // Normal sky blue background
-  glClearColor(0.1f, 0.1f, 0.15f, 1.0f);
-  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-  if (gameState == GameState::LEVEL1 || gameState == GameState::LEVEL2) {
-    // Set up main shader
-    mainShader->use();
-
-    // Initialize texture sampler to use texture unit 0
-    mainShader->setInt("textureSampler", 0);
-
-    glm::mat4 projection =
-        camera->getProjectionMatrix((float)screenWidth / screenHeight);
-    glm::mat4 view = camera->getViewMatrix();
-
-    mainShader->setMat4("projection", projection);
-    mainShader->setMat4("view", view);
-    mainShader->setVec3("viewPos", camera->position);
-    mainShader->setFloat("time", glfwGetTime());
-    mainShader->setFloat("transparency",
-                         1.0f); // Ensure normal objects are fully opaque
-
-    // Set lighting
-    if (currentLevel) {
-      currentLevel->drawLights(mainShader.get());
-    }
-
-    // Draw level
-    if (currentLevel) {
-      currentLevel->draw(mainShader.get());
-      currentLevel->drawLightFixtureModels(
-          mainShader.get()); // Draw the fractured orb models
-    }
+  snapshot.cameraPosition = camera->position;
+  snapshot.cameraFront = camera->front;
+  snapshot.cameraUp = camera->up;
+  snapshot.cameraFov = camera->fov;
+  snapshot.cameraMode = camera->mode;
 
-    // Draw player (only if in Third Person mode)
-    if (camera->mode == CameraMode::THIRD_PERSON) {
-      player->draw(mainShader.get());
-    }
-
-    // Draw particles
-    particleShader->use();
-    particleShader->setMat4("projection", projection);
-    particleShader->setMat4("view", view);
-    particles->draw(view, projection);
-
-    // Draw damage flash overlay (CoD style - thin edges with blood splatter
-    // lines)
-    if (player->damageFlashIntensity > 0.0f) {
-      glEnable(GL_BLEND);
-      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-      glDisable(GL_DEPTH_TEST); // Draw on top of everything
-
-      mainShader->use();
-      glm::mat4 identity = glm::mat4(1.0f);
-      mainShader->setMat4("projection", identity);
-      mainShader->setMat4("view", identity);
-      mainShader->setVec3("objectColor",
-                          glm::vec3(0.8f, 0.0f, 0.0f)); // Dark red
-      mainShader->setBool("useTexture", false);
-      mainShader->setFloat("emissive", 1.0f); // Make it glow (no lighting calc)
-      mainShader->setVec3("viewPos", glm::vec3(0, 0, 1)); // Dummy
-      mainShader->setInt("numLights", 0); // No lights for overlay
-
-      static std::unique_ptr<Mesh> flashQuad =
-          std::unique_ptr<Mesh>(Mesh::createCube(1.0f));
-
-      float alpha =
-          player->damageFlashIntensity * 0.35f; // More transparent (max 35%)
-      mainShader->setFloat("transparency", alpha);
-
-      float edgeWidth = 0.08f; // Thinner edges
-
-      // Left edge (main)
-      mainShader->setMat4(
-          "model",
-          glm::translate(identity, glm::vec3(-1.0f + edgeWidth, 0.0f, 0.0f)) *
-              glm::scale(identity, glm::vec3(edgeWidth * 2.0f, 2.0f, 0.01f)));
-      flashQuad->draw();
-
-      // Right edge (main)
-      mainShader->setMat4(
-          "model",
-          glm::translate(identity, glm::vec3(1.0f - edgeWidth, 0.0f, 0.0f)) *
-              glm::scale(identity, glm::vec3(edgeWidth * 2.0f, 2.0f, 0.01f)));
-      flashQuad->draw();
-
-      // Blood splatter lines - diagonal streaks from corners
-      float lineAlpha = alpha * 0.7f; // Slightly more transparent
-      mainShader->setFloat("transparency", lineAlpha);
-
-      // Top-left diagonal lines
-      for (int i = 0; i < 3; i++) {
-        float offset = i * 0.12f;
-        glm::mat4 lineModel = glm::translate(
-            identity, glm::vec3(-0.85f + offset, 0.75f - offset * 0.5f, 0.0f));
-        lineModel =
-            glm::rotate(lineModel, glm::radians(-45.0f), glm::vec3(0, 0, 1));
-        lineModel =
-            glm::scale(lineModel, glm::vec3(0.25f - i * 0.05f, 0.015f, 0.01f));
-        mainShader->setMat4("model", lineModel);
-        flashQuad->draw();
-      }
-
-      // Top-right diagonal lines
-      for (int i = 0; i < 3; i++) {
-        float offset = i * 0.12f;
-        glm::mat4 lineModel = glm::translate(
-            identity, glm::vec3(0.85f - offset, 0.75f - offset * 0.5f, 0.0f));
-        lineModel =
-            glm::rotate(lineModel, glm::radians(45.0f), glm::vec3(0, 0, 1));
-        lineModel =
-            glm::scale(lineModel, glm::vec3(0.25f - i * 0.05f, 0.015f, 0.01f));
-        mainShader->setMat4("model", lineModel);
-        flashQuad->draw();
-      }
-
-      // Bottom-left diagonal lines
-      for (int i = 0; i < 2; i++) {
-        float offset = i * 0.15f;
-        glm::mat4 lineModel = glm::translate(
-            identity, glm::vec3(-0.8f + offset, -0.7f + offset * 0.4f, 0.0f));
-        lineModel =
-            glm::rotate(lineModel, glm::radians(35.0f), glm::vec3(0, 0, 1));
-        lineModel =
-            glm::scale(lineModel, glm::vec3(0.2f - i * 0.04f, 0.012f, 0.01f));
-        mainShader->setMat4("model", lineModel);
-        flashQuad->draw();
-      }
-
-      // Bottom-right diagonal lines
-      for (int i = 0; i < 2; i++) {
-        float offset = i * 0.15f;
-        glm::mat4 lineModel = glm::translate(
-            identity, glm::vec3(0.8f - offset, -0.7f + offset * 0.4f, 0.0f));
-        lineModel =
-            glm::rotate(lineModel, glm::radians(-35.0f), glm::vec3(0, 0, 1));
-        lineModel =
-            glm::scale(lineModel, glm::vec3(0.2f - i * 0.04f, 0.012f, 0.01f));
-        mainShader->setMat4("model", lineModel);
-        flashQuad->draw();
-      }
-
-      // Restore state
-      glEnable(GL_DEPTH_TEST);
-      mainShader->setFloat("emissive", 0.0f);
-      mainShader->setFloat("transparency", 1.0f);
-    }
+  // Lights and level geometry
+  if (currentLevel) {
+    currentLevel->drawLights(snapshot);
+    currentLevel->draw(snapshot);
+    currentLevel->drawLightFixtureModels(snapshot); // The fractured orb models
+  }
 
-    // Render hearts UI
-    renderHearts();
+  // Draw player (only if in Third Person mode)
+  if (camera->mode == CameraMode::THIRD_PERSON) {
+    player->draw(snapshot);
   }
-}
 
-void Game::renderHearts() {
-  mainShader->use();
-
-  // Set up orthographic-like projection for UI rendering
-  glm::mat4 identity = glm::mat4(1.0f);
-  mainShader->setMat4("projection", identity);
-  mainShader->setMat4("view", identity);
-  mainShader->setBool("useTexture", false);
-  mainShader->setFloat("transparency", 1.0f);
-  mainShader->setVec3("viewPos", glm::vec3(0, 0, 1));
-  mainShader->setInt("numLights", 0);
-
-  glDisable(GL_DEPTH_TEST); // Draw on top
-  glDisable(GL_CULL_FACE);  // Hearts are 2D, render both sides
-
-  // Create a heart mesh for UI (static)
-  static std::unique_ptr<Mesh> heartMesh =
-      std::unique_ptr<Mesh>(Mesh::createHeart(1.0f));
-
-  // Draw hearts in top-right corner - MUCH BIGGER
-  float heartSize = 0.05f; // MUCH bigger hearts
-  float startX = 0.35f;    // Start position
-  float startY = 0.80f;    // Position from top
-  float spacing = 0.15f;   // Spacing between hearts
-
-  // Draw max hearts (4) - grey for lost hearts, red for current hearts
-  for (int i = 0; i < player->maxHearts; i++) {
-    float xPos = startX + i * spacing;
-    float yPos = startY;
-
-    glm::mat4 model = glm::translate(identity, glm::vec3(xPos, yPos, 0.0f));
-    model = glm::scale(model, glm::vec3(heartSize, heartSize, 1.0f));
-
-    if (i < player->getHearts()) {
-      // Full heart - bright red with strong glow
-      mainShader->setVec3("objectColor", glm::vec3(1.0f, 0.0f, 0.1f));
-      mainShader->setFloat("emissive", 1.0f);
-    } else {
-      // Empty heart - dark outline
-      mainShader->setVec3("objectColor", glm::vec3(0.3f, 0.15f, 0.15f));
-      mainShader->setFloat("emissive", 0.1f);
-    }
+  const Particle *live = particles->getParticles();
+  snapshot.particles.assign(live, live + particles->getParticleCount());
 
-    mainShader->setMat4("model", model);
-    heartMesh->draw();
-  }
+  // UI
+  snapshot.damageFlash = player->damageFlashIntensity;
+  snapshot.hearts = player->getHearts();
+  snapshot.maxHearts = player->maxHearts;
+}
 
-  glEnable(GL_DEPTH_TEST);
-  glEnable(GL_CULL_FACE);
-  mainShader->setFloat("emissive", 0.0f);
+void Game::renderText(float x, float y, const std::string &text) {
+  // Text rendering is temporarily disabled during GLFW migration
+  // as GLUT bitmap fonts are not available.
+  // TODO: Implement FreeType or similar font rendering.
 }
 
+void Game::requestLevel(int levelIndex) { pendingLevel = levelIndex; }
+
 void Game::loadLevel(int levelIndex) {
   currentLevelIndex = levelIndex;
 
   if (levelIndex == 0) {
-    currentLevel = std::make_unique<Level1>();
     gameState = GameState::LEVEL1;
     player->resetHealth(); // Reset hearts when starting Level 1
   } else if (levelIndex == 1) {
-    currentLevel = std::make_unique<Level2>();
     gameState = GameState::LEVEL2;
     player->resetHealth(); // Reset hearts when entering Level 2
   } else {
@@ -549,7 +870,29 @@ void Game::loadLevel(int levelIndex) {
     return;
   }
 
-  currentLevel->init();
+  std::unique_ptr<Level> &level = levels[levelIndex];
+  if (level) {
+    // Built before - put it back the way init() left it, keeping all of its
+    // models, textures and GL buffers
+    level->restoreInitialState();
+  } else {
+    const char *name;
+    if (levelIndex == 0 && settings.stressLevel) {
+      level = std::make_unique<StressLevel>(settings.stress);
+      name = "Stress level";
+    } else if (levelIndex == 0) {
+      level = std::make_unique<Level1>();
+      name = "Level 1";
+    } else {
+      level = std::make_unique<Level2>();
+      name = "Level 2";
+    }
+    level->init();
+    level->captureInitialState();
+    level->printMemoryReport(name);
+  }
+  currentLevel = level.get();
+
   player->reset(currentLevel->playerStartPosition); // Fully reset player state
   particles->clear();
 }
@@ -557,18 +900,17 @@ void Game::loadLevel(int levelIndex) {
 void Game::restartLevel() {
   // Play restart sound
   AudioManager::getInstance().playSound(SoundEffect::TILE_CRACK, 0.4f);
-  loadLevel(currentLevelIndex);
+  requestLevel(currentLevelIndex);
 }
 
 void Game::nextLevel() {
   // Play level complete sound
   AudioManager::getInstance().playSound(SoundEffect::LEVEL_COMPLETE, 1.0f);
 
-  loadLevel(currentLevelIndex + 1);
+  requestLevel(currentLevelIndex + 1);
 }
 
-glm::vec3 Game::getMovementInput() {
-  Input &input = Input::getInstance();
+glm::vec3 Game::getMovementInput(const InputFrame &input) const {
   glm::vec3 moveInput(0.0f);
 
   // Get camera direction vectors (flattened to XZ plane)
@@ -584,16 +926,16 @@ glm::vec3 Game::getMovementInput() {
     right = glm::normalize(right);
   }
 
-  if (input.isKeyPressed(KEY_W)) {
+  if (input.moveForward) {
     moveInput += forward;
   }
-  if (input.isKeyPressed(KEY_S)) {
+  if (input.moveBack) {
     moveInput -= forward;
   }
-  if (input.isKeyPressed(KEY_A)) {
+  if (input.moveLeft) {
     moveInput -= right;
   }
-  if (input.isKeyPressed(KEY_D)) {
+  if (input.moveRight) {
     moveInput += right;
   }
 
@@ -605,113 +947,19 @@ glm::vec3 Game::getMovementInput() {
   return moveInput;
 }
 
-void Game::initStartScreen() {
-  // Create a fullscreen quad for the start screen
-  float quadVertices[] = {// positions   // texCoords
-                          -1.0f, 1.0f, 0.0f, 1.0f,  -1.0f, -1.0f,
-                          0.0f,  0.0f, 1.0f, -1.0f, 1.0f,  0.0f,
-
-                          -1.0f, 1.0f, 0.0f, 1.0f,  1.0f,  -1.0f,
-                          1.0f,  0.0f, 1.0f, 1.0f,  1.0f,  1.0f};
-
-  glGenVertexArrays(1, &startScreenVAO);
-  glGenBuffers(1, &startScreenVBO);
-
-  glBindVertexArray(startScreenVAO);
-  glBindBuffer(GL_ARRAY_BUFFER, startScreenVBO);
-  glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices,
-               GL_STATIC_DRAW);
-
-  // Position attribute
-  glEnableVertexAttribArray(0);
-  glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void *)0);
-  // TexCoord attribute
-  glEnableVertexAttribArray(1);
-  glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float),
-                        (void *)(2 * sizeof(float)));
-
-  glBindVertexArray(0);
-}
-
-void Game::renderStartScreen() {
-  glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-  glDisable(GL_DEPTH_TEST);
-
-  startScreenShader->use();
-  startScreenShader->setFloat("time", startScreenTime);
-
-  glBindVertexArray(startScreenVAO);
-  glDrawArrays(GL_TRIANGLES, 0, 6);
-  glBindVertexArray(0);
-
-  glEnable(GL_DEPTH_TEST);
-}
-
-void Game::renderGameOver() {
-  glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-  glDisable(GL_DEPTH_TEST);
-
-  gameOverShader->use();
-  gameOverShader->setFloat("time", gameOverTime);
-
-  // Reuse the same VAO as start screen (fullscreen quad)
-  glBindVertexArray(startScreenVAO);
-  glDrawArrays(GL_TRIANGLES, 0, 6);
-  glBindVertexArray(0);
-
-  glEnable(GL_DEPTH_TEST);
-}
-
-void Game::renderWinScreen() {
-  glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-  glDisable(GL_DEPTH_TEST);
-
-  winScreenShader->use();
-  winScreenShader->setFloat("time", winScreenTime);
-
-  // Reuse the same VAO as start screen (fullscreen quad)
-  glBindVertexArray(startScreenVAO);
-  glDrawArrays(GL_TRIANGLES, 0, 6);
-  glBindVertexArray(0);
-
-  glEnable(GL_DEPTH_TEST);
-}
-
-bool Game::anyKeyPressed() {
-  // Check for any key press (except ESC which quits)
-  for (int key = GLFW_KEY_SPACE; key <= GLFW_KEY_LAST; key++) {
-    if (key == GLFW_KEY_ESCAPE)
-      continue;
-    if (glfwGetKey(window, key) == GLFW_PRESS) {
-      return true;
-    }
-  }
-
-  // Also check for mouse button press
-  for (int button = 0; button < 3; button++) {
-    if (glfwGetMouseButton(window, button) == GLFW_PRESS) {
-      return true;
-    }
-  }
-
-  return false;
-}
-
 void Game::cleanup() {
-  // Clean up start screen resources
-  if (startScreenVAO) {
-    glDeleteVertexArrays(1, &startScreenVAO);
-  }
-  if (startScreenVBO) {
-    glDeleteBuffers(1, &startScreenVBO);
+  // The simulation thread must be gone before anything it touches is freed
+  stopSimulation();
+
+  // Shaders, overlay meshes and levels own GL objects, release them while
+  // the context is alive
+  renderer.cleanup();
+  currentLevel = nullptr;
+  for (auto &level : levels) {
+    level.reset();
   }
 
   AudioManager::getInstance().cleanup();
+  headlessContext.destroy();
   glfwTerminate();
 }
@@ -1,12 +1,13 @@
 #include "GameObject.h"
 #include "AudioManager.h"
 #include "ModelCache.h"
-#include "Shader.h"
+#include "RenderSnapshot.h"
 #include <cmath>
+#include <iostream>
 
 GameObject::GameObject(GameObjectType t)
     : type(t), color(1.0f), transparency(1.0f), emissive(0.0f), materialType(0),
-      texture(nullptr), isActive(true), isTrigger(false),
+      texture(nullptr), isActive(true), isTrigger(false), isRotated(false),
       useSphereCollision(false) {}
 
 void GameObject::loadModel(const std::string &path) {
@@ -26,7 +27,7 @@ void GameObject::loadCachedModel(const std::string &path) {
   }
 }
 
-void GameObject::draw(Shader *shader) {
+void GameObject::draw(RenderSnapshot &snapshot) const {
   if (!isActive)
     return;
 
@@ -34,44 +35,18 @@ void GameObject::draw(Shader *shader) {
   if (!mesh && !model && !sharedModel)
     return;
 
-  glm::mat4 modelMat = transform.getModelMatrix();
-  shader->setMat4("model", modelMat);
-
-  // Calculate normal matrix for correct lighting with non-uniform scaling
-  glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(modelMat)));
-  shader->setMat3("normalMatrix", normalMatrix);
-  shader->setVec3("objectColor", color);
-  shader->setFloat("transparency", transparency);
-  shader->setFloat("emissive", emissive); // For glowing objects like lights
-  shader->setInt("materialType", materialType); // Pass material type
-
-  // Use texture if available
-  if (texture) {
-    texture->bind(0);
-    shader->setBool("useTexture", true);
-    shader->setInt("textureSampler", 0); // Texture is bound to slot 0
-  } else {
-    shader->setBool("useTexture", false);
-  }
-
-  shader->setFloat("shininess", 32.0f);
+  RenderInstance &instance = snapshot.addInstance(this, transform, color);
+  instance.transparency = transparency;
+  instance.emissive = emissive; // For glowing objects like lights
+  instance.materialType = materialType;
+  instance.texture = texture;
 
   // Draw model (owned or shared) or mesh
-  if (model) {
-    glDisable(GL_CULL_FACE); // Many models need this
-    model->draw(shader);
-    glEnable(GL_CULL_FACE);
-  } else if (sharedModel) {
-    glDisable(GL_CULL_FACE);
-    sharedModel->draw(shader);
-    glEnable(GL_CULL_FACE);
-  } else if (mesh) {
-    mesh->draw();
-  }
-
-  // Unbind texture
-  if (texture) {
-    texture->unbind();
+  if (model || sharedModel) {
+    instance.model = model ? model.get() : sharedModel.get();
+    instance.doubleSided = true; // Many models need this
+  } else {
+    instance.mesh = mesh.get();
   }
 }
 
@@ -79,9 +54,51 @@ void GameObject::update(float deltaTime) {
   // Base update does nothing by default
 }
 
+void GameObject::saveState(StateBuffer &state) const {
+  state.write(transform);
+  state.write(color);
+  state.write(transparency);
+  state.write(emissive);
+  state.write(materialType);
+  state.write(texture);
+  state.write(isActive);
+  state.write(isTrigger);
+  state.write(boundingBox);
+  state.write(orientedBox);
+  state.write(isRotated);
+  state.write(boundingSphere);
+  state.write(useSphereCollision);
+}
+
+void GameObject::restoreState(StateBuffer &state) {
+  state.read(transform);
+  state.read(color);
+  state.read(transparency);
+  state.read(emissive);
+  state.read(materialType);
+  state.read(texture);
+  state.read(isActive);
+  state.read(isTrigger);
+  state.read(boundingBox);
+  state.read(orientedBox);
+  state.read(isRotated);
+  state.read(boundingSphere);
+  state.read(useSphereCollision);
+}
+
 void GameObject::updateBoundingBox() {
   glm::vec3 size = transform.scale;
-  boundingBox = Physics::createAABBFromTransform(transform.position, size);
+  orientedBox = Physics::createOBBFromTransform(transform.position,
+                                                transform.rotation, size);
+
+  // Axis-aligned objects keep the exact box; rotated ones get the box that
+  // encloses their oriented box (used by the broadphase)
+  isRotated = std::abs(transform.rotation.w) < 0.99999f;
+  if (isRotated) {
+    boundingBox = orientedBox.getBounds();
+  } else {
+    boundingBox = Physics::createAABBFromTransform(transform.position, size);
+  }
 }
 
 void GameObject::updateBoundingSphere(float radius) {
@@ -89,36 +106,6 @@ void GameObject::updateBoundingSphere(float radius) {
       Physics::createSphereFromTransform(transform.position, radius);
 }
 
-// Pendulum Implementation
-Pendulum::Pendulum(const glm::vec3 &pivot, float len)
-    : GameObject(GameObjectType::PENDULUM), pivotPoint(pivot), length(len),
-      swingAngle(0.0f), swingSpeed(2.0f), maxAngle(45.0f) {
-
-  mesh.reset(Mesh::createCube(1.0f));
-  color = glm::vec3(0.15f, 0.15f, 0.18f); // Dark metallic finish
-  transform.scale = glm::vec3(0.3f, 2.0f, 1.5f);
-
-  useSphereCollision = false;
-}
-
-void Pendulum::update(float deltaTime) {
-  swingAngle += swingSpeed * deltaTime;
-
-  float angle = sin(swingAngle) * glm::radians(maxAngle);
-
-  // Calculate pendulum position
-  transform.position.x = pivotPoint.x + sin(angle) * length;
-  transform.position.y = pivotPoint.y - cos(angle) * length;
-  transform.position.z = pivotPoint.z;
-
-  // Rotate the blade
-  transform.setRotation(glm::vec3(0.0f, 0.0f, angle));
-
-  updateBoundingBox();
-}
-
-void Pendulum::draw(Shader *shader) { GameObject::draw(shader); }
-
 // Crumbling Tile Implementation
 CrumblingTile::CrumblingTile(const glm::vec3 &position)
     : GameObject(GameObjectType::CRUMBLING_TILE), isTriggered(false),
@@ -171,98 +158,22 @@ void CrumblingTile::onTrigger() {
   }
 }
 
-// Stalactite// Falling Stalactite
-Stalactite::Stalactite(const glm::vec3 &position)
-    : GameObject(GameObjectType::STALACTITE), isFalling(false),
-      fallSpeed(0.0f) {
-
-  transform.position = position;
-  originalPosition = position;
-  transform.scale =
-      glm::vec3(1.0f, 1.0f, 1.0f); // Scale handled by cone dimensions
-  transform.rotation =
-      glm::vec3(glm::radians(180.0f), 0.0f, 0.0f); // Point down
-
-  // Create cone: radius 0.6 (1.5x), height 3.75 (1.5x)
-  mesh.reset(Mesh::createCone(0.6f, 3.75f, 16));
-  color = glm::vec3(0.4f, 0.35f, 0.3f); // Brown rock
-
-  // Random fall timer (between 2-8 seconds)
-  fallTimer = 2.0f + (rand() % 600) / 100.0f;
-
-  updateBoundingSphere(0.8f); // Larger hitbox
-  useSphereCollision = true;
-}
-
-void Stalactite::update(float deltaTime) {
-  if (!isFalling) {
-    // Count down to random fall
-    fallTimer -= deltaTime;
-    if (fallTimer <= 0.0f) {
-      isFalling = true;
-    }
-    return;
-  }
-
-  fallSpeed += 12.0f * deltaTime; // Gravity (slower fall for dramatic effect)
-  transform.position.y -= fallSpeed * deltaTime;
-
-  // Reset if it falls below the map (instead of deactivating)
-  if (transform.position.y < -10.0f) {
-    isFalling = false;
-    transform.position = originalPosition;
-    fallSpeed = 0.0f;
-    fallTimer = 2.0f + (rand() % 600) / 100.0f; // Random delay for next fall
-  }
-
-  updateBoundingSphere(0.6f); // Larger hitbox when falling
-}
-
-void Stalactite::onTrigger() {
-  if (!isFalling) {
-    isFalling = true;
-  }
-}
-
-// Geyser Implementation
-Geyser::Geyser(const glm::vec3 &position)
-    : GameObject(GameObjectType::GEYSER), eruptTimer(0.0f), eruptDuration(2.0f),
-      eruptInterval(2.5f), isErupting(false) {
-
-  transform.position = position;
-  transform.scale = glm::vec3(1.2f, 0.15f, 1.2f); // Reduced by half
-
-  mesh.reset(Mesh::createCylinder(1.5f, 0.15f,
-                                  16)); // Much larger radius for bigger hitbox
-  color = glm::vec3(0.45f, 0.35f, 0.25f); // Brighter visible brown/orange
-
-  pushForce = glm::vec3(0.0f, 15.0f, 0.0f);
-
-  isTrigger = true;
-  updateBoundingBox();
+void CrumblingTile::saveState(StateBuffer &state) const {
+  GameObject::saveState(state);
+  state.write(isTriggered);
+  state.write(shakeTimer);
+  state.write(fallTimer);
+  state.write(originalPosition);
+  state.write(hasFallen);
 }
 
-void Geyser::update(float deltaTime) {
-  eruptTimer += deltaTime;
-
-  if (!isErupting && eruptTimer >= eruptInterval) {
-    isErupting = true;
-    eruptTimer = 0.0f;
-  } else if (isErupting && eruptTimer >= eruptDuration) {
-    isErupting = false;
-    eruptTimer = 0.0f;
-  }
-}
-
-void Geyser::draw(Shader *shader) {
-  GameObject::draw(shader);
-
-  // Visual indicator when erupting - make geyser glow
-  if (isErupting) {
-    shader->setVec3("objectColor",
-                    glm::vec3(0.5f, 0.4f, 0.3f)); // Lighter when erupting
-    shader->setFloat("shininess", 64.0f);         // More shiny
-  }
+void CrumblingTile::restoreState(StateBuffer &state) {
+  GameObject::restoreState(state);
+  state.read(isTriggered);
+  state.read(shakeTimer);
+  state.read(fallTimer);
+  state.read(originalPosition);
+  state.read(hasFallen);
 }
 
 // Collectible Implementation
@@ -301,10 +212,13 @@ void Collectible::update(float deltaTime) {
       isActive = false;
     }
   } else {
-    // Float and rotate
-    floatOffset += floatSpeed * deltaTime;
-    float yOffset = sin(floatOffset) * 0.2f;
-    transform.position.y += yOffset * deltaTime;
+    // Float and rotate. The bob height is a function of the phase and only
+    // its change is applied, so the bob no longer drifts, and anything that
+    // repositions the collectible is still respected.
+    float previousBob = getBobHeight();
+    floatOffset = std::fmod(floatOffset + floatSpeed * deltaTime,
+                            glm::radians(360.0f));
+    transform.position.y += getBobHeight() - previousBob;
 
     transform.rotate(deltaTime * rotationSpeed, glm::vec3(0.0f, 1.0f, 0.0f));
 
@@ -322,35 +236,28 @@ void Collectible::update(float deltaTime) {
       1.2f * transform.scale.x); // Much larger hitbox for reliable collection
 }
 
-void Collectible::draw(Shader *shader) {
+float Collectible::getBobHeight() const {
+  // Integral of the old 0.2 * sin(phase) bob velocity
+  return -0.2f * cos(floatOffset) / floatSpeed;
+}
+
+void Collectible::draw(RenderSnapshot &snapshot) const {
   if (!isActive)
     return;
+  if (!model && !mesh)
+    return;
 
-  glm::mat4 modelMat = transform.getModelMatrix();
-  shader->setMat4("model", modelMat);
-
-  // Calculate normal matrix for proper lighting
-  glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(modelMat)));
-  shader->setMat3("normalMatrix", normalMatrix);
-
-  shader->setVec3("objectColor", color);
-  shader->setBool("useTexture", false);
-  shader->setFloat("transparency", 1.0f);
-  shader->setInt("materialType", 0);
-  shader->setFloat("shininess", 256.0f); // EXTRA SHINY for glow
-  shader->setFloat("emissive", 0.0f);    // Reset emissive by default
+  RenderInstance &instance = snapshot.addInstance(this, transform, color);
+  instance.shininess = 256.0f; // EXTRA SHINY for glow
 
   if (model) {
     // Draw external model
     // Disable culling as some models might be inside out or single sided
-    glDisable(GL_CULL_FACE);
-    model->draw(shader);
-    glEnable(GL_CULL_FACE);
+    instance.model = model.get();
+    instance.doubleSided = true;
   } else {
     // Draw procedural mesh
-    if (mesh) {
-      mesh->draw();
-    }
+    instance.mesh = mesh.get();
   }
 }
 
@@ -365,6 +272,30 @@ void Collectible::collect() {
   }
 }
 
+void Collectible::saveState(StateBuffer &state) const {
+  GameObject::saveState(state);
+  state.write(rotationSpeed);
+  state.write(floatOffset);
+  state.write(floatSpeed);
+  state.write(isCollected);
+  state.write(collectAnimation);
+  state.write(initialScale);
+  state.write(shrinkSpeed);
+  state.write(soundType);
+}
+
+void Collectible::restoreState(StateBuffer &state) {
+  GameObject::restoreState(state);
+  state.read(rotationSpeed);
+  state.read(floatOffset);
+  state.read(floatSpeed);
+  state.read(isCollected);
+  state.read(collectAnimation);
+  state.read(initialScale);
+  state.read(shrinkSpeed);
+  state.read(soundType);
+}
+
 // HealthPickup Implementation
 HealthPickup::HealthPickup(const glm::vec3 &position)
     : GameObject(GameObjectType::HEALTH_PICKUP), rotationSpeed(1.5f),
@@ -400,25 +331,17 @@ void HealthPickup::update(float deltaTime) {
   boundingSphere.center = transform.position;
 }
 
-void HealthPickup::draw(Shader *shader) {
-  if (!isActive || isCollected)
+void HealthPickup::draw(RenderSnapshot &snapshot) const {
+  if (!isActive || isCollected || !model)
     return;
 
-  shader->setMat4("model", transform.getModelMatrix());
-  shader->setVec3("objectColor", color);
+  RenderInstance &instance = snapshot.addInstance(this, transform, color);
+  instance.model = model.get();
+  instance.doubleSided = true;
 
   // Pulsing glow effect
   float pulse = (sin(floatOffset * 2.0f) + 1.0f) * 0.5f; // 0 to 1
-  float emissive = 0.4f + pulse * 0.6f;                  // 0.4 to 1.0
-  shader->setFloat("emissive", emissive);
-
-  if (model) {
-    glDisable(GL_CULL_FACE);
-    model->draw(shader);
-    glEnable(GL_CULL_FACE);
-  }
-
-  shader->setFloat("emissive", 0.0f);
+  instance.emissive = 0.4f + pulse * 0.6f;               // 0.4 to 1.0
 }
 
 void HealthPickup::collect() {
@@ -429,3 +352,21 @@ void HealthPickup::collect() {
                                           0.9f);
   }
 }
+
+void HealthPickup::saveState(StateBuffer &state) const {
+  GameObject::saveState(state);
+  state.write(rotationSpeed);
+  state.write(floatOffset);
+  state.write(floatSpeed);
+  state.write(isCollected);
+  state.write(basePosition);
+}
+
+void HealthPickup::restoreState(StateBuffer &state) {
+  GameObject::restoreState(state);
+  state.read(rotationSpeed);
+  state.read(floatOffset);
+  state.read(floatSpeed);
+  state.read(isCollected);
+  state.read(basePosition);
+}
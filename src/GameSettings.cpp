@@ -0,0 +1,199 @@
+#include "GameSettings.h"
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <iostream>
+
+namespace {
+// "W,P,S,G,L,PARTICLES" - missing trailing fields keep their defaults
+bool parseStressCounts(const char *text, StressLevelConfig &config) {
+  int *fields[] = {&config.walls,   &config.pendulums, &config.stalactites,
+                   &config.geysers, &config.lights,    &config.particles};
+  const char *cursor = text;
+  for (int *field : fields) {
+    char *end;
+    long value = std::strtol(cursor, &end, 10);
+    if (end == cursor || value < 0)
+      return false;
+    *field = static_cast<int>(value);
+    if (*end == '\0')
+      return true;
+    if (*end != ',')
+      return false;
+    cursor = end + 1;
+  }
+  return false; // Too many fields
+}
+} // namespace
+
+StressLevelConfig StressLevelConfig::scaled(float factor) const {
+  StressLevelConfig config = *this;
+  int *fields[] = {&config.walls,   &config.pendulums, &config.stalactites,
+                   &config.geysers, &config.lights,    &config.particles};
+  for (int *field : fields) {
+    *field = std::max(1, static_cast<int>(*field * factor));
+  }
+  return config;
+}
+
+GameSettings GameSettings::fromArgs(int argc, char **argv) {
+  GameSettings settings;
+
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    bool hasValue = i + 1 < argc;
+
+    if (std::strcmp(arg, "--single-threaded") == 0) {
+      settings.threadedSimulation = false;
+    } else if (std::strcmp(arg, "--width") == 0 && hasValue) {
+      settings.windowWidth = std::atoi(argv[++i]);
+    } else if (std::strcmp(arg, "--height") == 0 && hasValue) {
+      settings.windowHeight = std::atoi(argv[++i]);
+    } else if (std::strcmp(arg, "--tick-rate") == 0 && hasValue) {
+      settings.tickRate = std::atoi(argv[++i]);
+    } else if (std::strcmp(arg, "--stats") == 0) {
+      settings.showStats = true;
+    } else if (std::strcmp(arg, "--hot-reload") == 0) {
+      settings.hotReload = true;
+    } else if (std::strcmp(arg, "--menu-scale") == 0 && hasValue) {
+      settings.menuScale = (float)std::atof(argv[++i]);
+    } else if (std::strcmp(arg, "--menu-fps") == 0 && hasValue) {
+      settings.menuFps = std::max(0, std::atoi(argv[++i]));
+    } else if (std::strcmp(arg, "--stress") == 0) {
+      settings.stressLevel = true;
+    } else if (std::strcmp(arg, "--stress-counts") == 0 && hasValue) {
+      if (!parseStressCounts(argv[++i], settings.stress)) {
+        std::cerr << "Invalid --stress-counts: " << argv[i] << std::endl;
+        settings.showHelp = true;
+      }
+    } else if (std::strcmp(arg, "--seed") == 0 && hasValue) {
+      settings.stress.seed = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+    } else if (std::strcmp(arg, "--stress-benchmark") == 0 && hasValue) {
+      settings.stressBenchmarkPath = argv[++i];
+    } else if (std::strcmp(arg, "--benchmark-ticks") == 0 && hasValue) {
+      settings.benchmarkTicks = std::max(1, std::atoi(argv[++i]));
+    } else if (std::strcmp(arg, "--flythrough") == 0 && hasValue) {
+      settings.flythroughPath = argv[++i];
+    } else if (std::strcmp(arg, "--camera-path") == 0 && hasValue) {
+      settings.cameraPath = argv[++i];
+    } else if (std::strcmp(arg, "--level") == 0 && hasValue) {
+      settings.flythroughLevel = std::atoi(argv[++i]);
+    } else if (std::strcmp(arg, "--frames") == 0 && hasValue) {
+      settings.flythroughFrames = std::max(1, std::atoi(argv[++i]));
+    } else if (std::strcmp(arg, "--offscreen") == 0) {
+      settings.offscreen = true;
+    } else if (std::strcmp(arg, "--record-path") == 0 && hasValue) {
+      settings.recordPath = argv[++i];
+    } else if (std::strcmp(arg, "--headless") == 0) {
+      settings.headless = true;
+    } else if (std::strcmp(arg, "--capture") == 0 && hasValue) {
+      settings.captureDir = argv[++i];
+    } else if (std::strcmp(arg, "--capture-every") == 0 && hasValue) {
+      settings.captureEvery = std::max(1, std::atoi(argv[++i]));
+    } else if (std::strcmp(arg, "--help") == 0 ||
+               std::strcmp(arg, "-h") == 0) {
+      settings.showHelp = true;
+    } else {
+      std::cerr << "Unknown option: " << arg << std::endl;
+      settings.showHelp = true;
+    }
+  }
+
+  if (settings.windowWidth <= 0 || settings.windowHeight <= 0) {
+    std::cerr << "Invalid window size, using 1280x720" << std::endl;
+    settings.windowWidth = 1280;
+    settings.windowHeight = 720;
+  }
+
+  if (settings.menuScale < 0.1f || settings.menuScale > 1.0f) {
+    std::cerr << "Menu scale must be between 0.1 and 1, using 0.5"
+              << std::endl;
+    settings.menuScale = 0.5f;
+  }
+
+  if (settings.flythroughLevel < 1 || settings.flythroughLevel > 2) {
+    std::cerr << "Level must be 1 or 2, using 1" << std::endl;
+    settings.flythroughLevel = 1;
+  }
+
+  if (settings.headless) {
+    if (settings.flythroughPath.empty() &&
+        settings.stressBenchmarkPath.empty()) {
+      std::cerr << "--headless only runs --flythrough or --stress-benchmark"
+                << std::endl;
+      settings.showHelp = true;
+    }
+    settings.offscreen = true; // There is no window to draw into
+  }
+
+  if (settings.tickRate < 10 || settings.tickRate > 1000) {
+    std::cerr << "Tick rate must be between 10 and 1000 Hz, using 120"
+              << std::endl;
+    settings.tickRate = 120;
+  }
+
+  return settings;
+}
+
+void GameSettings::printUsage(const char *program) {
+  std::cout << "Usage: " << program << " [options]" << std::endl;
+  std::cout << "  --width N           Window width (default 1280)"
+            << std::endl;
+  std::cout << "  --height N          Window height (default 720)"
+            << std::endl;
+  std::cout << "  --single-threaded   Run simulation and rendering on one "
+               "thread"
+            << std::endl;
+  std::cout << "  --tick-rate N       Simulation steps per second (default "
+               "120)"
+            << std::endl;
+  std::cout << "  --stats             Print frame rate and ticks per frame"
+            << std::endl;
+  std::cout << "  --hot-reload        Rebuild shaders when their files change"
+            << std::endl;
+  std::cout << "  --menu-scale F      Render menu screens at F times the "
+               "resolution (default 0.5)"
+            << std::endl;
+  std::cout << "  --menu-fps N        Frame rate cap on menu screens, 0 for "
+               "none (default 30)"
+            << std::endl;
+  std::cout << "  --stress            Play a generated stress level instead of "
+               "level 1"
+            << std::endl;
+  std::cout << "  --stress-counts L   Stress level walls,pendulums,stalactites,"
+               "geysers,lights,particles"
+            << std::endl;
+  std::cout << "                      (default 10000,5000,1000,1000,500,100000)"
+            << std::endl;
+  std::cout << "  --seed N            Stress level generator seed (default 1)"
+            << std::endl;
+  std::cout << "  --stress-benchmark F  Time each subsystem on growing stress "
+               "levels, write CSV to F"
+            << std::endl;
+  std::cout << "  --benchmark-ticks N Timed ticks per benchmark step (default "
+               "300)"
+            << std::endl;
+  std::cout << "  --flythrough F      Render benchmark: fly a camera path, "
+               "write per-frame CSV to F"
+            << std::endl;
+  std::cout << "  --camera-path F     Path to fly (default levels/levelN.path)"
+            << std::endl;
+  std::cout << "  --level N           Level for the flythrough, 1 or 2 "
+               "(default 1)"
+            << std::endl;
+  std::cout << "  --frames N          Frames to render (default 1000)"
+            << std::endl;
+  std::cout << "  --offscreen         Hidden window, render into an offscreen "
+               "framebuffer"
+            << std::endl;
+  std::cout << "  --record-path F     Record the camera path while playing"
+            << std::endl;
+  std::cout << "  --headless          No window system: render through EGL "
+               "(needs --flythrough or --stress-benchmark)"
+            << std::endl;
+  std::cout << "  --capture DIR       Save flythrough frames as PNG files in DIR"
+            << std::endl;
+  std::cout << "  --capture-every N   Only every Nth frame (default 1)"
+            << std::endl;
+  std::cout << "  --help              Show this message" << std::endl;
+}
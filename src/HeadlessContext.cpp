@@ -0,0 +1,151 @@
+#include "HeadlessContext.h"
+#include <GL/glew.h>
+#include <iostream>
+
+#ifdef CHRONO_HEADLESS
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <cstring>
+
+namespace {
+bool hasExtension(const char *extensions, const char *name) {
+  if (!extensions)
+    return false;
+  size_t length = std::strlen(name);
+  for (const char *at = std::strstr(extensions, name); at;
+       at = std::strstr(at + length, name)) {
+    if ((at == extensions || at[-1] == ' ') &&
+        (at[length] == ' ' || at[length] == '\0'))
+      return true;
+  }
+  return false;
+}
+
+// Mesa's surfaceless platform needs neither a display server nor a DRM
+// device; other drivers fall back to their default display
+EGLDisplay openDisplay() {
+  const char *clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+  if (hasExtension(clientExtensions, "EGL_MESA_platform_surfaceless")) {
+    auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress(
+        "eglGetPlatformDisplayEXT");
+    if (getPlatformDisplay) {
+      EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA,
+                                              EGL_DEFAULT_DISPLAY, nullptr);
+      if (display != EGL_NO_DISPLAY)
+        return display;
+    }
+  }
+  return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+} // namespace
+#endif
+
+HeadlessContext::HeadlessContext() : display(nullptr), context(nullptr) {}
+
+HeadlessContext::~HeadlessContext() { destroy(); }
+
+bool HeadlessContext::create() {
+#ifdef CHRONO_HEADLESS
+  EGLDisplay eglDisplay = openDisplay();
+  EGLint major = 0, minor = 0;
+  if (eglDisplay == EGL_NO_DISPLAY ||
+      !eglInitialize(eglDisplay, &major, &minor)) {
+    std::cerr << "ERROR::HEADLESS::NO_EGL_DISPLAY" << std::endl;
+    return false;
+  }
+  display = eglDisplay;
+
+  const char *extensions = eglQueryString(eglDisplay, EGL_EXTENSIONS);
+  if (!hasExtension(extensions, "EGL_KHR_surfaceless_context") ||
+      !hasExtension(extensions, "EGL_KHR_create_context")) {
+    std::cerr << "ERROR::HEADLESS::SURFACELESS_CONTEXT_NOT_SUPPORTED (EGL "
+              << major << "." << minor << ")" << std::endl;
+    destroy();
+    return false;
+  }
+
+  // Desktop GL, any surface type (nothing is ever bound to a surface)
+  const EGLint configAttributes[] = {EGL_RENDERABLE_TYPE,
+                                     EGL_OPENGL_BIT,
+                                     EGL_SURFACE_TYPE,
+                                     0,
+                                     EGL_RED_SIZE,
+                                     8,
+                                     EGL_GREEN_SIZE,
+                                     8,
+                                     EGL_BLUE_SIZE,
+                                     8,
+                                     EGL_NONE};
+  EGLConfig config;
+  EGLint configCount = 0;
+  if (!eglBindAPI(EGL_OPENGL_API) ||
+      !eglChooseConfig(eglDisplay, configAttributes, &config, 1,
+                       &configCount) ||
+      configCount == 0) {
+    std::cerr << "ERROR::HEADLESS::NO_OPENGL_CONFIG" << std::endl;
+    destroy();
+    return false;
+  }
+
+  // Same version and profile the window gets from GLFW
+  const EGLint contextAttributes[] = {EGL_CONTEXT_MAJOR_VERSION_KHR,
+                                      3,
+                                      EGL_CONTEXT_MINOR_VERSION_KHR,
+                                      3,
+                                      EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR,
+                                      EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR,
+                                      EGL_NONE};
+  EGLContext eglContext =
+      eglCreateContext(eglDisplay, config, EGL_NO_CONTEXT, contextAttributes);
+  if (eglContext == EGL_NO_CONTEXT) {
+    std::cerr << "ERROR::HEADLESS::CONTEXT_CREATION_FAILED 0x" << std::hex
+              << eglGetError() << std::dec << std::endl;
+    destroy();
+    return false;
+  }
+  context = eglContext;
+
+  if (!eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE,
+                      eglContext)) {
+    std::cerr << "ERROR::HEADLESS::MAKE_CURRENT_FAILED" << std::endl;
+    destroy();
+    return false;
+  }
+
+  // A GLX build of GLEW loads the GL entry points and then fails to find a
+  // GLX display; with libglvnd those entry points dispatch to the current
+  // EGL context, so that error is harmless here
+  glewExperimental = GL_TRUE;
+  GLenum glewStatus = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+  if (glewStatus == GLEW_ERROR_NO_GLX_DISPLAY)
+    glewStatus = GLEW_OK;
+#endif
+  if (glewStatus != GLEW_OK) {
+    std::cerr << "Failed to initialize GLEW" << std::endl;
+    destroy();
+    return false;
+  }
+
+  std::cout << "Headless GL context: " << glGetString(GL_RENDERER) << " (EGL "
+            << major << "." << minor << ")" << std::endl;
+  return true;
+#else
+  std::cerr << "ERROR::HEADLESS::NOT_BUILT (configure with EGL available)"
+            << std::endl;
+  return false;
+#endif
+}
+
+void HeadlessContext::destroy() {
+#ifdef CHRONO_HEADLESS
+  if (!display)
+    return;
+  eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+  if (context)
+    eglDestroyContext(display, context);
+  eglTerminate(display);
+#endif
+  context = nullptr;
+  display = nullptr;
+}
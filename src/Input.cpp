@@ -23,6 +23,39 @@ void Input::update() {
 
 void Input::clearMouseDelta() { mouseDelta = glm::vec2(0.0f); }
 
+InputFrame Input::sample() {
+  InputFrame frame;
+  frame.moveForward = isKeyPressed(KEY_W);
+  frame.moveBack = isKeyPressed(KEY_S);
+  frame.moveLeft = isKeyPressed(KEY_A);
+  frame.moveRight = isKeyPressed(KEY_D);
+  frame.rotateLeft = isKeyPressed(KEY_Q);
+  frame.rotateRight = isKeyPressed(KEY_E);
+
+  frame.jumpPressed = isKeyJustPressed(KEY_SPACE);
+  frame.restartPressed = isKeyJustPressed(KEY_R);
+  frame.toggleCameraPressed =
+      isKeyJustPressed(KEY_T) || isMouseButtonJustPressed(MOUSE_BUTTON_RIGHT);
+
+  // Any key (except ESC which quits) or mouse button held down
+  for (int key = GLFW_KEY_SPACE; key <= GLFW_KEY_LAST; key++) {
+    if (key != GLFW_KEY_ESCAPE && keys[key]) {
+      frame.anyKeyPressed = true;
+      break;
+    }
+  }
+  for (int button = 0; button < 3; button++) {
+    if (mouseButtons[button])
+      frame.anyKeyPressed = true;
+  }
+
+  frame.mouseDelta = mouseDelta;
+
+  clearMouseDelta();
+  update();
+  return frame;
+}
+
 void Input::setMousePosition(float x, float y) {
   lastX = x;
   lastY = y;
@@ -0,0 +1,110 @@
+#include "JobSystem.h"
+#include <iostream>
+
+namespace {
+thread_local unsigned currentThreadIndex = 0;
+}
+
+JobSystem::JobSystem() : queuedJobs(0), stopping(false) {
+  unsigned cores = std::thread::hardware_concurrency();
+  if (cores == 0)
+    cores = 1; // Unknown - run everything inline
+
+  for (unsigned i = 0; i < cores; i++) {
+    queues.push_back(std::make_unique<WorkQueue>());
+  }
+
+  // The main thread is the first "worker", so spawn one fewer
+  for (unsigned i = 1; i < cores; i++) {
+    workers.emplace_back(&JobSystem::workerLoop, this, i);
+  }
+
+  std::cout << "Job system started with " << workers.size()
+            << " worker threads" << std::endl;
+}
+
+JobSystem::~JobSystem() { shutdown(); }
+
+void JobSystem::shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex);
+    stopping = true;
+  }
+  wakeCondition.notify_all();
+
+  for (auto &worker : workers) {
+    if (worker.joinable())
+      worker.join();
+  }
+  workers.clear();
+}
+
+unsigned JobSystem::getThreadIndex() { return currentThreadIndex; }
+
+void JobSystem::push(unsigned queue, const Job &job) {
+  WorkQueue &q = *queues[queue];
+  {
+    std::lock_guard<std::mutex> lock(q.mutex);
+    q.jobs.push_back(job);
+  }
+  queuedJobs.fetch_add(1, std::memory_order_release);
+}
+
+bool JobSystem::pop(unsigned queue, Job &job) {
+  // Owner takes the most recently pushed job (still warm in cache)
+  WorkQueue &q = *queues[queue];
+  std::lock_guard<std::mutex> lock(q.mutex);
+  if (q.jobs.empty())
+    return false;
+  job = q.jobs.back();
+  q.jobs.pop_back();
+  return true;
+}
+
+bool JobSystem::steal(unsigned thief, Job &job) {
+  // Thieves take the oldest job from the other end
+  unsigned count = getThreadCount();
+  for (unsigned i = 1; i < count; i++) {
+    WorkQueue &q = *queues[(thief + i) % count];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (!q.jobs.empty()) {
+      job = q.jobs.front();
+      q.jobs.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+bool JobSystem::runOne(unsigned self) {
+  Job job;
+  if (!pop(self, job) && !steal(self, job))
+    return false;
+
+  queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+  job.invoke(job.fn, job.begin, job.end);
+  job.pending->fetch_sub(1, std::memory_order_release);
+  return true;
+}
+
+void JobSystem::wakeWorkers() {
+  // Taking the lock orders this with a worker checking its wait predicate
+  { std::lock_guard<std::mutex> lock(sleepMutex); }
+  wakeCondition.notify_all();
+}
+
+void JobSystem::workerLoop(unsigned index) {
+  currentThreadIndex = index;
+
+  while (true) {
+    if (runOne(index))
+      continue;
+
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    wakeCondition.wait(lock, [this] {
+      return stopping || queuedJobs.load(std::memory_order_acquire) > 0;
+    });
+    if (stopping)
+      return;
+  }
+}
@@ -1,20 +1,71 @@
 #include "Level.h"
-#include "Shader.h"
+#include "CommandBuffer.h"
+#include "JobSystem.h"
+#include "RenderSnapshot.h"
+#include <chrono>
 #include <cmath>
 #include <iostream>
 
+namespace {
+// Broadphase cell size - a few wall thicknesses
+const float kWallGridCellSize = 4.0f;
+
+// Contacts resolved per tick before leftover motion is dropped
+const int kMaxSlideIterations = 4;
+
+// Gap left between the player and a wall after a swept contact
+const float kContactSkin = 0.001f;
+
+// Splits a stretch of code into timed laps; does nothing when disabled
+class LapTimer {
+public:
+  explicit LapTimer(bool enabled) : enabled(enabled) {
+    if (enabled)
+      last = std::chrono::steady_clock::now();
+  }
+
+  double lap() {
+    if (!enabled)
+      return 0.0;
+    std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(now - last).count();
+    last = now;
+    return seconds;
+  }
+
+private:
+  bool enabled;
+  std::chrono::steady_clock::time_point last;
+};
+} // namespace
+
 Level::Level()
     : ambientLight(0.2f), playerStartPosition(0.0f, 1.0f, 0.0f),
       levelComplete(false), hasCollectible(false), shouldRestart(false),
-      shouldResetToLevel1(false) {}
+      shouldResetToLevel1(false), profiling(false), lastProfile() {}
 
 void Level::update(float deltaTime, Player *player, ParticleSystem *particles) {
-  // Update all game objects
-  for (auto &obj : objects) {
-    if (obj->isActive) {
-      obj->update(deltaTime);
-    }
-  }
+  LapTimer timer(profiling);
+
+  // Update all game objects. Object updates only touch their own state, so
+  // they run in parallel; side effects go through CommandBuffer::local().
+  JobSystem::getInstance().parallelFor(
+      objects.size(), 64, [this, deltaTime](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+          if (objects[i]->isActive) {
+            objects[i]->update(deltaTime);
+          }
+        }
+      });
+  lastProfile.objects = timer.lap();
+
+  entities.updateActivity(player->getPosition(), activityView);
+  entities.update(deltaTime);
+  lastProfile.hazards = timer.lap();
+
+  // Apply deferred sounds and particle emission in a deterministic order
+  CommandBuffer::flushAll(particles);
 
   // Update lights (flickering)
   // Update lights (flickering)
@@ -28,24 +79,29 @@ void Level::update(float deltaTime, Player *player, ParticleSystem *particles) {
       light.intensity = std::max(0.1f, light.baseIntensity + flicker);
     }
   }
+  lastProfile.effects = timer.lap();
 
   // Check collisions and triggers
   checkCollisions(player, particles);
   checkTriggers(player);
+  lastProfile.collisions = timer.lap();
 }
 
-void Level::draw(Shader *shader) {
+void Level::draw(RenderSnapshot &snapshot) const {
   // Draw walls
   for (const auto &wall : walls) {
     if (wall->isActive) {
-      wall->draw(shader);
+      wall->draw(snapshot);
     }
   }
 
+  // Draw hazards
+  entities.draw(snapshot);
+
   // Draw objects
   for (const auto &obj : objects) {
     if (obj->isActive) {
-      obj->draw(shader);
+      obj->draw(snapshot);
     }
   }
 
@@ -53,164 +109,444 @@ void Level::draw(Shader *shader) {
   // effect
   for (const auto &fixture : lightFixtures) {
     if (fixture->isActive) {
-      fixture->draw(shader);
+      fixture->draw(snapshot);
     }
   }
 }
 
-void Level::drawLights(Shader *shader) {
-  shader->setVec3("ambientLight", ambientLight);
-  // Increased limit to 32 to match shader update
-  shader->setInt("numLights", std::min((int)lights.size(), 32));
-
-  for (size_t i = 0; i < lights.size() && i < 32; i++) {
-    std::string base = "lights[" + std::to_string(i) + "]";
-    shader->setVec3(base + ".position", lights[i].position);
-    shader->setVec3(base + ".color", lights[i].color);
-    shader->setFloat(base + ".intensity", lights[i].intensity);
+void Level::drawLights(RenderSnapshot &snapshot) const {
+  snapshot.ambientLight = ambientLight;
+  for (const auto &light : lights) {
+    LightState state;
+    state.position = light.position;
+    state.color = light.color;
+    state.intensity = light.intensity;
+    snapshot.lights.push_back(state);
   }
 }
 
 void Level::checkCollisions(Player *player, ParticleSystem *particles) {
-  // Check wall collisions - ACTUALLY PREVENT PENETRATION
-  for (const auto &wall : walls) {
+  if (wallGrid.getBoxCount() != walls.size()) {
+    rebuildWallGrid();
+  }
+
+  // Continuous pass: fast motion (geyser launches, knockback, jumps) can
+  // otherwise skip straight through a 1-unit wall between two ticks
+  sweepPlayer(player, particles);
+
+  // Resting contact - ACTUALLY PREVENT PENETRATION. One batched test finds
+  // the walls whose boxes touch the player; only those get the exact test.
+  // Walls are resolved in order against the updated position, as if each
+  // were tested in turn, so the mask is redone after every push-out.
+  Physics::sphereAABBBatch(player->collisionSphere, wallBoxes, wallHits);
+  for (size_t index = 0; index < walls.size(); index++) {
+    if (!(wallHits[index / 32] & (1u << (index % 32))))
+      continue;
+
+    const auto &wall = walls[index];
     if (!wall->isActive)
       continue;
 
-    if (Physics::checkSphereAABBCollision(player->collisionSphere,
-                                          wall->boundingBox)) {
-      // Calculate penetration and push player out
-      glm::vec3 playerPos = player->getPosition();
-      glm::vec3 wallCenter = wall->boundingBox.getCenter();
-      glm::vec3 wallSize = wall->boundingBox.max - wall->boundingBox.min;
-
-      // Find closest point on box to sphere
-      glm::vec3 closestPoint =
-          glm::clamp(playerPos, wall->boundingBox.min, wall->boundingBox.max);
-      glm::vec3 normal = playerPos - closestPoint;
-      float distance = glm::length(normal);
-
-      if (distance < player->collisionSphere.radius) {
-        // Push player out
-        if (distance > 0.001f) {
-          normal = glm::normalize(normal);
-        } else {
-          // Player is exactly at closest point, use direction from wall center
-          normal = glm::normalize(playerPos - wallCenter);
-        }
+    // Find closest point on box to sphere
+    glm::vec3 playerPos = player->getPosition();
+    glm::vec3 closestPoint =
+        wall->isRotated
+            ? wall->orientedBox.closestPoint(playerPos)
+            : glm::clamp(playerPos, wall->boundingBox.min, wall->boundingBox.max);
+    glm::vec3 normal = playerPos - closestPoint;
+    float distance = glm::length(normal);
+
+    if (distance < player->collisionSphere.radius) {
+      // Push player out
+      if (distance > 0.001f) {
+        normal = glm::normalize(normal);
+      } else {
+        // Player is exactly at closest point, use direction from wall center
+        normal = glm::normalize(playerPos - wall->boundingBox.getCenter());
+      }
+
+      float penetration = player->collisionSphere.radius - distance;
+      player->transform.position +=
+          normal * (penetration + 0.01f); // Small epsilon to ensure separation
+      player->collisionSphere.center = player->transform.position;
+
+      // Play collision sound and emit particles
+      player->onWallCollision(normal, particles);
+
+      // The push may have moved the player into a later wall
+      Physics::sphereAABBBatch(player->collisionSphere, wallBoxes, wallHits);
+    }
+  }
+
+  // Anything that moves the player from here on (hazard knockback, level
+  // scripts) is swept next tick
+  player->previousPosition = player->getPosition();
+
+  // Check hazard collisions (pendulum blades, falling stalactites)
+  entities.checkPlayerCollisions(player, particles);
+}
 
-        float penetration = player->collisionSphere.radius - distance;
-        player->transform.position +=
-            normal *
-            (penetration + 0.01f); // Small epsilon to ensure separation
-        player->collisionSphere.center = player->transform.position;
+void Level::rebuildWallGrid() {
+  std::vector<AABB> boxes;
+  boxes.reserve(walls.size());
+  for (const auto &wall : walls) {
+    boxes.push_back(wall->boundingBox);
+  }
+  wallGrid.build(boxes, kWallGridCellSize);
+
+  wallBoxes.resize(boxes.size());
+  for (size_t i = 0; i < boxes.size(); i++) {
+    wallBoxes.set(i, boxes[i]);
+  }
+}
 
-        // Play collision sound and emit particles
-        player->onWallCollision(normal, particles);
+void Level::sweepPlayer(Player *player, ParticleSystem *particles) {
+  float radius = player->collisionSphere.radius;
+  glm::vec3 position = player->previousPosition;
+  glm::vec3 remaining = player->getPosition() - position;
+
+  bool touchedWall = false;
+  glm::vec3 firstNormal(0.0f);
+
+  for (int i = 0; i < kMaxSlideIterations; i++) {
+    if (glm::dot(remaining, remaining) < 1e-10f)
+      break;
+
+    // Only walls near the swept path are tested exactly
+    glm::vec3 end = position + remaining;
+    wallGrid.query(AABB(glm::min(position, end) - glm::vec3(radius),
+                        glm::max(position, end) + glm::vec3(radius)),
+                   wallCandidates);
+
+    float hitTime = 1.0f;
+    glm::vec3 hitNormal(0.0f);
+    bool hit = false;
+    for (uint32_t index : wallCandidates) {
+      const auto &wall = walls[index];
+      if (!wall->isActive)
+        continue;
+
+      float t;
+      glm::vec3 normal;
+      bool swept =
+          wall->isRotated
+              ? Physics::sweepSphereOBB(Sphere(position, radius), remaining,
+                                        wall->orientedBox, t, normal)
+              : Physics::sweepSphereAABB(Sphere(position, radius), remaining,
+                                         wall->boundingBox, t, normal);
+      if (swept && t < hitTime) {
+        hitTime = t;
+        hitNormal = normal;
+        hit = true;
       }
     }
+
+    if (!hit) {
+      position = end;
+      break;
+    }
+
+    // Advance to the contact, then slide the rest of the motion along the
+    // wall. Velocity into the wall is dropped so it doesn't build up.
+    position += remaining * hitTime + hitNormal * kContactSkin;
+    remaining *= 1.0f - hitTime;
+    remaining -= hitNormal * glm::dot(remaining, hitNormal);
+
+    float into = glm::dot(player->velocity, hitNormal);
+    if (into < 0.0f) {
+      player->velocity -= hitNormal * into;
+    }
+
+    if (!touchedWall) {
+      touchedWall = true;
+      firstNormal = hitNormal;
+    }
+  }
+
+  player->transform.position = position;
+  player->collisionSphere.center = position;
+
+  if (touchedWall) {
+    // Play collision sound and emit particles
+    player->onWallCollision(firstNormal, particles);
   }
+}
 
-  // Check obstacle collisions
-  for (auto &obj : objects) {
-    if (!obj->isActive || obj->isTrigger)
+void Level::checkTriggers(Player *player) {
+  // Crumbling tiles - check if player is standing on top
+  glm::vec3 playerPos = player->getPosition();
+  for (CrumblingTile *tile : crumblingTiles) {
+    if (!tile->isActive || !tile->isTrigger)
       continue;
 
-    bool collision = false;
-    if (obj->useSphereCollision) {
-      collision = Physics::checkSphereCollision(player->collisionSphere,
-                                                obj->boundingSphere);
-    } else {
-      collision = Physics::checkSphereAABBCollision(player->collisionSphere,
-                                                    obj->boundingBox);
+    glm::vec3 tilePos = tile->transform.position;
+    glm::vec3 tileScale = tile->transform.scale;
+
+    // Check if player is above the tile (within reasonable height)
+    float heightDiff = playerPos.y - tilePos.y;
+    bool isAboveTile = (heightDiff > 0.0f && heightDiff < 2.0f);
+
+    // Check horizontal overlap (is player's XZ position over the tile?)
+    bool xOverlap = std::abs(playerPos.x - tilePos.x) <
+                    (tileScale.x / 2.0f + player->collisionSphere.radius);
+    bool zOverlap = std::abs(playerPos.z - tilePos.z) <
+                    (tileScale.z / 2.0f + player->collisionSphere.radius);
+
+    if (isAboveTile && xOverlap && zOverlap) {
+      tile->onTrigger();
     }
+  }
 
-    if (collision) {
-      if (obj->type == GameObjectType::PENDULUM) {
-        glm::vec3 knockback =
-            glm::normalize(player->getPosition() - obj->transform.position);
-        player->onObstacleHit(knockback, particles);
-      } else if (obj->type == GameObjectType::STALACTITE) {
-        // If stalactite hits player while falling, it's a hazard
-        Stalactite *stal = dynamic_cast<Stalactite *>(obj.get());
-        if (stal && stal->isFalling) {
-          // Apply pushback/knockback
-          glm::vec3 knockback =
-              glm::normalize(player->getPosition() - stal->transform.position);
-          // Add some upward force too
-          knockback.y = 0.5f;
-          knockback = glm::normalize(knockback);
-
-          player->onObstacleHit(knockback, particles);
-        }
-      }
+  // Collectibles
+  for (Collectible *collectible : collectibles) {
+    if (!collectible->isActive || !collectible->isTrigger ||
+        collectible->isCollected)
+      continue;
+
+    if (Physics::checkSphereCollision(player->collisionSphere,
+                                      collectible->boundingSphere)) {
+      collectible->collect();
+      hasCollectible = true;
+    }
+  }
+
+  // Health pickups
+  for (HealthPickup *healthPickup : healthPickups) {
+    if (!healthPickup->isActive || !healthPickup->isTrigger ||
+        healthPickup->isCollected)
+      continue;
+
+    if (Physics::checkSphereCollision(player->collisionSphere,
+                                      healthPickup->boundingSphere)) {
+      healthPickup->collect();
+      player->addHeart();
+    }
+  }
+
+  // Any other trigger volumes
+  for (GameObject *obj : triggers) {
+    if (!obj->isActive || !obj->isTrigger)
+      continue;
+
+    bool inside = obj->useSphereCollision
+                      ? Physics::checkSphereCollision(player->collisionSphere,
+                                                      obj->boundingSphere)
+                      : Physics::checkSphereAABBCollision(
+                            player->collisionSphere, obj->boundingBox);
+    if (inside) {
+      obj->onTrigger();
     }
   }
 }
 
-void Level::checkTriggers(Player *player) {
-  // Check triggers
-  for (auto &obj : objects) {
-    if (obj->isActive && obj->isTrigger) {
-      // Special handling for crumbling tiles - check if player is standing on
-      // top
-      if (obj->type == GameObjectType::CRUMBLING_TILE) {
-        glm::vec3 playerPos = player->getPosition();
-        glm::vec3 tilePos = obj->transform.position;
-        glm::vec3 tileScale = obj->transform.scale;
-
-        // Check if player is above the tile (within reasonable height)
-        float heightDiff = playerPos.y - tilePos.y;
-        bool isAboveTile = (heightDiff > 0.0f && heightDiff < 2.0f);
-
-        // Check horizontal overlap (is player's XZ position over the tile?)
-        bool xOverlap = std::abs(playerPos.x - tilePos.x) <
-                        (tileScale.x / 2.0f + player->collisionSphere.radius);
-        bool zOverlap = std::abs(playerPos.z - tilePos.z) <
-                        (tileScale.z / 2.0f + player->collisionSphere.radius);
-
-        if (isAboveTile && xOverlap && zOverlap) {
-          obj->onTrigger();
-        }
-      } else if (obj->useSphereCollision) {
-        // Enhanced debug logging for collectibles
-        if (obj->type == GameObjectType::COLLECTIBLE) {
-          auto collectible = static_cast<Collectible *>(obj.get());
-          if (!collectible->isCollected) {
-            float distance = glm::length(player->collisionSphere.center -
-                                         obj->boundingSphere.center);
-            float combinedRadius =
-                player->collisionSphere.radius + obj->boundingSphere.radius;
-
-            // Debug output every frame when player is near gem
-          }
-        }
+void Level::printMemoryReport(const char *name) const {
+  std::cout << name << " memory: " << arena.getObjectCount() << " objects in "
+            << arena.getBytesUsed() / 1024 << " KB ("
+            << arena.getBytesReserved() / 1024 << " KB reserved in "
+            << arena.getBlockCount() << " blocks) - " << objects.size()
+            << " objects, " << walls.size() << " walls, "
+            << lightFixtures.size() << " fixtures, " << entities.size()
+            << " hazards; restart snapshot " << initialState.size() / 1024
+            << " KB" << std::endl;
+}
 
-        if (Physics::checkSphereCollision(player->collisionSphere,
-                                          obj->boundingSphere)) {
-          obj->onTrigger();
-          if (obj->type == GameObjectType::COLLECTIBLE) {
-            auto collectible = static_cast<Collectible *>(obj.get());
-            if (!collectible->isCollected) {
-              collectible->collect();
-              hasCollectible = true;
-            }
-          } else if (obj->type == GameObjectType::HEALTH_PICKUP) {
-            auto healthPickup = static_cast<HealthPickup *>(obj.get());
-            if (!healthPickup->isCollected) {
-              healthPickup->collect();
-              player->addHeart();
-            }
-          }
-        }
-      } else {
-        if (Physics::checkSphereAABBCollision(player->collisionSphere,
-                                              obj->boundingBox)) {
-          obj->onTrigger();
-        }
-      }
+void Level::captureInitialState() {
+  initialState.clear();
+  saveState(initialState);
+}
+
+void Level::restoreInitialState() {
+  initialState.rewind();
+  restoreState(initialState);
+}
+
+void Level::saveState(StateBuffer &state) const {
+  // Objects are only created by init(), so the lists line up on restore
+  for (const auto &obj : objects) {
+    obj->saveState(state);
+  }
+  for (const auto &wall : walls) {
+    wall->saveState(state);
+  }
+  for (const auto &fixture : lightFixtures) {
+    fixture->saveState(state);
+  }
+  state.write(lights);
+  entities.saveState(state);
+
+  state.write(ambientLight);
+  state.write(playerStartPosition);
+  state.write(levelComplete);
+  state.write(hasCollectible);
+  state.write(shouldRestart);
+  state.write(shouldResetToLevel1);
+}
+
+void Level::restoreState(StateBuffer &state) {
+  for (const auto &obj : objects) {
+    obj->restoreState(state);
+  }
+  for (const auto &wall : walls) {
+    wall->restoreState(state);
+  }
+  for (const auto &fixture : lightFixtures) {
+    fixture->restoreState(state);
+  }
+  state.read(lights);
+  entities.restoreState(state);
+
+  state.read(ambientLight);
+  state.read(playerStartPosition);
+  state.read(levelComplete);
+  state.read(hasCollectible);
+  state.read(shouldRestart);
+  state.read(shouldResetToLevel1);
+}
+
+GameObject *Level::addObject(ArenaPtr<GameObject> obj) {
+  GameObject *ptr = obj.get();
+
+  // Keep the typed views in sync so per-frame logic never scans `objects`
+  switch (ptr->type) {
+  case GameObjectType::COLLECTIBLE:
+    collectibles.push_back(static_cast<Collectible *>(ptr));
+    break;
+  case GameObjectType::CRUMBLING_TILE:
+    crumblingTiles.push_back(static_cast<CrumblingTile *>(ptr));
+    break;
+  case GameObjectType::HEALTH_PICKUP:
+    healthPickups.push_back(static_cast<HealthPickup *>(ptr));
+    break;
+  default:
+    if (ptr->isTrigger) {
+      triggers.push_back(ptr);
     }
+    break;
   }
+
+  objects.push_back(std::move(obj));
+  return ptr;
+}
+
+namespace {
+glm::vec3 toVec3(const float values[3]) {
+  return glm::vec3(values[0], values[1], values[2]);
+}
+
+SoundEffect toSoundEffect(uint32_t sound) {
+  switch (static_cast<LevelSound>(sound)) {
+  case LevelSound::COIN:
+    return SoundEffect::COIN_COLLECT;
+  case LevelSound::GEM:
+    return SoundEffect::GEM_COLLECT;
+  default:
+    return SoundEffect::COLLECTIBLE_PICKUP;
+  }
+}
+} // namespace
+
+bool Level::loadLayout(const std::string &basePath) {
+  LevelData data;
+  if (!data.load(basePath)) {
+    std::cerr << "ERROR::LEVEL::LAYOUT_NOT_LOADED " << basePath << std::endl;
+    return false;
+  }
+
+  // The counts are known up front, so grow every container once and carve
+  // all the layout's objects out of one arena block
+  size_t solidProps = 0;
+  for (uint32_t i = 0; i < data.propCount; i++) {
+    if (data.props[i].flags & PROP_SOLID)
+      solidProps++;
+  }
+  walls.reserve(walls.size() + data.wallCount + solidProps);
+  objects.reserve(objects.size() + data.propCount - solidProps +
+                  data.coinCount);
+  collectibles.reserve(collectibles.size() + data.coinCount);
+  lights.reserve(lights.size() + data.lightCount);
+  entities.reserve(data.pendulumCount, data.stalactiteCount,
+                   data.geyserCount);
+
+  const size_t slack = alignof(std::max_align_t);
+  arena.reserve((data.wallCount + data.propCount) *
+                    (sizeof(GameObject) + slack) +
+                data.coinCount * (sizeof(Collectible) + slack));
+
+  for (uint32_t i = 0; i < data.wallCount; i++) {
+    const WallRecord &wall = data.walls[i];
+    createWall(toVec3(wall.position), toVec3(wall.size), toVec3(wall.color),
+               wall.materialType);
+  }
+
+  for (uint32_t i = 0; i < data.pendulumCount; i++) {
+    const PendulumRecord &pendulum = data.pendulums[i];
+    entities.addPendulum(toVec3(pendulum.pivot), pendulum.length,
+                         pendulum.swingSpeed, pendulum.phase,
+                         toVec3(pendulum.size));
+  }
+
+  for (uint32_t i = 0; i < data.stalactiteCount; i++) {
+    const StalactiteRecord &stalactite = data.stalactites[i];
+    entities.addStalactite(toVec3(stalactite.position),
+                           toVec3(stalactite.size));
+  }
+
+  for (uint32_t i = 0; i < data.geyserCount; i++) {
+    entities.addGeyser(toVec3(data.geysers[i].position));
+  }
+
+  for (uint32_t i = 0; i < data.propCount; i++) {
+    const PropRecord &record = data.props[i];
+    auto prop = arena.make<GameObject>(GameObjectType::STATIC_WALL);
+    prop->transform.position = toVec3(record.position);
+    prop->transform.scale = glm::vec3(record.scale);
+    prop->transform.rotate(record.yaw, glm::vec3(0.0f, 1.0f, 0.0f));
+    prop->loadCachedModel(data.getString(record.model));
+    prop->color = toVec3(record.color);
+    prop->materialType = record.materialType;
+
+    if (record.flags & PROP_SOLID) {
+      // The model's own extents are meaningless at tiny scales; collide
+      // with the box the layout gives
+      prop->boundingBox = Physics::createAABBFromTransform(
+          prop->transform.position, toVec3(record.collisionSize));
+      walls.push_back(std::move(prop));
+    } else {
+      prop->updateBoundingBox();
+      addObject(std::move(prop));
+    }
+  }
+
+  for (uint32_t i = 0; i < data.coinCount; i++) {
+    const CoinRecord &record = data.coins[i];
+    auto coin = arena.make<Collectible>(toVec3(record.position),
+                                        toVec3(record.color));
+    coin->loadModel(data.getString(record.model));
+    coin->transform.scale = glm::vec3(record.scale);
+    coin->rotationSpeed = record.rotationSpeed;
+    coin->soundType = toSoundEffect(record.sound);
+    addObject(std::move(coin));
+  }
+
+  for (uint32_t i = 0; i < data.lightCount; i++) {
+    const LightRecord &record = data.lights[i];
+    Light light;
+    light.position = toVec3(record.position);
+    light.color = toVec3(record.color);
+    light.intensity = record.intensity;
+    light.baseIntensity = record.intensity;
+    lights.push_back(light);
+
+    if (record.fixtureScale > 0.0f)
+      createLightFixture(light.position, light.color, record.fixtureScale);
+  }
+
+  std::cout << "Loaded level layout " << basePath << " (" << data.wallCount
+            << " walls, " << data.propCount << " props, "
+            << data.pendulumCount + data.stalactiteCount + data.geyserCount
+            << " hazards, " << data.coinCount << " coins, " << data.lightCount
+            << " lights)" << std::endl;
+  return true;
 }
 
 void Level::checkCameraCollision(glm::vec3 &cameraPos,
@@ -241,7 +577,7 @@ void Level::checkCameraCollision(glm::vec3 &cameraPos,
 
 void Level::createWall(const glm::vec3 &position, const glm::vec3 &scale,
                        const glm::vec3 &color, int materialType) {
-  auto wall = std::make_unique<GameObject>(GameObjectType::STATIC_WALL);
+  auto wall = arena.make<GameObject>(GameObjectType::STATIC_WALL);
   wall->transform.position = position;
   wall->transform.scale = scale;
   wall->mesh.reset(Mesh::createCube(1.0f));
@@ -253,7 +589,7 @@ void Level::createWall(const glm::vec3 &position, const glm::vec3 &scale,
 
 void Level::createFloor(const glm::vec3 &position, const glm::vec3 &scale,
                         const glm::vec3 &color) {
-  auto floor = std::make_unique<GameObject>(GameObjectType::STATIC_WALL);
+  auto floor = arena.make<GameObject>(GameObjectType::STATIC_WALL);
   floor->transform.position = position;
   floor->transform.scale = scale;
   floor->mesh.reset(
@@ -277,34 +613,21 @@ void Level::loadLightFixtureModel() {
   }
 }
 
-void Level::drawLightFixtureModels(Shader *shader) {
+void Level::drawLightFixtureModels(RenderSnapshot &snapshot) const {
   // Draw the fractured orb model at each light fixture position
   if (!lightFixtureModel || lightFixtureModel->meshes.empty()) {
     return;
   }
 
-  // Set emissive mode for the orb - BOOSTED BRIGHTNESS
-  shader->setFloat("emissive", 1.5f); // Brighter than normal (1.0)
-  shader->setVec3("objectColor",
-                  glm::vec3(1.0f, 0.95f, 0.85f)); // Warm white glow
-  shader->setBool("useTexture", false);
-
-  glDisable(GL_CULL_FACE); // Model might be inside-out
-
+  // Fixtures never move, so the whole matrix goes into `post`
   for (const auto &transform : lightFixtureTransforms) {
-    shader->setMat4("model", transform);
-
-    // Calculate normal matrix
-    glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(transform)));
-    shader->setMat3("normalMatrix", normalMatrix);
-
-    lightFixtureModel->draw(shader);
+    RenderInstance &instance = snapshot.addInstance(
+        &transform, Transform(), glm::vec3(1.0f, 0.95f, 0.85f)); // Warm white
+    instance.post = transform;
+    instance.model = lightFixtureModel.get();
+    instance.emissive = 1.5f;     // Brighter than normal (1.0)
+    instance.doubleSided = true; // Model might be inside-out
   }
-
-  glEnable(GL_CULL_FACE);
-
-  // Reset emissive
-  shader->setFloat("emissive", 0.0f);
 }
 
 void Level::createLightFixture(const glm::vec3 &position,
@@ -328,7 +651,7 @@ void Level::createLightFixture(const glm::vec3 &position,
   lightFixtureTransforms.push_back(transform);
 
   // Create chain/rod to ceiling (not emissive - just decorative)
-  auto rod = std::make_unique<GameObject>(GameObjectType::COLLECTIBLE);
+  auto rod = arena.make<GameObject>(GameObjectType::COLLECTIBLE);
   rod->transform.position =
       adjustedPos +
       glm::vec3(0.0f, scale * 3.5f, 0.0f); // Adjusted for new scale
@@ -342,7 +665,7 @@ void Level::createLightFixture(const glm::vec3 &position,
   lightFixtures.push_back(std::move(rod));
 
   // Create small mounting bracket
-  auto mount = std::make_unique<GameObject>(GameObjectType::COLLECTIBLE);
+  auto mount = arena.make<GameObject>(GameObjectType::COLLECTIBLE);
   mount->transform.position = adjustedPos + glm::vec3(0.0f, scale * 1.2f, 0.0f);
   mount->transform.scale = glm::vec3(scale * 0.4f, scale * 0.25f, scale * 0.4f);
   mount->mesh.reset(Mesh::createSphere(1.0f, 8, 8));
@@ -18,16 +18,14 @@ void Level1::init() {
             << crumblingTileTexture->ID << std::endl;
 
   createChamber();
-  createMazeWalls();
-  createPendulums();
+  loadLayout("levels/level1"); // Maze walls, pendulums, 10 coins, lights
   createCrumblingTiles();
   createForceFieldDoor();
   createCheckeredFloor(); // New checkered floor
-  createCollectible();    // Creates 10 coins
 
   // Create energy crystal (initially hidden, appears after 6 coins)
   // Create energy crystal (initially hidden, appears after 6 coins)
-  auto crystal = std::make_unique<Collectible>(
+  auto crystal = arena.make<Collectible>(
       glm::vec3(0.0f, 2.0f, 15.0f), // Central location near exit
       glm::vec3(0.2f, 0.6f, 1.0f)   // Blue color
   );
@@ -41,39 +39,12 @@ void Level1::init() {
   crystal->isTrigger = true;
   crystal->soundType = SoundEffect::GEM_COLLECT;
   energyCrystal = crystal.get();
-  objects.push_back(std::move(crystal));
+  addObject(std::move(crystal));
 
   // Create health pickup in Level 1 (near center of map)
   auto healthPickup =
-      std::make_unique<HealthPickup>(glm::vec3(15.0f, 1.5f, -15.0f));
-  objects.push_back(std::move(healthPickup));
-
-  // Setup lights - 8 evenly distributed static lights
-  lights.clear();
-
-  // Create 8 lights in a grid pattern (2x4) across the 90x90 room
-  // Room spans from -45 to +45 in both x and z
-  float lightHeight = 12.0f;   // High up for good coverage
-  float lightIntensity = 4.0f; // Bright intensity for well-lit scene
-  glm::vec3 lightColor(1.0f, 0.95f, 0.8f); // Warm white light
-
-  // Grid positions: 2 rows (x), 4 columns (z)
-  float xPositions[] = {-22.5f, 22.5f}; // 2 positions along x-axis
-  float zPositions[] = {-33.75f, -11.25f, 11.25f,
-                        33.75f}; // 4 positions along z-axis
-
-  for (float xPos : xPositions) {
-    for (float zPos : zPositions) {
-      Light light;
-      light.position = glm::vec3(xPos, lightHeight, zPos);
-      light.color = lightColor;
-      light.intensity = lightIntensity;
-      lights.push_back(light);
-
-      // Create visible light fixture at this position
-      createLightFixture(light.position, lightColor, 1.0f);
-    }
-  }
+      arena.make<HealthPickup>(glm::vec3(15.0f, 1.5f, -15.0f));
+  addObject(std::move(healthPickup));
 
   glEnable(GL_LIGHTING);
   glEnable(GL_COLOR_MATERIAL);
@@ -127,234 +98,30 @@ void Level1::createChamber() {
              glm::vec3(roomWidth, 0.5f, roomDepth), outerWallColor);
 }
 
-void Level1::createMazeWalls() {
-  // MAZE LAYOUT - Structured pathways with walls
-  glm::vec3 brickColor(0.7f, 0.3f, 0.2f); // Reddish brick
-  float h = 6.0f;                         // Wall height
-
-  // Outer perimeter decorative walls (corners)
-  // Northwest corner
-  createWall(glm::vec3(-40.0f, h / 2, -35.0f), glm::vec3(1.0f, h, 10.0f),
-             brickColor, 1);
-  createWall(glm::vec3(-35.0f, h / 2, -40.0f), glm::vec3(10.0f, h, 1.0f),
-             brickColor, 1);
-
-  // Northeast corner
-  createWall(glm::vec3(40.0f, h / 2, -35.0f), glm::vec3(1.0f, h, 10.0f),
-             brickColor, 1);
-  createWall(glm::vec3(35.0f, h / 2, -40.0f), glm::vec3(10.0f, h, 1.0f),
-             brickColor, 1);
-
-  // Southwest corner
-  createWall(glm::vec3(-40.0f, h / 2, 35.0f), glm::vec3(1.0f, h, 10.0f),
-             brickColor, 1);
-  createWall(glm::vec3(-35.0f, h / 2, 40.0f), glm::vec3(10.0f, h, 1.0f),
-             brickColor, 1);
-
-  // Southeast corner
-  createWall(glm::vec3(40.0f, h / 2, 35.0f), glm::vec3(1.0f, h, 10.0f),
-             brickColor, 1);
-  createWall(glm::vec3(35.0f, h / 2, 40.0f), glm::vec3(10.0f, h, 1.0f),
-             brickColor, 1);
-
-  // Create maze pathways - vertical walls
-  createWall(glm::vec3(-25.0f, h / 2, -20.0f), glm::vec3(1.0f, h, 20.0f),
-             brickColor, 1);
-  createWall(glm::vec3(-25.0f, h / 2, 10.0f), glm::vec3(1.0f, h, 20.0f),
-             brickColor, 1);
-
-  createWall(glm::vec3(25.0f, h / 2, -20.0f), glm::vec3(1.0f, h, 20.0f),
-             brickColor, 1);
-  createWall(glm::vec3(25.0f, h / 2, 10.0f), glm::vec3(1.0f, h, 20.0f),
-             brickColor, 1);
-
-  createWall(glm::vec3(-10.0f, h / 2, -30.0f), glm::vec3(1.0f, h, 15.0f),
-             brickColor, 1);
-  createWall(glm::vec3(-10.0f, h / 2, 5.0f), glm::vec3(1.0f, h, 20.0f),
-             brickColor, 1);
-
-  createWall(glm::vec3(10.0f, h / 2, -30.0f), glm::vec3(1.0f, h, 15.0f),
-             brickColor, 1);
-  createWall(glm::vec3(10.0f, h / 2, 5.0f), glm::vec3(1.0f, h, 20.0f),
-             brickColor, 1);
-
-  // Horizontal walls to create maze paths
-  createWall(glm::vec3(-35.0f, h / 2, -15.0f), glm::vec3(15.0f, h, 1.0f),
-             brickColor, 1);
-  createWall(glm::vec3(-35.0f, h / 2, 15.0f), glm::vec3(15.0f, h, 1.0f),
-             brickColor, 1);
-
-  createWall(glm::vec3(35.0f, h / 2, -15.0f), glm::vec3(15.0f, h, 1.0f),
-             brickColor, 1);
-  createWall(glm::vec3(35.0f, h / 2, 15.0f), glm::vec3(15.0f, h, 1.0f),
-             brickColor, 1);
-
-  createWall(glm::vec3(-17.5f, h / 2, 0.0f), glm::vec3(15.0f, h, 1.0f),
-             brickColor, 1);
-  createWall(glm::vec3(17.5f, h / 2, 0.0f), glm::vec3(15.0f, h, 1.0f),
-             brickColor, 1);
-
-  createWall(glm::vec3(0.0f, h / 2, -22.5f), glm::vec3(15.0f, h, 1.0f),
-             brickColor, 1);
-
-  // Exit area walls (flanking the door)
-  createWall(glm::vec3(-10.0f, h / 2, 35.0f), glm::vec3(8.0f, h, 1.0f),
-             brickColor, 1);
-  createWall(glm::vec3(10.0f, h / 2, 35.0f), glm::vec3(8.0f, h, 1.0f),
-             brickColor, 1);
-}
-
-void Level1::createPendulums() {
-  // SPREAD OUT PENDULUMS - Distributed across different areas
-
-  // Northwest area - 3 pendulums
-  auto p1 = std::make_unique<Pendulum>(glm::vec3(-32.0f, 8.0f, -25.0f), 6.0f);
-  p1->swingSpeed = 2.0f;
-  p1->transform.scale = glm::vec3(5.0f, 3.0f, 0.5f);
-  p1->updateBoundingBox();
-  objects.push_back(std::move(p1));
-
-  auto p2 = std::make_unique<Pendulum>(glm::vec3(-32.0f, 8.0f, -10.0f), 6.0f);
-  p2->swingSpeed = 2.3f;
-  p2->swingAngle = 1.5f;
-  p2->transform.scale = glm::vec3(5.0f, 3.0f, 0.5f);
-  p2->updateBoundingBox();
-  objects.push_back(std::move(p2));
-
-  auto p3 = std::make_unique<Pendulum>(glm::vec3(-32.0f, 8.0f, 5.0f), 6.0f);
-  p3->swingSpeed = 2.5f;
-  p3->transform.scale = glm::vec3(5.0f, 3.0f, 0.5f);
-  p3->updateBoundingBox();
-  objects.push_back(std::move(p3));
-
-  // Northeast area - 3 pendulums
-  auto p4 = std::make_unique<Pendulum>(glm::vec3(32.0f, 8.0f, -25.0f), 6.0f);
-  p4->swingSpeed = 2.2f;
-  p4->swingAngle = 3.0f;
-  p4->transform.scale = glm::vec3(5.0f, 3.0f, 0.5f);
-  p4->updateBoundingBox();
-  objects.push_back(std::move(p4));
-
-  auto p5 = std::make_unique<Pendulum>(glm::vec3(32.0f, 8.0f, -10.0f), 6.0f);
-  p5->swingSpeed = 2.4f;
-  p5->transform.scale = glm::vec3(5.0f, 3.0f, 0.5f);
-  p5->updateBoundingBox();
-  objects.push_back(std::move(p5));
-
-  auto p6 = std::make_unique<Pendulum>(glm::vec3(32.0f, 8.0f, 5.0f), 6.0f);
-  p6->swingSpeed = 2.1f;
-  p6->swingAngle = 2.0f;
-  p6->transform.scale = glm::vec3(5.0f, 3.0f, 0.5f);
-  p6->updateBoundingBox();
-  objects.push_back(std::move(p6));
-
-  // Central corridor - 4 pendulums
-  auto p7 = std::make_unique<Pendulum>(glm::vec3(-17.0f, 8.0f, -7.0f), 6.0f);
-  p7->swingSpeed = 2.3f;
-  p7->transform.scale = glm::vec3(5.0f, 3.0f, 0.5f);
-  p7->updateBoundingBox();
-  objects.push_back(std::move(p7));
-
-  auto p8 = std::make_unique<Pendulum>(glm::vec3(17.0f, 8.0f, -7.0f), 6.0f);
-  p8->swingSpeed = 2.2f;
-  p8->swingAngle = 1.0f;
-  p8->transform.scale = glm::vec3(5.0f, 3.0f, 0.5f);
-  p8->updateBoundingBox();
-  objects.push_back(std::move(p8));
-
-  auto p9 = std::make_unique<Pendulum>(glm::vec3(0.0f, 8.0f, 10.0f), 6.0f);
-  p9->swingSpeed = 2.5f;
-  p9->transform.scale = glm::vec3(5.0f, 3.0f, 0.5f);
-  p9->updateBoundingBox();
-  objects.push_back(std::move(p9));
-
-  auto p10 = std::make_unique<Pendulum>(glm::vec3(0.0f, 8.0f, 25.0f), 6.0f);
-  p10->swingSpeed = 2.0f;
-  p10->swingAngle = 2.5f;
-  p10->transform.scale = glm::vec3(5.0f, 3.0f, 0.5f);
-  p10->updateBoundingBox();
-  objects.push_back(std::move(p10));
-
-  // Southwest area - 2 pendulums
-  auto p11 = std::make_unique<Pendulum>(glm::vec3(-32.0f, 8.0f, 22.0f), 6.0f);
-  p11->swingSpeed = 2.4f;
-  p11->transform.scale = glm::vec3(5.0f, 3.0f, 0.5f);
-  p11->updateBoundingBox();
-  objects.push_back(std::move(p11));
-
-  // Southeast area - 2 pendulums
-  auto p12 = std::make_unique<Pendulum>(glm::vec3(32.0f, 8.0f, 22.0f), 6.0f);
-  p12->swingSpeed = 2.3f;
-  p12->swingAngle = 1.8f;
-  p12->transform.scale = glm::vec3(5.0f, 3.0f, 0.5f);
-  p12->updateBoundingBox();
-  objects.push_back(std::move(p12));
-}
-
 void Level1::createCrumblingTiles() {
   // Strategic trap tiles at key intersections
 
   // Northwest zone entrance
-  objects.push_back(
-      std::make_unique<CrumblingTile>(glm::vec3(-12.0f, 0.1f, -18.0f)));
+  addObject(arena.make<CrumblingTile>(glm::vec3(-12.0f, 0.1f, -18.0f)));
 
   // Northeast zone entrance
-  objects.push_back(
-      std::make_unique<CrumblingTile>(glm::vec3(12.0f, 0.1f, -18.0f)));
+  addObject(arena.make<CrumblingTile>(glm::vec3(12.0f, 0.1f, -18.0f)));
 
   // West wing corridor
-  objects.push_back(
-      std::make_unique<CrumblingTile>(glm::vec3(-18.0f, 0.1f, 5.0f)));
+  addObject(arena.make<CrumblingTile>(glm::vec3(-18.0f, 0.1f, 5.0f)));
 
   // East wing corridor
-  objects.push_back(
-      std::make_unique<CrumblingTile>(glm::vec3(18.0f, 0.1f, 5.0f)));
+  addObject(arena.make<CrumblingTile>(glm::vec3(18.0f, 0.1f, 5.0f)));
 
   // Near exit
-  objects.push_back(
-      std::make_unique<CrumblingTile>(glm::vec3(0.0f, 0.1f, 20.0f)));
-}
-
-void Level1::createCollectible() {
-  // 10 Coins placed in open areas throughout the level (not inside walls)
-  std::vector<glm::vec3> positions = {
-      {-32.0f, 1.5f, -32.0f}, // 1. Northwest
-      {32.0f, 1.5f, -32.0f},  // 2. Northeast
-      {-32.0f, 1.5f, 32.0f},  // 3. Southwest
-      {32.0f, 1.5f, 32.0f},   // 4. Southeast
-      {-17.0f, 1.5f, -25.0f}, // 5. West corridor
-      {17.0f, 1.5f, -25.0f},  // 6. East corridor
-      {0.0f, 1.5f, -32.0f},   // 7. Central north
-      {0.0f, 1.5f, -7.0f},    // 8. Central
-      {-17.0f, 1.5f, 17.0f},  // 9. South central
-      {17.0f, 1.5f, 17.0f}    // 10. Near exit
-  };
-
-  for (const auto &pos : positions) {
-    auto coin =
-        std::make_unique<Collectible>(pos, glm::vec3(1.0f, 0.84f, 0.0f));
-
-    // Load the doubloon model
-    coin->loadModel("assets/models/doubloon.glb");
-
-    // Adjust scale - assuming model is roughly unit size
-    coin->transform.scale = glm::vec3(0.5f);
-
-    // Keep original rotation speed
-    coin->rotationSpeed = 6.0f;
-
-    // Set sound to COIN_COLLECT
-    coin->soundType = SoundEffect::COIN_COLLECT;
-
-    objects.push_back(std::move(coin));
-  }
+  addObject(arena.make<CrumblingTile>(glm::vec3(0.0f, 0.1f, 20.0f)));
 }
 
 void Level1::createForceFieldDoor() {
   float doorZ = 28.0f;
 
   // Load the Old Stone Arch model
-  auto arch = std::make_unique<GameObject>(GameObjectType::STATIC_WALL);
+  auto arch = arena.make<GameObject>(GameObjectType::STATIC_WALL);
   arch->loadModel("assets/models/old_stone_arch.glb");
   // Position at ground level
   arch->transform.position = glm::vec3(0.0f, 0.0f, doorZ);
@@ -368,12 +135,12 @@ void Level1::createForceFieldDoor() {
   arch->isActive = true;
   arch->isTrigger = false;
   arch->updateBoundingBox();
-  objects.push_back(std::move(arch));
+  addObject(std::move(arch));
 
   // The BLOCKING force field - Composite shape
 
   // 1. Base Rectangle
-  auto doorBase = std::make_unique<GameObject>(GameObjectType::DOOR);
+  auto doorBase = arena.make<GameObject>(GameObjectType::DOOR);
   float baseHeight = 2.3f; // Slightly taller base
   float width = 3.0f;      // Wider to fill gaps
   float thickness = 0.2f;
@@ -390,10 +157,10 @@ void Level1::createForceFieldDoor() {
   doorBase->updateBoundingBox();
 
   forceFieldDoor = doorBase.get();
-  objects.push_back(std::move(doorBase)); // Draw after walls (arch)
+  addObject(std::move(doorBase)); // Draw after walls (arch)
 
   // 2. Top Arch (Cylinder)
-  auto doorTop = std::make_unique<GameObject>(GameObjectType::DOOR);
+  auto doorTop = arena.make<GameObject>(GameObjectType::DOOR);
   // Center of cylinder should be at top of base
   doorTop->transform.position = glm::vec3(0.0f, baseHeight, doorZ + 0.05f);
 
@@ -412,58 +179,52 @@ void Level1::createForceFieldDoor() {
   doorTop->updateBoundingBox();
 
   forceFieldArch = doorTop.get();
-  objects.push_back(std::move(doorTop)); // Draw after walls (arch)
+  addObject(std::move(doorTop)); // Draw after walls (arch)
 }
 
 void Level1::update(float deltaTime, Player *player,
                     ParticleSystem *particles) {
   // Custom update logic to track coins and crystal
-  for (auto &obj : objects) {
-    if (!obj->isActive || !obj->isTrigger)
+  for (Collectible *collectible : collectibles) {
+    if (!collectible->isActive || !collectible->isTrigger ||
+        collectible->isCollected)
       continue;
 
-    if (obj->type == GameObjectType::COLLECTIBLE) {
-      if (Physics::checkSphereCollision(player->collisionSphere,
-                                        obj->boundingSphere)) {
-        auto collectible = static_cast<Collectible *>(obj.get());
-        if (!collectible->isCollected) {
-          collectible->collect();
-
-          // Check if this is the energy crystal
-          if (obj.get() == energyCrystal) {
-            // Collected the energy crystal!
-            crystalCollected = true;
-
-            // Start fading the force field
-            if (forceFieldDoor) {
-              forceFieldFading = true;
-              fadeTimer = 0.0f;
-              // Play door open sound
-              AudioManager::getInstance().playSound(SoundEffect::DOOR_OPEN,
-                                                    1.0f);
-            }
-
-            // Blue particle explosion
-            particles->emitExplosion(collectible->transform.position,
-                                     glm::vec3(0.2f, 0.6f, 1.0f), 30);
-          } else {
-            // Regular coin collected
-            coinsCollected++;
-
-            // Emit particle effect
-            particles->emitExplosion(collectible->transform.position,
-                                     glm::vec3(1.0f, 0.8f, 0.2f), 20);
-
-            // Spawn energy crystal after 6 coins
-            if (coinsCollected >= 6 && energyCrystal &&
-                !energyCrystal->isActive) {
-              energyCrystal->isActive = true;
-
-              // Spawn effect for crystal appearing
-              particles->emitExplosion(energyCrystal->transform.position,
-                                       glm::vec3(0.2f, 0.6f, 1.0f), 40);
-            }
-          }
+    if (Physics::checkSphereCollision(player->collisionSphere,
+                                      collectible->boundingSphere)) {
+      collectible->collect();
+
+      // Check if this is the energy crystal
+      if (collectible == energyCrystal) {
+        // Collected the energy crystal!
+        crystalCollected = true;
+
+        // Start fading the force field
+        if (forceFieldDoor) {
+          forceFieldFading = true;
+          fadeTimer = 0.0f;
+          // Play door open sound
+          AudioManager::getInstance().playSound(SoundEffect::DOOR_OPEN, 1.0f);
+        }
+
+        // Blue particle explosion
+        particles->emitExplosion(collectible->transform.position,
+                                 glm::vec3(0.2f, 0.6f, 1.0f), 30);
+      } else {
+        // Regular coin collected
+        coinsCollected++;
+
+        // Emit particle effect
+        particles->emitExplosion(collectible->transform.position,
+                                 glm::vec3(1.0f, 0.8f, 0.2f), 20);
+
+        // Spawn energy crystal after 6 coins
+        if (coinsCollected >= 6 && energyCrystal && !energyCrystal->isActive) {
+          energyCrystal->isActive = true;
+
+          // Spawn effect for crystal appearing
+          particles->emitExplosion(energyCrystal->transform.position,
+                                   glm::vec3(0.2f, 0.6f, 1.0f), 40);
         }
       }
     }
@@ -502,32 +263,29 @@ void Level1::update(float deltaTime, Player *player,
 
   // Check if player is standing on a disappeared crumbling tile
   glm::vec3 playerPos = player->getPosition();
-  for (auto &obj : objects) {
-    if (obj->type == GameObjectType::CRUMBLING_TILE) {
-      auto tile = static_cast<CrumblingTile *>(obj.get());
-      // If tile has fallen and player is still above its original position
-      if (tile->hasFallen && !obj->isActive) {
-        glm::vec3 tilePos = tile->originalPosition;
-        float tileSize = 5.0f; // Match the floor tile size
-
-        // Check if player is above the disappeared tile's original position
-        float heightDiff = playerPos.y - tilePos.y;
-        bool isAboveTile = (heightDiff > 0.0f && heightDiff < 3.0f);
-
-        // Check horizontal overlap
-        bool xOverlap = std::abs(playerPos.x - tilePos.x) < (tileSize / 2.0f);
-        bool zOverlap = std::abs(playerPos.z - tilePos.z) < (tileSize / 2.0f);
-
-        // Only restart if player is grounded (not jumping)
-        // Check if vertical velocity is near zero (player is standing, not
-        // jumping)
-        bool isGrounded = std::abs(player->velocity.y) < 0.5f;
-
-        if (isAboveTile && xOverlap && zOverlap && isGrounded) {
-          // Player is standing where a tile disappeared - restart level
-          shouldRestart = true;
-          return;
-        }
+  for (CrumblingTile *tile : crumblingTiles) {
+    // If tile has fallen and player is still above its original position
+    if (tile->hasFallen && !tile->isActive) {
+      glm::vec3 tilePos = tile->originalPosition;
+      float tileSize = 5.0f; // Match the floor tile size
+
+      // Check if player is above the disappeared tile's original position
+      float heightDiff = playerPos.y - tilePos.y;
+      bool isAboveTile = (heightDiff > 0.0f && heightDiff < 3.0f);
+
+      // Check horizontal overlap
+      bool xOverlap = std::abs(playerPos.x - tilePos.x) < (tileSize / 2.0f);
+      bool zOverlap = std::abs(playerPos.z - tilePos.z) < (tileSize / 2.0f);
+
+      // Only restart if player is grounded (not jumping)
+      // Check if vertical velocity is near zero (player is standing, not
+      // jumping)
+      bool isGrounded = std::abs(player->velocity.y) < 0.5f;
+
+      if (isAboveTile && xOverlap && zOverlap && isGrounded) {
+        // Player is standing where a tile disappeared - restart level
+        shouldRestart = true;
+        return;
       }
     }
   }
@@ -576,7 +334,7 @@ void Level1::createCheckeredFloor() {
       if (isCrumbling) {
         // Create crumbling tile with orange color at ground level
         auto crumblingTile =
-            std::make_unique<CrumblingTile>(glm::vec3(x, -0.5f, z));
+            arena.make<CrumblingTile>(glm::vec3(x, -0.5f, z));
         crumblingTile->transform.scale = glm::vec3(tileSize, 1.0f, tileSize);
         crumblingTile->color =
             glm::vec3(0.9f, 0.5f, 0.2f); // Bright orange for crumbling tiles
@@ -594,10 +352,10 @@ void Level1::createCheckeredFloor() {
         crumblingTile->originalPosition = glm::vec3(x, -0.5f, z);
         crumblingTile->fallTimer = 2.0f; // 2 seconds before falling
         crumblingTile->updateBoundingBox();
-        objects.push_back(std::move(crumblingTile));
+        addObject(std::move(crumblingTile));
       } else {
         // Create regular static tile
-        auto tile = std::make_unique<GameObject>(GameObjectType::STATIC_WALL);
+        auto tile = arena.make<GameObject>(GameObjectType::STATIC_WALL);
         tile->transform.position = glm::vec3(x, -0.5f, z);
         tile->transform.scale = glm::vec3(tileSize, 1.0f, tileSize);
         tile->mesh.reset(Mesh::createCube(1.0f));
@@ -615,3 +373,19 @@ void Level1::createCheckeredFloor() {
     }
   }
 }
+
+void Level1::saveState(StateBuffer &state) const {
+  Level::saveState(state);
+  state.write(coinsCollected);
+  state.write(crystalCollected);
+  state.write(forceFieldFading);
+  state.write(fadeTimer);
+}
+
+void Level1::restoreState(StateBuffer &state) {
+  Level::restoreState(state);
+  state.read(coinsCollected);
+  state.read(crystalCollected);
+  state.read(forceFieldFading);
+  state.read(fadeTimer);
+}
@@ -10,22 +10,20 @@ Level2::Level2()
 
 void Level2::init() {
   createCavern();
-  createStalactites();
-  createGeysers();
-  createSkeletons(); // Add skeletons in corners
+  loadLayout("levels/level2"); // Stalactites, vents and their rocks, boulders
+  createSkeletons();           // Add skeletons in corners
   createCollectible();
   createPedestal();
-  createScatteredRocks();
   setupLighting();
 
   // Create health pickups in Level 2 (2 pickups in different areas)
   auto healthPickup1 =
-      std::make_unique<HealthPickup>(glm::vec3(-15.0f, 1.5f, 10.0f));
-  objects.push_back(std::move(healthPickup1));
+      arena.make<HealthPickup>(glm::vec3(-15.0f, 1.5f, 10.0f));
+  addObject(std::move(healthPickup1));
 
   auto healthPickup2 =
-      std::make_unique<HealthPickup>(glm::vec3(18.0f, 1.5f, -12.0f));
-  objects.push_back(std::move(healthPickup2));
+      arena.make<HealthPickup>(glm::vec3(18.0f, 1.5f, -12.0f));
+  addObject(std::move(healthPickup2));
 }
 
 void Level2::createCavern() {
@@ -117,7 +115,7 @@ void Level2::createCavern() {
                                                 (rand() % 4 - 2) / 100.0f);
 
     // Create oriented rectangular segment
-    auto mudSegment = std::make_unique<GameObject>(GameObjectType::STATIC_WALL);
+    auto mudSegment = arena.make<GameObject>(GameObjectType::STATIC_WALL);
     mudSegment->transform.position = glm::vec3(midpoint.x, 0.02f, midpoint.y);
     mudSegment->transform.scale = glm::vec3(pathWidth, 0.08f, length + 0.5f);
     mudSegment->transform.rotate(
@@ -139,7 +137,7 @@ void Level2::createCavern() {
                                               (rand() % 3 - 1) / 100.0f);
 
     // Create circular cap using cylinder (flat disc)
-    auto cap = std::make_unique<GameObject>(GameObjectType::STATIC_WALL);
+    auto cap = arena.make<GameObject>(GameObjectType::STATIC_WALL);
     cap->transform.position = glm::vec3(pos.x, 0.025f, pos.y);
     cap->transform.scale =
         glm::vec3(pathWidth * 0.55f, 0.06f,
@@ -153,80 +151,6 @@ void Level2::createCavern() {
   }
 }
 
-void Level2::createStalactites() {
-  // Create 50 stalactites - distributed across 60x60 space
-  std::vector<glm::vec3> stalactitePositions;
-
-  // Generate 50 stalactites in a grid pattern with some randomness
-  for (int i = 0; i < 50; i++) {
-    float x = -25.0f + (i % 10) * 5.5f + (rand() % 100 - 50) / 50.0f;
-    float z = -25.0f + (i / 10) * 11.0f + (rand() % 100 - 50) / 50.0f;
-    stalactitePositions.push_back(glm::vec3(x, 13.0f, z));
-  }
-
-  for (const auto &pos : stalactitePositions) {
-    auto stalactite = std::make_unique<Stalactite>(pos);
-    // Make them much bigger - 2x scale
-    stalactite->transform.scale = glm::vec3(0.8f, 4.0f, 0.8f); // Twice as big
-    stalactite->updateBoundingBox();
-    objects.push_back(std::move(stalactite));
-  }
-}
-
-void Level2::createGeysers() {
-  // Create geyser vents in the floor - Many more for 60x60 space
-  std::vector<glm::vec3> geyserPositions = {
-      // Outer ring
-      glm::vec3(-22.0f, 0.0f, -22.0f), glm::vec3(22.0f, 0.0f, -22.0f),
-      glm::vec3(-22.0f, 0.0f, 22.0f), glm::vec3(22.0f, 0.0f, 22.0f),
-
-      // Mid ring
-      glm::vec3(-15.0f, 0.0f, -15.0f), glm::vec3(15.0f, 0.0f, -15.0f),
-      glm::vec3(-15.0f, 0.0f, 15.0f), glm::vec3(15.0f, 0.0f, 15.0f),
-
-      // Cardinal directions
-      glm::vec3(0.0f, 0.0f, -20.0f), glm::vec3(0.0f, 0.0f, 20.0f),
-      glm::vec3(-20.0f, 0.0f, 0.0f), glm::vec3(20.0f, 0.0f, 0.0f),
-
-      // Inner area
-      glm::vec3(-8.0f, 0.0f, -8.0f), glm::vec3(8.0f, 0.0f, -8.0f),
-      glm::vec3(-8.0f, 0.0f, 8.0f), glm::vec3(8.0f, 0.0f, 8.0f),
-      glm::vec3(0.0f, 0.0f, -5.0f), glm::vec3(0.0f, 0.0f, 5.0f)};
-
-  for (const auto &pos : geyserPositions) {
-    auto geyser = std::make_unique<Geyser>(pos);
-    objects.push_back(std::move(geyser));
-
-    // Add a complete tight circle of rocks around each vent using rock model
-    int numRocks = 14 + (rand() % 3); // 14-16 rocks for complete circle
-    for (int r = 0; r < numRocks; r++) {
-      // Evenly spaced around the circle
-      float angle = (float)r / numRocks * 2.0f * 3.14159f;
-      float distance =
-          2.2f + (rand() % 30) / 100.0f; // 2.2-2.5 units from center
-
-      float rockX = pos.x + cos(angle) * distance;
-      float rockZ = pos.z + sin(angle) * distance;
-
-      // Rock scale
-      float rockScale =
-          0.25f + (rand() % 15) / 100.0f; // 0.25-0.40 scale (larger rocks)
-
-      auto rock = std::make_unique<GameObject>(GameObjectType::STATIC_WALL);
-      rock->transform.position = glm::vec3(rockX, 0.0f, rockZ);
-      rock->transform.scale = glm::vec3(rockScale);
-      // Random rotation for variety
-      rock->transform.rotate((rand() % 360) * 3.14159f / 180.0f,
-                             glm::vec3(0, 1, 0));
-      rock->loadCachedModel("assets/models/random_rock.glb");
-      rock->color = glm::vec3(0.55f, 0.48f, 0.40f); // Light brown-gray
-      rock->materialType = 4;                       // Cave rock texture
-      rock->updateBoundingBox();
-      objects.push_back(std::move(rock));
-    }
-  }
-}
-
 void Level2::createSkeletons() {
   // Add skeleton models in each corner of the cave AND near pedestal
   std::vector<std::pair<glm::vec3, float>> positions = {
@@ -243,7 +167,7 @@ void Level2::createSkeletons() {
       {{0.0f, 0.0f, -12.0f}, 180.0f}};
 
   for (const auto &[pos, rotation] : positions) {
-    auto skeleton = std::make_unique<GameObject>(GameObjectType::STATIC_WALL);
+    auto skeleton = arena.make<GameObject>(GameObjectType::STATIC_WALL);
     skeleton->transform.position = pos;
     // Scale 0.1 seems correct provided model is reasonable size.
     // If invisible, model might be offset. Ensure Y is correct.
@@ -257,13 +181,13 @@ void Level2::createSkeletons() {
     skeleton->boundingBox =
         Physics::createAABBFromTransform(pos, glm::vec3(1.5f, 3.0f, 1.5f));
 
-    objects.push_back(std::move(skeleton));
+    addObject(std::move(skeleton));
   }
 }
 
 void Level2::createCollectible() {
   // Glowing Gemstone - placed far from pedestal in corner
-  auto gemstone = std::make_unique<Collectible>(
+  auto gemstone = arena.make<Collectible>(
       glm::vec3(-20.0f, 2.0f, -20.0f), // Far northwest corner
       glm::vec3(0.9f, 0.2f, 0.2f)      // Red
   );
@@ -275,22 +199,22 @@ void Level2::createCollectible() {
 
   gemCollectible = gemstone.get();               // Store reference for cutscene
   gemOriginalPos = gemstone->transform.position; // Store original position
-  objects.push_back(std::move(gemstone));
+  addObject(std::move(gemstone));
 
   // Rock base for the gem (embedded look)
-  auto rockBase = std::make_unique<GameObject>(GameObjectType::STATIC_WALL);
+  auto rockBase = arena.make<GameObject>(GameObjectType::STATIC_WALL);
   rockBase->transform.position = glm::vec3(-20.0f, 1.5f, -20.0f);
   rockBase->transform.scale = glm::vec3(0.6f, 0.4f, 0.6f);
   rockBase->mesh.reset(Mesh::createCube(1.0f));
   rockBase->color = glm::vec3(0.3f, 0.25f, 0.2f); // Rock color
   rockBase->materialType = 3;                     // Rock texture
   rockBase->updateBoundingBox();
-  objects.push_back(std::move(rockBase));
+  addObject(std::move(rockBase));
 }
 
 void Level2::createPedestal() {
   // Ancient stone pedestal - Moved further back
-  auto ped = std::make_unique<GameObject>(GameObjectType::PEDESTAL);
+  auto ped = arena.make<GameObject>(GameObjectType::PEDESTAL);
   ped->transform.position = glm::vec3(0.0f, 0.5f, 15.0f);
 
   // Load new model
@@ -304,97 +228,7 @@ void Level2::createPedestal() {
   ped->isTrigger = true;
 
   pedestal = ped.get();
-  objects.push_back(std::move(ped));
-}
-
-void Level2::createScatteredRocks() {
-  // Geyser positions to avoid (same as in createGeysers)
-  std::vector<glm::vec3> geyserPositions = {
-      // Outer ring
-      glm::vec3(-22.0f, 0.0f, -22.0f), glm::vec3(22.0f, 0.0f, -22.0f),
-      glm::vec3(-22.0f, 0.0f, 22.0f), glm::vec3(22.0f, 0.0f, 22.0f),
-      // Mid ring
-      glm::vec3(-15.0f, 0.0f, -15.0f), glm::vec3(15.0f, 0.0f, -15.0f),
-      glm::vec3(-15.0f, 0.0f, 15.0f), glm::vec3(15.0f, 0.0f, 15.0f),
-      // Cardinal directions
-      glm::vec3(0.0f, 0.0f, -20.0f), glm::vec3(0.0f, 0.0f, 20.0f),
-      glm::vec3(-20.0f, 0.0f, 0.0f), glm::vec3(20.0f, 0.0f, 0.0f),
-      // Inner area
-      glm::vec3(-8.0f, 0.0f, -8.0f), glm::vec3(8.0f, 0.0f, -8.0f),
-      glm::vec3(-8.0f, 0.0f, 8.0f), glm::vec3(8.0f, 0.0f, 8.0f),
-      glm::vec3(0.0f, 0.0f, -5.0f), glm::vec3(0.0f, 0.0f, 5.0f)};
-
-  // Grid-based distribution for even spread
-  int gridSize = 12;
-  float roomSize = 58.0f; // Slightly less than 60
-  float cellSize = roomSize / gridSize;
-
-  for (int x = 0; x < gridSize; x++) {
-    for (int z = 0; z < gridSize; z++) {
-      // Determine number of rocks in this cell (0, 1, or 2)
-      // Higher chance of 1 or 2 rocks
-      int numRocks = rand() % 3;
-      if (numRocks == 0 && (rand() % 4 != 0))
-        numRocks = 1; // Reduce empty cells
-
-      // REDUCE TOTAL ROCKS: Skip 25% of cells that would have had rocks
-      // to achieve 0.75 of the previous amount
-      if (numRocks > 0 && (rand() % 4 == 0)) {
-        numRocks = 0;
-      }
-
-      for (int i = 0; i < numRocks; i++) {
-        float cellCenterX = -roomSize / 2.0f + x * cellSize + cellSize / 2.0f;
-        float cellCenterZ = -roomSize / 2.0f + z * cellSize + cellSize / 2.0f;
-
-        // Random offset within cell
-        float offsetX = (rand() % 100 - 50) / 100.0f * (cellSize * 0.4f);
-        float offsetZ = (rand() % 100 - 50) / 100.0f * (cellSize * 0.4f);
-
-        float posX = cellCenterX + offsetX;
-        float posZ = cellCenterZ + offsetZ;
-
-        // Check distance to vents
-        bool tooClose = false;
-        for (const auto &ventPos : geyserPositions) {
-          float dist = glm::distance(glm::vec2(posX, posZ),
-                                     glm::vec2(ventPos.x, ventPos.z));
-          if (dist < 4.0f) { // Keep clear of vents
-            tooClose = true;
-            break;
-          }
-        }
-
-        if (tooClose)
-          continue;
-
-        // Check distance to start position to ensure player isn't trapped
-        if (glm::distance(glm::vec2(posX, posZ),
-                          glm::vec2(playerStartPosition.x,
-                                    playerStartPosition.z)) < 3.0f) {
-          continue;
-        }
-
-        // Spawn rock
-        auto rock = std::make_unique<GameObject>(GameObjectType::STATIC_WALL);
-        rock->transform.position = glm::vec3(posX, 0.0f, posZ);
-        rock->transform.scale = glm::vec3(0.01f); // 0.01x scale
-        rock->transform.rotate((rand() % 360) * 3.14159f / 180.0f,
-                               glm::vec3(0, 1, 0));
-        rock->loadCachedModel("assets/models/rock_shopk_mid.glb");
-
-        // CRITICAL FIX: Manually set bounding box size!
-        // The scale 0.01 makes the auto-computed bounding box tiny (1cm).
-        // The visual model is actually large. We strictly define a smaller unit
-        // box for collision. Reduced by 0.6x from previous (2.5, 2.0, 2.5) ->
-        // (1.5, 1.2, 1.5)
-        rock->boundingBox = Physics::createAABBFromTransform(
-            rock->transform.position, glm::vec3(1.5f, 1.2f, 1.5f));
-
-        walls.push_back(std::move(rock)); // Use walls vector for collision
-      }
-    }
-  }
+  addObject(std::move(ped));
 }
 
 void Level2::setupLighting() {
@@ -415,10 +249,10 @@ void Level2::setupLighting() {
 
   for (const auto &pos : torchPositions) {
     // Create visual torch model
-    auto torchModel = std::make_unique<GameObject>(GameObjectType::STATIC_WALL);
+    auto torchModel = arena.make<GameObject>(GameObjectType::STATIC_WALL);
 
     // Create rock holder model (new feature)
-    auto rockHolder = std::make_unique<GameObject>(GameObjectType::STATIC_WALL);
+    auto rockHolder = arena.make<GameObject>(GameObjectType::STATIC_WALL);
 
     // Load models
     torchModel->loadCachedModel("assets/models/medieval_torch.glb");
@@ -465,13 +299,13 @@ void Level2::setupLighting() {
     torchModel->transform.position = adjustedPos;
     torchModel->color = glm::vec3(1.0f, 0.5f, 0.2f); // Glowing orange tint
     torchModel->updateBoundingBox();
-    objects.push_back(std::move(torchModel));
+    addObject(std::move(torchModel));
 
     // Position rock slightly below/integrated with torch
     rockHolder->transform.position = adjustedPos;     // Same base pos
     rockHolder->color = glm::vec3(0.5f, 0.45f, 0.4f); // Rock color
     rockHolder->updateBoundingBox();
-    objects.push_back(std::move(rockHolder));
+    addObject(std::move(rockHolder));
 
     // Create light
     Light torch;
@@ -494,131 +328,105 @@ void Level2::update(float deltaTime, Player *player,
   Level::update(deltaTime, player, particles);
 
   // Check stalactite triggers (proximity) and collisions
-  for (auto &obj : objects) {
-    if (obj->type == GameObjectType::STALACTITE && obj->isActive) {
-      Stalactite *stal = dynamic_cast<Stalactite *>(obj.get());
-      if (stal) {
-        glm::vec2 playerPosXZ(player->getPosition().x, player->getPosition().z);
-        glm::vec2 stalPosXZ(stal->transform.position.x,
-                            stal->transform.position.z);
-        float dist = glm::length(playerPosXZ - stalPosXZ);
-
-        if (!stal->isFalling) {
-          // Only trigger if player is BELOW the stalactite (not just nearby)
-          // Check horizontal distance AND vertical position
-          // Bigger trigger radius: 3.5 units
-          if (dist < 3.5f) {
-            // Player must be below the stalactite
-            float playerY = player->getPosition().y;
-            float stalY = stal->transform.position.y;
-
-            // Only fall if player is below (stalactite is higher than player)
-            if (stalY > playerY + 1.0f) { // At least 1 unit above player
-              stal->onTrigger();
-            }
-          }
-        } else {
-          // Check collision with falling stalactite (bigger hitbox: 2.0 units)
-          if (dist < 2.0f) {
-            // Check if stalactite is at player height
-            float heightDiff =
-                std::abs(stal->transform.position.y - player->getPosition().y);
-            if (heightDiff < 2.0f) {
-              // Hit detected!
-              stalactiteHits++;
-
-              // Take heart damage
-              player->takeDamage();
-
-              // Play impact sound
-              AudioManager::getInstance().playSound(SoundEffect::OBSTACLE_HIT,
-                                                    0.8f);
-
-              // Strong pushback
-              glm::vec3 pushDir =
-                  glm::normalize(glm::vec3(playerPosXZ.x - stalPosXZ.x, 0.0f,
-                                           playerPosXZ.y - stalPosXZ.y));
-              player->transform.position += pushDir * 8.0f; // Strong pushback
-
-              // Emit impact particles
-              particles->emitExplosion(
-                  stal->transform.position,
-                  glm::vec3(0.6f, 0.4f, 0.3f), // Rock color
-                  25);
-
-              // Deactivate stalactite
-              stal->isActive = false;
-
-              // Check if player has been hit 3 times - reset to Level 1
-              if (stalactiteHits >= 3) {
-                shouldResetToLevel1 = true;
-                return;
-              }
-            }
-          }
-        }
+  glm::vec3 playerPos = player->getPosition();
+  glm::vec2 playerPosXZ(playerPos.x, playerPos.z);
+
+  for (size_t i = 0; i < entities.stalactites.size(); i++) {
+    uint32_t id = entities.stalactiteIds[i];
+    if (!entities.render[id].active)
+      continue;
+
+    const glm::vec3 &stalPos = entities.transforms[id].position;
+    glm::vec2 stalPosXZ(stalPos.x, stalPos.z);
+    float dist = glm::length(playerPosXZ - stalPosXZ);
+
+    if (!entities.stalactites[i].isFalling) {
+      // Only trigger if player is BELOW the stalactite (not just nearby)
+      // Check horizontal distance AND vertical position
+      // Bigger trigger radius: 3.5 units
+      // Stalactite must be at least 1 unit above the player
+      if (dist < 3.5f && stalPos.y > playerPos.y + 1.0f) {
+        entities.triggerStalactite(i);
+      }
+    } else if (dist < 2.0f && std::abs(stalPos.y - playerPos.y) < 2.0f) {
+      // Falling stalactite at player height (bigger hitbox: 2.0 units)
+      stalactiteHits++;
+
+      // Take heart damage
+      player->takeDamage();
+
+      // Play impact sound
+      AudioManager::getInstance().playSound(SoundEffect::OBSTACLE_HIT, 0.8f);
+
+      // Strong pushback
+      glm::vec3 pushDir =
+          glm::normalize(glm::vec3(playerPosXZ.x - stalPosXZ.x, 0.0f,
+                                   playerPosXZ.y - stalPosXZ.y));
+      player->transform.position += pushDir * 8.0f; // Strong pushback
+      playerPos = player->getPosition();
+      playerPosXZ = glm::vec2(playerPos.x, playerPos.z);
+
+      // Emit impact particles
+      particles->emitExplosion(stalPos,
+                               glm::vec3(0.6f, 0.4f, 0.3f), // Rock color
+                               25);
+
+      // Deactivate stalactite
+      entities.render[id].active = false;
+
+      // Check if player has been hit 3 times - reset to Level 1
+      if (stalactiteHits >= 3) {
+        shouldResetToLevel1 = true;
+        return;
       }
     }
   }
 
-  // Check geyser push
-  for (auto &obj : objects) {
-    if (obj->type == GameObjectType::GEYSER && obj->isActive) {
-      Geyser *geyser = dynamic_cast<Geyser *>(obj.get());
-      if (geyser && geyser->isErupting) {
-        // Check if player is above the geyser (in the steam column)
-        glm::vec3 playerPos = player->getPosition();
-        glm::vec3 geyserPos = geyser->transform.position;
-
-        // Check horizontal distance (XZ plane)
-        glm::vec2 playerPosXZ(playerPos.x, playerPos.z);
-        glm::vec2 geyserPosXZ(geyserPos.x, geyserPos.z);
-        float horizontalDist = glm::length(playerPosXZ - geyserPosXZ);
-
-        // Check if player is within geyser radius and above it
-        float geyserRadius = 1.5f; // Much larger radius for bigger hitbox
-        float steamHeight = 5.0f;  // Height of steam column
-
-        bool inSteamColumn = (horizontalDist < geyserRadius) &&
-                             (playerPos.y >= geyserPos.y) &&
-                             (playerPos.y < geyserPos.y + steamHeight);
-
-        if (inSteamColumn) {
-          // Calculate pushback direction (away from geyser center)
-          glm::vec2 horizontalDir = playerPosXZ - geyserPosXZ;
-
-          if (horizontalDist > 0.01f) {
-            horizontalDir = glm::normalize(horizontalDir);
-          } else {
-            horizontalDir = glm::vec2(1.0f, 0.0f); // Default direction
-          }
-
-          // Combined push force: upward + outward (way stronger)
-          glm::vec3 totalPush = glm::vec3(
-              horizontalDir.x * 20.0f, // Much stronger horizontal pushback
-              35.0f,                   // Much stronger upward force
-              horizontalDir.y * 20.0f  // Much stronger horizontal pushback
-          );
-
-          player->transform.position += totalPush * deltaTime;
-
-          // Take heart damage once per geyser contact (using flash as cooldown)
-          if (player->damageFlashIntensity < 0.1f) {
-            player->takeDamage();
-          }
-        }
+  // Check geyser push (steam particles are emitted by the geyser system)
+  for (size_t i = 0; i < entities.geysers.size(); i++) {
+    uint32_t id = entities.geyserIds[i];
+    if (!entities.render[id].active || !entities.isGeyserErupting(i))
+      continue;
+
+    // Check if player is above the geyser (in the steam column)
+    playerPos = player->getPosition();
+    glm::vec3 geyserPos = entities.transforms[id].position;
+
+    // Check horizontal distance (XZ plane)
+    playerPosXZ = glm::vec2(playerPos.x, playerPos.z);
+    glm::vec2 geyserPosXZ(geyserPos.x, geyserPos.z);
+    float horizontalDist = glm::length(playerPosXZ - geyserPosXZ);
+
+    // Check if player is within geyser radius and above it
+    float geyserRadius = 1.5f; // Much larger radius for bigger hitbox
+    float steamHeight = 5.0f;  // Height of steam column
+
+    bool inSteamColumn = (horizontalDist < geyserRadius) &&
+                         (playerPos.y >= geyserPos.y) &&
+                         (playerPos.y < geyserPos.y + steamHeight);
 
-        // Emit steam particles
-        // White/Grey color, moving up
-        particles->emit(
-            geyser->transform.position +
-                glm::vec3(0.0f, 0.5f, 0.0f),   // Start slightly above vent
-            glm::vec3(0.0f, 5.0f, 0.0f),       // Upward velocity
-            glm::vec4(0.8f, 0.8f, 0.9f, 0.5f), // White-ish steam
-            0.3f,                              // Larger particles
-            1.0f,                              // Lifetime
-            8                                  // More particles per frame
-        );
+    if (inSteamColumn) {
+      // Calculate pushback direction (away from geyser center)
+      glm::vec2 horizontalDir = playerPosXZ - geyserPosXZ;
+
+      if (horizontalDist > 0.01f) {
+        horizontalDir = glm::normalize(horizontalDir);
+      } else {
+        horizontalDir = glm::vec2(1.0f, 0.0f); // Default direction
+      }
+
+      // Combined push force: upward + outward (way stronger)
+      glm::vec3 totalPush = glm::vec3(
+          horizontalDir.x * 20.0f, // Much stronger horizontal pushback
+          35.0f,                   // Much stronger upward force
+          horizontalDir.y * 20.0f  // Much stronger horizontal pushback
+      );
+
+      player->transform.position += totalPush * deltaTime;
+
+      // Take heart damage once per geyser contact (using flash as cooldown)
+      if (player->damageFlashIntensity < 0.1f) {
+        player->takeDamage();
       }
     }
   }
@@ -727,3 +535,25 @@ void Level2::update(float deltaTime, Player *player,
     }
   }
 }
+
+void Level2::saveState(StateBuffer &state) const {
+  Level::saveState(state);
+  state.write(gemPlaced);
+  state.write(stalactiteHits);
+  state.write(endingCutscene);
+  state.write(cutsceneTimer);
+  state.write(gemOriginalPos);
+  state.write(gemShakeOffset);
+  state.write(pedestalRiseAmount);
+}
+
+void Level2::restoreState(StateBuffer &state) {
+  Level::restoreState(state);
+  state.read(gemPlaced);
+  state.read(stalactiteHits);
+  state.read(endingCutscene);
+  state.read(cutsceneTimer);
+  state.read(gemOriginalPos);
+  state.read(gemShakeOffset);
+  state.read(pedestalRiseAmount);
+}
@@ -0,0 +1,452 @@
+#include "LevelData.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+const char kLevelMagic[4] = {'C', 'G', 'L', 'V'};
+
+const uint32_t kRecordSizes[] = {
+    1, // STRINGS
+    sizeof(WallRecord),       sizeof(PendulumRecord), sizeof(StalactiteRecord),
+    sizeof(GeyserRecord),     sizeof(LightRecord),    sizeof(PropRecord),
+    sizeof(CoinRecord)};
+static_assert(sizeof(kRecordSizes) / sizeof(kRecordSizes[0]) ==
+                  static_cast<size_t>(LevelSectionType::COUNT),
+              "Every section type needs a record size");
+
+// Records collected from the text source, before layout
+struct LevelSource {
+  std::vector<char> strings;
+  std::map<std::string, uint32_t> stringOffsets;
+  std::vector<WallRecord> walls;
+  std::vector<PendulumRecord> pendulums;
+  std::vector<StalactiteRecord> stalactites;
+  std::vector<GeyserRecord> geysers;
+  std::vector<LightRecord> lights;
+  std::vector<PropRecord> props;
+  std::vector<CoinRecord> coins;
+
+  uint32_t intern(const std::string &text) {
+    auto it = stringOffsets.find(text);
+    if (it != stringOffsets.end())
+      return it->second;
+    uint32_t offset = static_cast<uint32_t>(strings.size());
+    strings.insert(strings.end(), text.begin(), text.end());
+    strings.push_back('\0');
+    stringOffsets[text] = offset;
+    return offset;
+  }
+};
+
+bool readFloats(std::istringstream &line, float *values, int count) {
+  for (int i = 0; i < count; i++) {
+    if (!(line >> values[i]))
+      return false;
+  }
+  return true;
+}
+
+// A trailing optional field: keeps `value` when the line has ended, fails on
+// a token that is not entirely a number (a failed >> would store 0 and leave
+// the stream looking finished)
+template <typename T>
+bool readOptional(std::istringstream &line, T &value) {
+  std::string token;
+  if (!(line >> token))
+    return true;
+  std::istringstream field(token);
+  T parsed;
+  if (!(field >> parsed) || !(field >> std::ws).eof())
+    return false;
+  value = parsed;
+  return true;
+}
+
+bool parseSound(const std::string &name, uint32_t &sound) {
+  if (name == "pickup")
+    sound = static_cast<uint32_t>(LevelSound::PICKUP);
+  else if (name == "coin")
+    sound = static_cast<uint32_t>(LevelSound::COIN);
+  else if (name == "gem")
+    sound = static_cast<uint32_t>(LevelSound::GEM);
+  else
+    return false;
+  return true;
+}
+
+// Parses one non-empty line. Returns false on a malformed line.
+bool parseLine(const std::string &keyword, std::istringstream &line,
+               LevelSource &source) {
+  if (keyword == "wall") {
+    WallRecord wall;
+    if (!readFloats(line, wall.position, 3) || !readFloats(line, wall.size, 3) ||
+        !readFloats(line, wall.color, 3))
+      return false;
+    wall.materialType = 0;
+    if (!readOptional(line, wall.materialType))
+      return false;
+    source.walls.push_back(wall);
+  } else if (keyword == "pendulum") {
+    PendulumRecord pendulum;
+    if (!readFloats(line, pendulum.pivot, 3) ||
+        !readFloats(line, &pendulum.length, 1) ||
+        !readFloats(line, &pendulum.swingSpeed, 1) ||
+        !readFloats(line, &pendulum.phase, 1) ||
+        !readFloats(line, pendulum.size, 3))
+      return false;
+    source.pendulums.push_back(pendulum);
+  } else if (keyword == "stalactite") {
+    StalactiteRecord stalactite;
+    if (!readFloats(line, stalactite.position, 3) ||
+        !readFloats(line, stalactite.size, 3))
+      return false;
+    source.stalactites.push_back(stalactite);
+  } else if (keyword == "geyser") {
+    GeyserRecord geyser;
+    if (!readFloats(line, geyser.position, 3))
+      return false;
+    source.geysers.push_back(geyser);
+  } else if (keyword == "light") {
+    LightRecord light;
+    if (!readFloats(line, light.position, 3) ||
+        !readFloats(line, light.color, 3) ||
+        !readFloats(line, &light.intensity, 1))
+      return false;
+    light.fixtureScale = 0.0f;
+    if (!readOptional(line, light.fixtureScale))
+      return false;
+    source.lights.push_back(light);
+  } else if (keyword == "prop") {
+    PropRecord prop;
+    std::string model;
+    float yawDegrees;
+    if (!(line >> model) || !readFloats(line, prop.position, 3) ||
+        !readFloats(line, &prop.scale, 1) || !readFloats(line, &yawDegrees, 1) ||
+        !readFloats(line, prop.color, 3) || !(line >> prop.materialType))
+      return false;
+    prop.model = source.intern(model);
+    prop.yaw = yawDegrees * 3.14159265f / 180.0f;
+    prop.flags = 0;
+    std::memset(prop.collisionSize, 0, sizeof(prop.collisionSize));
+
+    std::string option;
+    if (line >> option) {
+      if (option != "solid" || !readFloats(line, prop.collisionSize, 3))
+        return false;
+      prop.flags |= PROP_SOLID;
+    }
+    source.props.push_back(prop);
+  } else if (keyword == "coin") {
+    CoinRecord coin;
+    std::string model, sound;
+    if (!(line >> model) || !readFloats(line, coin.position, 3) ||
+        !readFloats(line, coin.color, 3) || !readFloats(line, &coin.scale, 1) ||
+        !readFloats(line, &coin.rotationSpeed, 1) || !(line >> sound) ||
+        !parseSound(sound, coin.sound))
+      return false;
+    coin.model = source.intern(model);
+    source.coins.push_back(coin);
+  } else {
+    return false;
+  }
+
+  // Anything left over is a mistake (a comment was already stripped)
+  std::string extra;
+  return !(line >> extra);
+}
+
+// Appends a section's records and fills in its table entry
+template <typename T>
+void writeSection(std::vector<unsigned char> &binary, LevelSection &section,
+                  LevelSectionType type, const std::vector<T> &records) {
+  while (binary.size() % 4 != 0)
+    binary.push_back(0);
+  section.type = static_cast<uint32_t>(type);
+  section.count = static_cast<uint32_t>(records.size());
+  section.offset = static_cast<uint32_t>(binary.size());
+  section.stride = sizeof(T);
+  if (records.empty())
+    return;
+  size_t offset = binary.size();
+  binary.resize(offset + records.size() * sizeof(T));
+  std::memcpy(binary.data() + offset, records.data(),
+              records.size() * sizeof(T));
+}
+} // namespace
+
+LevelData::LevelData()
+    : walls(nullptr), wallCount(0), pendulums(nullptr), pendulumCount(0),
+      stalactites(nullptr), stalactiteCount(0), geysers(nullptr),
+      geyserCount(0), lights(nullptr), lightCount(0), props(nullptr),
+      propCount(0), coins(nullptr), coinCount(0), mapping(nullptr), size(0),
+      strings(nullptr), stringBytes(0) {}
+
+LevelData::~LevelData() { release(); }
+
+void LevelData::release() {
+#ifndef _WIN32
+  if (mapping)
+    munmap(mapping, size);
+#endif
+  mapping = nullptr;
+  size = 0;
+  owned.clear();
+  strings = nullptr;
+  stringBytes = 0;
+  walls = nullptr;
+  pendulums = nullptr;
+  stalactites = nullptr;
+  geysers = nullptr;
+  lights = nullptr;
+  props = nullptr;
+  coins = nullptr;
+  wallCount = pendulumCount = stalactiteCount = geyserCount = lightCount =
+      propCount = coinCount = 0;
+}
+
+bool LevelData::load(const std::string &basePath) {
+  std::ifstream binary(basePath + ".lvl");
+  if (binary.good()) {
+    binary.close();
+    if (loadBinary(basePath + ".lvl"))
+      return true;
+    std::cout << "Falling back to the level source " << basePath << ".txt"
+              << std::endl;
+  }
+  return loadText(basePath + ".txt");
+}
+
+bool LevelData::loadBinary(const std::string &path) {
+  release();
+
+#ifndef _WIN32
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    std::cerr << "ERROR::LEVEL::CANNOT_OPEN " << path << std::endl;
+    return false;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+    close(fd);
+    std::cerr << "ERROR::LEVEL::EMPTY_FILE " << path << std::endl;
+    return false;
+  }
+  size_t fileSize = static_cast<size_t>(info.st_size);
+  void *view = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd); // The mapping keeps the file alive
+  if (view == MAP_FAILED) {
+    std::cerr << "ERROR::LEVEL::MMAP_FAILED " << path << std::endl;
+    return false;
+  }
+  mapping = view;
+  size = fileSize;
+  if (!bind(static_cast<const unsigned char *>(view), fileSize, path)) {
+    release();
+    return false;
+  }
+  return true;
+#else
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    std::cerr << "ERROR::LEVEL::CANNOT_OPEN " << path << std::endl;
+    return false;
+  }
+  owned.assign(std::istreambuf_iterator<char>(file),
+               std::istreambuf_iterator<char>());
+  size = owned.size();
+  if (!bind(owned.data(), owned.size(), path)) {
+    release();
+    return false;
+  }
+  return true;
+#endif
+}
+
+bool LevelData::loadText(const std::string &path) {
+  release();
+
+  std::ifstream file(path);
+  if (!file) {
+    std::cerr << "ERROR::LEVEL::CANNOT_OPEN " << path << std::endl;
+    return false;
+  }
+  std::stringstream source;
+  source << file.rdbuf();
+
+  std::vector<unsigned char> binary;
+  std::string error;
+  if (!compile(source.str(), binary, error)) {
+    std::cerr << "ERROR::LEVEL::PARSE " << path << ":" << error << std::endl;
+    return false;
+  }
+
+  owned.swap(binary);
+  size = owned.size();
+  if (!bind(owned.data(), owned.size(), path)) {
+    release();
+    return false;
+  }
+  return true;
+}
+
+bool LevelData::compile(const std::string &text,
+                        std::vector<unsigned char> &binary,
+                        std::string &error) {
+  LevelSource source;
+  std::istringstream input(text);
+  std::string line;
+  int lineNumber = 0;
+  while (std::getline(input, line)) {
+    lineNumber++;
+    size_t comment = line.find('#');
+    if (comment != std::string::npos)
+      line.erase(comment);
+
+    std::istringstream tokens(line);
+    std::string keyword;
+    if (!(tokens >> keyword))
+      continue; // Blank or comment-only
+
+    if (!parseLine(keyword, tokens, source)) {
+      error = std::to_string(lineNumber) + ": cannot parse '" + keyword + "'";
+      return false;
+    }
+  }
+
+  const uint32_t sectionCount = static_cast<uint32_t>(LevelSectionType::COUNT);
+  LevelSection table[static_cast<size_t>(LevelSectionType::COUNT)];
+
+  binary.assign(sizeof(LevelFileHeader) + sizeof(table), 0);
+  writeSection(binary, table[0], LevelSectionType::STRINGS, source.strings);
+  writeSection(binary, table[1], LevelSectionType::WALLS, source.walls);
+  writeSection(binary, table[2], LevelSectionType::PENDULUMS,
+               source.pendulums);
+  writeSection(binary, table[3], LevelSectionType::STALACTITES,
+               source.stalactites);
+  writeSection(binary, table[4], LevelSectionType::GEYSERS, source.geysers);
+  writeSection(binary, table[5], LevelSectionType::LIGHTS, source.lights);
+  writeSection(binary, table[6], LevelSectionType::PROPS, source.props);
+  writeSection(binary, table[7], LevelSectionType::COINS, source.coins);
+
+  LevelFileHeader header;
+  std::memcpy(header.magic, kLevelMagic, sizeof(header.magic));
+  header.version = kLevelFormatVersion;
+  header.sectionCount = sectionCount;
+  header.fileSize = static_cast<uint32_t>(binary.size());
+  std::memcpy(binary.data(), &header, sizeof(header));
+  std::memcpy(binary.data() + sizeof(header), table, sizeof(table));
+  return true;
+}
+
+bool LevelData::bind(const unsigned char *bytes, size_t byteCount,
+                     const std::string &name) {
+  LevelFileHeader header;
+  if (byteCount < sizeof(header)) {
+    std::cerr << "ERROR::LEVEL::TRUNCATED " << name << std::endl;
+    return false;
+  }
+  std::memcpy(&header, bytes, sizeof(header));
+  if (std::memcmp(header.magic, kLevelMagic, sizeof(kLevelMagic)) != 0) {
+    std::cerr << "ERROR::LEVEL::NOT_A_LEVEL_FILE " << name << std::endl;
+    return false;
+  }
+  if (header.version != kLevelFormatVersion) {
+    std::cerr << "ERROR::LEVEL::VERSION " << name << " is version "
+              << header.version << ", expected " << kLevelFormatVersion
+              << std::endl;
+    return false;
+  }
+  if (header.fileSize != byteCount ||
+      header.sectionCount > static_cast<uint32_t>(LevelSectionType::COUNT) ||
+      sizeof(header) + header.sectionCount * sizeof(LevelSection) >
+          byteCount) {
+    std::cerr << "ERROR::LEVEL::TRUNCATED " << name << std::endl;
+    return false;
+  }
+
+  const LevelSection *table =
+      reinterpret_cast<const LevelSection *>(bytes + sizeof(header));
+  for (uint32_t i = 0; i < header.sectionCount; i++) {
+    const LevelSection &section = table[i];
+    uint64_t end = section.offset +
+                   static_cast<uint64_t>(section.count) * section.stride;
+    if (section.type >= static_cast<uint32_t>(LevelSectionType::COUNT) ||
+        section.stride != kRecordSizes[section.type] ||
+        section.offset % 4 != 0 || end > byteCount) {
+      std::cerr << "ERROR::LEVEL::BAD_SECTION " << name << " section " << i
+                << std::endl;
+      return false;
+    }
+
+    const unsigned char *data = bytes + section.offset;
+    switch (static_cast<LevelSectionType>(section.type)) {
+    case LevelSectionType::STRINGS:
+      if (section.count > 0 && data[section.count - 1] != '\0') {
+        std::cerr << "ERROR::LEVEL::BAD_STRINGS " << name << std::endl;
+        return false;
+      }
+      strings = reinterpret_cast<const char *>(data);
+      stringBytes = section.count;
+      break;
+    case LevelSectionType::WALLS:
+      walls = reinterpret_cast<const WallRecord *>(data);
+      wallCount = section.count;
+      break;
+    case LevelSectionType::PENDULUMS:
+      pendulums = reinterpret_cast<const PendulumRecord *>(data);
+      pendulumCount = section.count;
+      break;
+    case LevelSectionType::STALACTITES:
+      stalactites = reinterpret_cast<const StalactiteRecord *>(data);
+      stalactiteCount = section.count;
+      break;
+    case LevelSectionType::GEYSERS:
+      geysers = reinterpret_cast<const GeyserRecord *>(data);
+      geyserCount = section.count;
+      break;
+    case LevelSectionType::LIGHTS:
+      lights = reinterpret_cast<const LightRecord *>(data);
+      lightCount = section.count;
+      break;
+    case LevelSectionType::PROPS:
+      props = reinterpret_cast<const PropRecord *>(data);
+      propCount = section.count;
+      break;
+    case LevelSectionType::COINS:
+      coins = reinterpret_cast<const CoinRecord *>(data);
+      coinCount = section.count;
+      break;
+    default:
+      break;
+    }
+  }
+
+  // Model references must land inside the string table
+  for (uint32_t i = 0; i < propCount; i++) {
+    if (props[i].model >= stringBytes) {
+      std::cerr << "ERROR::LEVEL::BAD_MODEL_REFERENCE " << name << std::endl;
+      return false;
+    }
+  }
+  for (uint32_t i = 0; i < coinCount; i++) {
+    if (coins[i].model >= stringBytes) {
+      std::cerr << "ERROR::LEVEL::BAD_MODEL_REFERENCE " << name << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+const char *LevelData::getString(uint32_t offset) const {
+  return offset < stringBytes ? strings + offset : "";
+}
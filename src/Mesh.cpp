@@ -1,9 +1,79 @@
 #include "Mesh.h"
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+
+namespace {
+
+// Float -> IEEE 754 half with round-to-nearest-even
+uint16_t floatToHalf(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+
+  uint32_t sign = (bits >> 16) & 0x8000u;
+  int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xFFu) - 127 + 15;
+  uint32_t mantissa = bits & 0x7FFFFFu;
+
+  if (((bits >> 23) & 0xFFu) == 0xFFu) {
+    // Inf / NaN
+    return static_cast<uint16_t>(sign | 0x7C00u | (mantissa ? 0x200u : 0u));
+  }
+  if (exponent >= 31) {
+    return static_cast<uint16_t>(sign | 0x7C00u); // Overflow -> Inf
+  }
+  if (exponent <= 0) {
+    if (exponent < -10) {
+      return static_cast<uint16_t>(sign); // Too small -> signed zero
+    }
+    // Denormal half
+    mantissa |= 0x800000u;
+    uint32_t shift = static_cast<uint32_t>(14 - exponent);
+    uint32_t half = mantissa >> shift;
+    uint32_t remainder = mantissa & ((1u << shift) - 1u);
+    uint32_t halfway = 1u << (shift - 1u);
+    if (remainder > halfway || (remainder == halfway && (half & 1u))) {
+      half++;
+    }
+    return static_cast<uint16_t>(sign | half);
+  }
+
+  uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) |
+                  (mantissa >> 13);
+  uint32_t remainder = mantissa & 0x1FFFu;
+  if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) {
+    half++; // May carry into the exponent, which is still correct
+  }
+  return static_cast<uint16_t>(half);
+}
+
+int16_t toSnorm16(float value) {
+  value = std::max(-1.0f, std::min(1.0f, value));
+  return static_cast<int16_t>(std::lround(value * 32767.0f));
+}
+
+float signNotZero(float v) { return v >= 0.0f ? 1.0f : -1.0f; }
+
+// Octahedral normal encoding (matches decodeOctahedral in vertex.glsl)
+glm::vec2 encodeOctahedral(const glm::vec3 &n) {
+  float l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+  if (l1 < 1e-8f) {
+    return glm::vec2(0.0f, 0.0f); // Degenerate normal decodes to +Z
+  }
+  glm::vec2 e(n.x / l1, n.y / l1);
+  if (n.z < 0.0f) {
+    e = glm::vec2((1.0f - std::abs(e.y)) * signNotZero(e.x),
+                  (1.0f - std::abs(e.x)) * signNotZero(e.y));
+  }
+  return e;
+}
+
+} // namespace
 
 Mesh::Mesh(const std::vector<Vertex> &verts,
            const std::vector<unsigned int> &inds)
-    : vertices(verts), indices(inds) {
+    : vertices(verts), indices(inds), VAO(0), VBO(0), EBO(0),
+      indexType(GL_UNSIGNED_INT), indexCount(0), positionScale(1.0f),
+      positionOffset(0.0f) {
   setupMesh();
 }
 
@@ -13,7 +83,49 @@ Mesh::~Mesh() {
   glDeleteBuffers(1, &EBO);
 }
 
+PackedVertex Mesh::packVertex(const Vertex &v, const glm::vec3 &offset,
+                              const glm::vec3 &invScale) {
+  PackedVertex p;
+  glm::vec3 q = (v.position - offset) * invScale;
+  p.position[0] = toSnorm16(q.x);
+  p.position[1] = toSnorm16(q.y);
+  p.position[2] = toSnorm16(q.z);
+  p.position[3] = 0;
+
+  glm::vec2 oct = encodeOctahedral(v.normal);
+  p.normal[0] = toSnorm16(oct.x);
+  p.normal[1] = toSnorm16(oct.y);
+
+  p.texCoord[0] = floatToHalf(v.texCoord.x);
+  p.texCoord[1] = floatToHalf(v.texCoord.y);
+  return p;
+}
+
 void Mesh::setupMesh() {
+  // Quantize positions to the mesh bounds so snorm16 covers the full extent
+  glm::vec3 minPos(0.0f), maxPos(0.0f);
+  if (!vertices.empty()) {
+    minPos = maxPos = vertices[0].position;
+    for (const auto &v : vertices) {
+      minPos = glm::min(minPos, v.position);
+      maxPos = glm::max(maxPos, v.position);
+    }
+  }
+  positionOffset = (minPos + maxPos) * 0.5f;
+  positionScale = (maxPos - minPos) * 0.5f;
+
+  glm::vec3 invScale;
+  for (int axis = 0; axis < 3; axis++) {
+    invScale[axis] =
+        positionScale[axis] > 0.0f ? 1.0f / positionScale[axis] : 0.0f;
+  }
+
+  std::vector<PackedVertex> packed;
+  packed.reserve(vertices.size());
+  for (const auto &v : vertices) {
+    packed.push_back(packVertex(v, positionOffset, invScale));
+  }
+
   // Generate and bind VAO
   glGenVertexArrays(1, &VAO);
   glGenBuffers(1, &VBO);
@@ -23,351 +135,80 @@ void Mesh::setupMesh() {
 
   // Vertex buffer
   glBindBuffer(GL_ARRAY_BUFFER, VBO);
-  glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0],
-               GL_STATIC_DRAW);
+  glBufferData(GL_ARRAY_BUFFER, packed.size() * sizeof(PackedVertex),
+               packed.data(), GL_STATIC_DRAW);
 
-  // Element buffer
+  // Element buffer - 16-bit indices whenever the vertex count allows it
+  indexCount = static_cast<GLsizei>(indices.size());
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int),
-               &indices[0], GL_STATIC_DRAW);
-
-  // Position attribute (location 0)
+  if (vertices.size() <= 65536) {
+    std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+    indexType = GL_UNSIGNED_SHORT;
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+                 shortIndices.size() * sizeof(uint16_t), shortIndices.data(),
+                 GL_STATIC_DRAW);
+  } else {
+    indexType = GL_UNSIGNED_INT;
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+                 indices.size() * sizeof(unsigned int), indices.data(),
+                 GL_STATIC_DRAW);
+  }
+
+  // Position attribute (location 0) - snorm16, dequantized in the shader
   glEnableVertexAttribArray(0);
-  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)0);
+  glVertexAttribPointer(0, 3, GL_SHORT, GL_TRUE, sizeof(PackedVertex),
+                        (void *)offsetof(PackedVertex, position));
 
-  // Normal attribute (location 1)
+  // Normal attribute (location 1) - octahedral snorm16
   glEnableVertexAttribArray(1);
-  glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                        (void *)offsetof(Vertex, normal));
+  glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, sizeof(PackedVertex),
+                        (void *)offsetof(PackedVertex, normal));
 
-  // TexCoord attribute (location 2)
+  // TexCoord attribute (location 2) - half float
   glEnableVertexAttribArray(2);
-  glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                        (void *)offsetof(Vertex, texCoord));
+  glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(PackedVertex),
+                        (void *)offsetof(PackedVertex, texCoord));
 
   // Unbind VAO
   glBindVertexArray(0);
 }
 
 void Mesh::draw() const {
-  // Simply bind VAO and draw - all vertex attributes are already configured
   glBindVertexArray(VAO);
-  glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
+  // Dequantization constants go through the current (non-array) values of
+  // attributes 3 and 4, so no uniform lookup is needed per draw
+  glVertexAttrib3f(3, positionScale.x, positionScale.y, positionScale.z);
+  glVertexAttrib3f(4, positionOffset.x, positionOffset.y, positionOffset.z);
+  glDrawElements(GL_TRIANGLES, indexCount, indexType, 0);
   glBindVertexArray(0);
 }
 
 Mesh *Mesh::createCube(float size) {
-  std::vector<Vertex> vertices;
-  std::vector<unsigned int> indices;
-
-  float s = size / 2.0f;
-
-  // Define 24 vertices (4 per face for proper normals)
-  glm::vec3 positions[24] = {// Front face
-                             {-s, -s, s},
-                             {s, -s, s},
-                             {s, s, s},
-                             {-s, s, s},
-                             // Back face
-                             {s, -s, -s},
-                             {-s, -s, -s},
-                             {-s, s, -s},
-                             {s, s, -s},
-                             // Top face
-                             {-s, s, s},
-                             {s, s, s},
-                             {s, s, -s},
-                             {-s, s, -s},
-                             // Bottom face
-                             {-s, -s, -s},
-                             {s, -s, -s},
-                             {s, -s, s},
-                             {-s, -s, s},
-                             // Right face
-                             {s, -s, s},
-                             {s, -s, -s},
-                             {s, s, -s},
-                             {s, s, s},
-                             // Left face
-                             {-s, -s, -s},
-                             {-s, -s, s},
-                             {-s, s, s},
-                             {-s, s, -s}};
-
-  glm::vec3 normals[6] = {{0, 0, 1},  {0, 0, -1}, {0, 1, 0},
-                          {0, -1, 0}, {1, 0, 0},  {-1, 0, 0}};
-
-  for (int i = 0; i < 6; i++) {
-    for (int j = 0; j < 4; j++) {
-      Vertex v;
-      v.position = positions[i * 4 + j];
-      v.normal = normals[i];
-      v.texCoord = glm::vec2((j == 1 || j == 2) ? 1.0f : 0.0f,
-                             (j == 2 || j == 3) ? 1.0f : 0.0f);
-      vertices.push_back(v);
-    }
-  }
-
-  for (int i = 0; i < 6; i++) {
-    int base = i * 4;
-    indices.push_back(base);
-    indices.push_back(base + 1);
-    indices.push_back(base + 2);
-    indices.push_back(base);
-    indices.push_back(base + 2);
-    indices.push_back(base + 3);
-  }
-
-  return new Mesh(vertices, indices);
+  MeshData mesh = generateCube(size);
+  return new Mesh(mesh.vertices, mesh.indices);
 }
 
 Mesh *Mesh::createSphere(float radius, int sectors, int stacks) {
-  std::vector<Vertex> vertices;
-  std::vector<unsigned int> indices;
-
-  float sectorStep = 2 * M_PI / sectors;
-  float stackStep = M_PI / stacks;
-
-  for (int i = 0; i <= stacks; ++i) {
-    float stackAngle = M_PI / 2 - i * stackStep;
-    float xy = radius * cosf(stackAngle);
-    float z = radius * sinf(stackAngle);
-
-    for (int j = 0; j <= sectors; ++j) {
-      float sectorAngle = j * sectorStep;
-
-      Vertex v;
-      v.position.x = xy * cosf(sectorAngle);
-      v.position.y = z;
-      v.position.z = xy * sinf(sectorAngle);
-      v.normal = glm::normalize(v.position);
-      v.texCoord.x = (float)j / sectors;
-      v.texCoord.y = (float)i / stacks;
-      vertices.push_back(v);
-    }
-  }
-
-  for (int i = 0; i < stacks; ++i) {
-    int k1 = i * (sectors + 1);
-    int k2 = k1 + sectors + 1;
-
-    for (int j = 0; j < sectors; ++j, ++k1, ++k2) {
-      if (i != 0) {
-        indices.push_back(k1);
-        indices.push_back(k2);
-        indices.push_back(k1 + 1);
-      }
-      if (i != (stacks - 1)) {
-        indices.push_back(k1 + 1);
-        indices.push_back(k2);
-        indices.push_back(k2 + 1);
-      }
-    }
-  }
-
-  return new Mesh(vertices, indices);
+  MeshData mesh = generateSphere(radius, sectors, stacks);
+  return new Mesh(mesh.vertices, mesh.indices);
 }
 
 Mesh *Mesh::createPlane(float width, float height) {
-  std::vector<Vertex> vertices;
-  std::vector<unsigned int> indices;
-
-  float w = width / 2.0f;
-  float h = height / 2.0f;
-
-  vertices.push_back({{-w, 0, -h}, {0, 1, 0}, {0, 0}});
-  vertices.push_back({{w, 0, -h}, {0, 1, 0}, {1, 0}});
-  vertices.push_back({{w, 0, h}, {0, 1, 0}, {1, 1}});
-  vertices.push_back({{-w, 0, h}, {0, 1, 0}, {0, 1}});
-
-  indices = {0, 1, 2, 0, 2, 3};
-
-  return new Mesh(vertices, indices);
+  MeshData mesh = generatePlane(width, height);
+  return new Mesh(mesh.vertices, mesh.indices);
 }
 
 Mesh *Mesh::createCylinder(float radius, float height, int sectors) {
-  std::vector<Vertex> vertices;
-  std::vector<unsigned int> indices;
-
-  float sectorStep = 2 * M_PI / sectors;
-  float halfHeight = height / 2.0f;
-
-  // Side vertices
-  for (int i = 0; i <= sectors; ++i) {
-    float sectorAngle = i * sectorStep;
-    float x = radius * cosf(sectorAngle);
-    float z = radius * sinf(sectorAngle);
-
-    glm::vec3 normal = glm::normalize(glm::vec3(x, 0, z));
-
-    vertices.push_back({{x, -halfHeight, z}, normal, {(float)i / sectors, 0}});
-    vertices.push_back({{x, halfHeight, z}, normal, {(float)i / sectors, 1}});
-  }
-
-  // Side indices
-  for (int i = 0; i < sectors; ++i) {
-    int k1 = i * 2;
-    int k2 = k1 + 2;
-
-    indices.push_back(k1);
-    indices.push_back(k2);
-    indices.push_back(k1 + 1);
-
-    indices.push_back(k1 + 1);
-    indices.push_back(k2);
-    indices.push_back(k2 + 1);
-  }
-
-  // Top Cap
-  int topCenterIndex = vertices.size();
-  vertices.push_back({{0, halfHeight, 0}, {0, 1, 0}, {0.5f, 0.5f}}); // Top Center
-
-  int topStartIndex = vertices.size();
-  for (int i = 0; i <= sectors; ++i) {
-    float sectorAngle = i * sectorStep;
-    float x = radius * cosf(sectorAngle);
-    float z = radius * sinf(sectorAngle);
-    // Top cap vertices need Up normal
-    vertices.push_back({{x, halfHeight, z}, {0, 1, 0}, {0.5f + 0.5f * cosf(sectorAngle), 0.5f + 0.5f * sinf(sectorAngle)}});
-  }
-
-  for (int i = 0; i < sectors; ++i) {
-    indices.push_back(topCenterIndex);
-    indices.push_back(topStartIndex + i);
-    indices.push_back(topStartIndex + i + 1);
-  }
-
-  // Bottom Cap
-  int bottomCenterIndex = vertices.size();
-  vertices.push_back({{0, -halfHeight, 0}, {0, -1, 0}, {0.5f, 0.5f}}); // Bottom Center
-
-  int bottomStartIndex = vertices.size();
-  for (int i = 0; i <= sectors; ++i) {
-    float sectorAngle = i * sectorStep;
-    float x = radius * cosf(sectorAngle);
-    float z = radius * sinf(sectorAngle);
-    // Bottom cap vertices need Down normal
-    vertices.push_back({{x, -halfHeight, z}, {0, -1, 0}, {0.5f + 0.5f * cosf(sectorAngle), 0.5f + 0.5f * sinf(sectorAngle)}});
-  }
-
-  for (int i = 0; i < sectors; ++i) {
-    indices.push_back(bottomCenterIndex);
-    indices.push_back(bottomStartIndex + i + 1);
-    indices.push_back(bottomStartIndex + i);
-  }
-
-  return new Mesh(vertices, indices);
+  MeshData mesh = generateCylinder(radius, height, sectors);
+  return new Mesh(mesh.vertices, mesh.indices);
 }
 
 Mesh *Mesh::createCone(float radius, float height, int sectors) {
-  std::vector<Vertex> vertices;
-  std::vector<unsigned int> indices;
-
-  float sectorStep = 2 * M_PI / sectors;
-  float halfHeight = height / 2.0f;
-
-  // Apex vertex
-  Vertex apex;
-  apex.position = glm::vec3(0.0f, halfHeight, 0.0f);
-  apex.normal = glm::vec3(0.0f, 1.0f, 0.0f); // Approximate up for apex
-  apex.texCoord = glm::vec2(0.5f, 1.0f);
-  vertices.push_back(apex);
-
-  // Base vertices
-  for (int i = 0; i <= sectors; ++i) {
-    float sectorAngle = i * sectorStep;
-    float x = radius * cosf(sectorAngle);
-    float z = radius * sinf(sectorAngle);
-
-    // Calculate normal for side
-    // Normal has horizontal component (x, z) and vertical component
-    // (radius/height)
-    glm::vec3 n = glm::vec3(x, radius * (radius / height), z);
-    n = glm::normalize(n);
-
-    Vertex v;
-    v.position = glm::vec3(x, -halfHeight, z);
-    v.normal = n;
-    v.texCoord = glm::vec2((float)i / sectors, 0.0f);
-    vertices.push_back(v);
-  }
-
-  // Indices for sides
-  for (int i = 0; i < sectors; ++i) {
-    indices.push_back(0); // Apex
-    indices.push_back(i + 1);
-    indices.push_back(i + 2);
-  }
-
-  // Base cap
-  // Center of base
-  Vertex baseCenter;
-  baseCenter.position = glm::vec3(0.0f, -halfHeight, 0.0f);
-  baseCenter.normal = glm::vec3(0.0f, -1.0f, 0.0f);
-  baseCenter.texCoord = glm::vec2(0.5f, 0.5f);
-  int baseCenterIndex = vertices.size();
-  vertices.push_back(baseCenter);
-
-  // Duplicate base vertices for flat shading on bottom
-  int baseStartIndex = vertices.size();
-  for (int i = 0; i <= sectors; ++i) {
-    float sectorAngle = i * sectorStep;
-    float x = radius * cosf(sectorAngle);
-    float z = radius * sinf(sectorAngle);
-
-    Vertex v;
-    v.position = glm::vec3(x, -halfHeight, z);
-    v.normal = glm::vec3(0.0f, -1.0f, 0.0f);
-    v.texCoord = glm::vec2((float)i / sectors, 0.0f);
-    vertices.push_back(v);
-  }
-
-  // Indices for base cap
-  for (int i = 0; i < sectors; ++i) {
-    indices.push_back(baseCenterIndex);
-    indices.push_back(baseStartIndex + i + 1);
-    indices.push_back(baseStartIndex + i);
-  }
-
-  return new Mesh(vertices, indices);
+  MeshData mesh = generateCone(radius, height, sectors);
+  return new Mesh(mesh.vertices, mesh.indices);
 }
 
-Mesh* Mesh::createHeart(float size) {
-  std::vector<Vertex> vertices;
-  std::vector<unsigned int> indices;
-  
-  // Create a 2D heart shape using parametric equations
-  // Heart curve: x = 16*sin(t)^3, y = 13*cos(t) - 5*cos(2t) - 2*cos(3t) - cos(4t)
-  int segments = 32;
-  float scale = size / 16.0f; // Normalize to size
-  
-  // Center vertex
-  vertices.push_back({{0, 0, 0}, {0, 0, 1}, {0.5f, 0.5f}});
-  
-  // Generate heart outline vertices
-  for (int i = 0; i <= segments; ++i) {
-    float t = (float)i / segments * 2.0f * M_PI;
-    
-    float sinT = sinf(t);
-    float cosT = cosf(t);
-    
-    // Heart parametric equations
-    float x = 16.0f * sinT * sinT * sinT;
-    float y = 13.0f * cosT - 5.0f * cosf(2*t) - 2.0f * cosf(3*t) - cosf(4*t);
-    
-    Vertex v;
-    v.position = glm::vec3(x * scale, y * scale, 0);
-    v.normal = glm::vec3(0, 0, 1);
-    v.texCoord = glm::vec2((x + 16) / 32.0f, (y + 17) / 30.0f);
-    vertices.push_back(v);
-  }
-  
-  // Create triangles from center to edge
-  for (int i = 0; i < segments; ++i) {
-    indices.push_back(0); // center
-    indices.push_back(i + 1);
-    indices.push_back(i + 2);
-  }
-  
-  return new Mesh(vertices, indices);
+Mesh *Mesh::createHeart(float size) {
+  MeshData mesh = generateHeart(size);
+  return new Mesh(mesh.vertices, mesh.indices);
 }
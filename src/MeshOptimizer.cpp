@@ -0,0 +1,264 @@
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <numeric>
+
+namespace MeshOptimizer {
+
+float computeACMR(const std::vector<unsigned int> &indices, size_t vertexCount,
+                  int cacheSize) {
+  if (indices.size() < 3) {
+    return 0.0f;
+  }
+
+  // FIFO cache modeled with per-vertex insertion timestamps
+  std::vector<long long> insertedAt(vertexCount, -1000000);
+  long long time = 0;
+  size_t misses = 0;
+
+  for (unsigned int v : indices) {
+    if (time - insertedAt[v] >= cacheSize) {
+      insertedAt[v] = time++;
+      misses++;
+    }
+  }
+
+  return static_cast<float>(misses) / (indices.size() / 3);
+}
+
+std::vector<size_t> optimizeVertexCache(std::vector<unsigned int> &indices,
+                                        size_t vertexCount, int cacheSize) {
+  std::vector<size_t> clusterStarts;
+  size_t triangleCount = indices.size() / 3;
+  if (triangleCount == 0 || vertexCount == 0) {
+    return clusterStarts;
+  }
+
+  // Vertex -> triangle adjacency (CSR layout)
+  std::vector<unsigned int> liveCount(vertexCount, 0);
+  for (unsigned int v : indices) {
+    liveCount[v]++;
+  }
+  std::vector<size_t> adjacencyStart(vertexCount + 1, 0);
+  for (size_t v = 0; v < vertexCount; v++) {
+    adjacencyStart[v + 1] = adjacencyStart[v] + liveCount[v];
+  }
+  std::vector<unsigned int> adjacency(indices.size());
+  std::vector<size_t> fill(adjacencyStart.begin(), adjacencyStart.end() - 1);
+  for (size_t t = 0; t < triangleCount; t++) {
+    for (int c = 0; c < 3; c++) {
+      adjacency[fill[indices[t * 3 + c]]++] = static_cast<unsigned int>(t);
+    }
+  }
+
+  std::vector<long long> cacheTime(vertexCount, 0);
+  std::vector<bool> emitted(triangleCount, false);
+  std::vector<unsigned int> deadEnd;
+  std::vector<unsigned int> candidates;
+  std::vector<unsigned int> output;
+  output.reserve(indices.size());
+
+  long long timestamp = cacheSize + 1;
+  size_t cursor = 0;
+  long long fanning = 0;
+
+  // Start at the first vertex that is actually used
+  while (cursor < vertexCount && liveCount[cursor] == 0) {
+    cursor++;
+  }
+  fanning = cursor < vertexCount ? static_cast<long long>(cursor) : -1;
+  clusterStarts.push_back(0);
+
+  while (fanning >= 0) {
+    candidates.clear();
+
+    // Emit every remaining triangle around the fanning vertex
+    for (size_t a = adjacencyStart[fanning]; a < adjacencyStart[fanning + 1];
+         a++) {
+      unsigned int t = adjacency[a];
+      if (emitted[t]) {
+        continue;
+      }
+      for (int c = 0; c < 3; c++) {
+        unsigned int v = indices[t * 3 + c];
+        output.push_back(v);
+        deadEnd.push_back(v);
+        candidates.push_back(v);
+        liveCount[v]--;
+        if (timestamp - cacheTime[v] > cacheSize) {
+          cacheTime[v] = timestamp++;
+        }
+      }
+      emitted[t] = true;
+    }
+
+    // Pick the candidate that stays in cache and has the most live triangles
+    long long best = -1;
+    long long bestPriority = -1;
+    for (unsigned int v : candidates) {
+      if (liveCount[v] == 0) {
+        continue;
+      }
+      long long priority = 0;
+      if (timestamp - cacheTime[v] + 2 * liveCount[v] <= cacheSize) {
+        priority = timestamp - cacheTime[v];
+      }
+      if (priority > bestPriority) {
+        bestPriority = priority;
+        best = v;
+      }
+    }
+
+    if (best < 0) {
+      // Dead end: try recently used vertices first
+      while (!deadEnd.empty()) {
+        unsigned int v = deadEnd.back();
+        deadEnd.pop_back();
+        if (liveCount[v] > 0) {
+          best = v;
+          break;
+        }
+      }
+    }
+
+    if (best < 0) {
+      // Nothing local left - jump to the next vertex in input order. This
+      // is a hard boundary, so the overdraw pass may reorder from here.
+      while (cursor < vertexCount && liveCount[cursor] == 0) {
+        cursor++;
+      }
+      if (cursor < vertexCount) {
+        best = static_cast<long long>(cursor);
+        clusterStarts.push_back(output.size() / 3);
+      }
+    }
+
+    fanning = best;
+  }
+
+  indices.swap(output);
+  return clusterStarts;
+}
+
+void optimizeOverdraw(std::vector<unsigned int> &indices,
+                      const std::vector<Vertex> &vertices,
+                      const std::vector<size_t> &clusterStarts,
+                      size_t minClusterTriangles) {
+  size_t triangleCount = indices.size() / 3;
+  if (triangleCount == 0 || clusterStarts.size() < 2) {
+    return;
+  }
+
+  // Merge small clusters so reordering does not destroy cache locality
+  std::vector<size_t> starts;
+  for (size_t start : clusterStarts) {
+    if (starts.empty() || start - starts.back() >= minClusterTriangles) {
+      starts.push_back(start);
+    }
+  }
+  if (starts.size() < 2) {
+    return;
+  }
+
+  // Mesh centroid (area weighted)
+  glm::vec3 meshCentroid(0.0f);
+  float meshArea = 0.0f;
+  for (size_t t = 0; t < triangleCount; t++) {
+    const glm::vec3 &a = vertices[indices[t * 3 + 0]].position;
+    const glm::vec3 &b = vertices[indices[t * 3 + 1]].position;
+    const glm::vec3 &c = vertices[indices[t * 3 + 2]].position;
+    float area = glm::length(glm::cross(b - a, c - a));
+    meshCentroid += (a + b + c) * (area / 3.0f);
+    meshArea += area;
+  }
+  if (meshArea <= 0.0f) {
+    return;
+  }
+  meshCentroid /= meshArea;
+
+  struct Cluster {
+    size_t begin;
+    size_t end;
+    float sortKey;
+  };
+  std::vector<Cluster> clusters;
+  clusters.reserve(starts.size());
+
+  for (size_t i = 0; i < starts.size(); i++) {
+    Cluster cluster;
+    cluster.begin = starts[i];
+    cluster.end = (i + 1 < starts.size()) ? starts[i + 1] : triangleCount;
+
+    glm::vec3 centroid(0.0f);
+    glm::vec3 normal(0.0f);
+    float area = 0.0f;
+    for (size_t t = cluster.begin; t < cluster.end; t++) {
+      const glm::vec3 &a = vertices[indices[t * 3 + 0]].position;
+      const glm::vec3 &b = vertices[indices[t * 3 + 1]].position;
+      const glm::vec3 &c = vertices[indices[t * 3 + 2]].position;
+      glm::vec3 n = glm::cross(b - a, c - a); // Length = 2x area
+      float triArea = glm::length(n);
+      centroid += (a + b + c) * (triArea / 3.0f);
+      normal += n;
+      area += triArea;
+    }
+
+    cluster.sortKey = 0.0f;
+    float normalLength = glm::length(normal);
+    if (area > 0.0f && normalLength > 0.0f) {
+      centroid /= area;
+      cluster.sortKey =
+          glm::dot(centroid - meshCentroid, normal / normalLength);
+    }
+    clusters.push_back(cluster);
+  }
+
+  // Outward-facing clusters first - they occlude the inner ones
+  std::stable_sort(clusters.begin(), clusters.end(),
+                   [](const Cluster &a, const Cluster &b) {
+                     return a.sortKey > b.sortKey;
+                   });
+
+  std::vector<unsigned int> output;
+  output.reserve(indices.size());
+  for (const auto &cluster : clusters) {
+    output.insert(output.end(), indices.begin() + cluster.begin * 3,
+                  indices.begin() + cluster.end * 3);
+  }
+  indices.swap(output);
+}
+
+void optimizeVertexFetch(std::vector<Vertex> &vertices,
+                         std::vector<unsigned int> &indices) {
+  const unsigned int unused = ~0u;
+  std::vector<unsigned int> remap(vertices.size(), unused);
+  std::vector<Vertex> output;
+  output.reserve(vertices.size());
+
+  for (unsigned int &index : indices) {
+    if (remap[index] == unused) {
+      remap[index] = static_cast<unsigned int>(output.size());
+      output.push_back(vertices[index]);
+    }
+    index = remap[index];
+  }
+
+  vertices.swap(output);
+}
+
+Stats optimize(std::vector<Vertex> &vertices,
+               std::vector<unsigned int> &indices) {
+  Stats stats;
+  stats.triangleCount = indices.size() / 3;
+  stats.vertexCountBefore = vertices.size();
+  stats.acmrBefore = computeACMR(indices, vertices.size());
+
+  std::vector<size_t> clusters = optimizeVertexCache(indices, vertices.size());
+  optimizeOverdraw(indices, vertices, clusters);
+  optimizeVertexFetch(vertices, indices);
+
+  stats.vertexCountAfter = vertices.size();
+  stats.acmrAfter = computeACMR(indices, vertices.size());
+  return stats;
+}
+
+} // namespace MeshOptimizer
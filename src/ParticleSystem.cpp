@@ -1,14 +1,16 @@
 #include "ParticleSystem.h"
 #include <algorithm>
 
-ParticleSystem::ParticleSystem(int max) : maxParticles(max) {
-  particles.reserve(maxParticles);
-  setupBuffers();
+ParticleSystem::ParticleSystem(int max)
+    : particleCount(0), maxParticles(max), VAO(0), VBO(0) {
+  particles.resize(maxParticles);
 }
 
 ParticleSystem::~ParticleSystem() {
-  glDeleteVertexArrays(1, &VAO);
-  glDeleteBuffers(1, &VBO);
+  if (VAO) {
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &VBO);
+  }
 }
 
 void ParticleSystem::setupBuffers() {
@@ -42,8 +44,8 @@ void ParticleSystem::setupBuffers() {
 void ParticleSystem::emit(const glm::vec3 &position, const glm::vec3 &velocity,
                           const glm::vec4 &color, float size, float lifetime,
                           int count) {
-  for (int i = 0; i < count && particles.size() < maxParticles; i++) {
-    Particle p;
+  for (int i = 0; i < count && particleCount < maxParticles; i++) {
+    Particle &p = particles[particleCount++];
     p.position = position;
     p.velocity = velocity + glm::vec3((rand() % 100 - 50) / 100.0f,
                                       (rand() % 100 - 50) / 100.0f,
@@ -53,8 +55,15 @@ void ParticleSystem::emit(const glm::vec3 &position, const glm::vec3 &velocity,
     p.size = size;
     p.lifetime = lifetime;
     p.age = 0.0f;
+  }
+}
 
-    particles.push_back(p);
+void ParticleSystem::emitBatch(const glm::vec3 *origins, int originCount,
+                               const glm::vec3 &velocity,
+                               const glm::vec4 &color, float size,
+                               float lifetime, int countPerOrigin) {
+  for (int i = 0; i < originCount; i++) {
+    emit(origins[i], velocity, color, size, lifetime, countPerOrigin);
   }
 }
 
@@ -74,29 +83,33 @@ void ParticleSystem::emitExplosion(const glm::vec3 &position,
 }
 
 void ParticleSystem::update(float deltaTime) {
-  for (auto it = particles.begin(); it != particles.end();) {
-    it->age += deltaTime;
+  for (int i = 0; i < particleCount;) {
+    Particle &p = particles[i];
+    p.age += deltaTime;
 
-    if (it->age >= it->lifetime) {
-      it = particles.erase(it);
+    if (p.age >= p.lifetime) {
+      // Swap-and-pop keeps the live range packed without shifting
+      p = particles[--particleCount];
     } else {
-      it->position += it->velocity * deltaTime;
-      it->velocity.y -= 9.8f * deltaTime; // Gravity
+      p.position += p.velocity * deltaTime;
+      p.velocity.y -= 9.8f * deltaTime; // Gravity
 
       // Fade out
-      float lifeRatio = it->age / it->lifetime;
-      it->color.a = 1.0f - lifeRatio;
+      float lifeRatio = p.age / p.lifetime;
+      p.color.a = 1.0f - lifeRatio;
 
-      ++it;
+      ++i;
     }
   }
 }
 
-void ParticleSystem::draw(const glm::mat4 &view, const glm::mat4 &projection) {
-  if (particles.empty())
+void ParticleSystem::draw(const Particle *data, int count) {
+  if (count == 0)
     return;
 
-  updateBuffers();
+  if (!VAO)
+    setupBuffers();
+  updateBuffers(data, count);
 
   glEnable(GL_BLEND);
   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -104,18 +117,17 @@ void ParticleSystem::draw(const glm::mat4 &view, const glm::mat4 &projection) {
 
   // Simply bind VAO and draw
   glBindVertexArray(VAO);
-  glDrawArrays(GL_POINTS, 0, particles.size());
+  glDrawArrays(GL_POINTS, 0, count);
   glBindVertexArray(0);
 
   glDisable(GL_PROGRAM_POINT_SIZE);
   glDisable(GL_BLEND);
 }
 
-void ParticleSystem::updateBuffers() {
+void ParticleSystem::updateBuffers(const Particle *data, int count) {
   glBindBuffer(GL_ARRAY_BUFFER, VBO);
-  glBufferSubData(GL_ARRAY_BUFFER, 0, particles.size() * sizeof(Particle),
-                  particles.data());
+  glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(Particle), data);
   glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
-void ParticleSystem::clear() { particles.clear(); }
+void ParticleSystem::clear() { particleCount = 0; }
@@ -1,5 +1,72 @@
 #include "Physics.h"
 #include <algorithm>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define PHYSICS_USE_SSE 1
+#include <xmmintrin.h>
+#endif
+
+#if defined(__AVX__)
+#define PHYSICS_USE_AVX 1
+#include <immintrin.h>
+#endif
+
+namespace {
+// Conservative advancement limits for swept tests
+const int kMaxAdvanceSteps = 16;
+const float kContactTolerance = 1e-3f;
+
+// Upper bound on grid cells, the cell size grows to stay below it
+const size_t kMaxGridCells = 1 << 18;
+
+// Segment origin + delta * t, t in [0, 1], against a box (slab method)
+bool segmentIntersectAABB(const glm::vec3& origin, const glm::vec3& delta,
+                          const AABB& box, float& tEnter) {
+    float tMin = 0.0f;
+    float tMax = 1.0f;
+    for (int axis = 0; axis < 3; axis++) {
+        if (std::abs(delta[axis]) < 1e-8f) {
+            // Parallel to this slab - must already be inside it
+            if (origin[axis] < box.min[axis] || origin[axis] > box.max[axis])
+                return false;
+            continue;
+        }
+        float inv = 1.0f / delta[axis];
+        float t1 = (box.min[axis] - origin[axis]) * inv;
+        float t2 = (box.max[axis] - origin[axis]) * inv;
+        if (t1 > t2)
+            std::swap(t1, t2);
+        tMin = std::max(tMin, t1);
+        tMax = std::min(tMax, t2);
+        if (tMin > tMax)
+            return false;
+    }
+    tEnter = tMin;
+    return true;
+}
+
+// Outward normal of the box face closest to a point inside the box
+glm::vec3 nearestFaceNormal(const glm::vec3& point, const AABB& box) {
+    glm::vec3 normal(0.0f);
+    float best = INFINITY;
+    for (int axis = 0; axis < 3; axis++) {
+        float toMin = point[axis] - box.min[axis];
+        float toMax = box.max[axis] - point[axis];
+        if (toMin < best) {
+            best = toMin;
+            normal = glm::vec3(0.0f);
+            normal[axis] = -1.0f;
+        }
+        if (toMax < best) {
+            best = toMax;
+            normal = glm::vec3(0.0f);
+            normal[axis] = 1.0f;
+        }
+    }
+    return normal;
+}
+} // namespace
 
 bool AABB::intersects(const AABB& other) const {
     return (min.x <= other.max.x && max.x >= other.min.x) &&
@@ -18,6 +85,170 @@ bool Sphere::intersects(const AABB& box) const {
     return distance < radius;
 }
 
+bool Sphere::intersects(const OBB& box) const {
+    glm::vec3 offset = box.closestPoint(center) - center;
+    return glm::dot(offset, offset) < radius * radius;
+}
+
+OBB::OBB() : center(0.0f), halfExtents(0.0f) {
+    axes[0] = glm::vec3(1.0f, 0.0f, 0.0f);
+    axes[1] = glm::vec3(0.0f, 1.0f, 0.0f);
+    axes[2] = glm::vec3(0.0f, 0.0f, 1.0f);
+}
+
+OBB::OBB(const glm::vec3& center, const glm::quat& rotation, const glm::vec3& halfExtents)
+    : center(center), halfExtents(halfExtents) {
+    axes[0] = rotation * glm::vec3(1.0f, 0.0f, 0.0f);
+    axes[1] = rotation * glm::vec3(0.0f, 1.0f, 0.0f);
+    axes[2] = rotation * glm::vec3(0.0f, 0.0f, 1.0f);
+}
+
+glm::vec3 OBB::closestPoint(const glm::vec3& point) const {
+    glm::vec3 offset = point - center;
+    glm::vec3 result = center;
+    for (int i = 0; i < 3; i++) {
+        float distance = glm::dot(offset, axes[i]);
+        distance = std::min(std::max(distance, -halfExtents[i]), halfExtents[i]);
+        result += axes[i] * distance;
+    }
+    return result;
+}
+
+AABB OBB::getBounds() const {
+    // Projected half size on each world axis
+    glm::vec3 extent = glm::abs(axes[0]) * halfExtents.x +
+                       glm::abs(axes[1]) * halfExtents.y +
+                       glm::abs(axes[2]) * halfExtents.z;
+    return AABB(center - extent, center + extent);
+}
+
+bool OBB::intersects(const OBB& other) const {
+    // Separating axis test over the 15 candidate axes: 3 face normals of
+    // each box and the 9 edge cross products (Gottschalk's formulation, in
+    // this box's frame)
+    const float epsilon = 1e-6f;
+    float R[3][3], AbsR[3][3];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            R[i][j] = glm::dot(axes[i], other.axes[j]);
+            // Epsilon keeps near-parallel edge pairs from producing a
+            // false separating axis out of a degenerate cross product
+            AbsR[i][j] = std::abs(R[i][j]) + epsilon;
+        }
+    }
+
+    glm::vec3 offset = other.center - center;
+    float t[3] = {glm::dot(offset, axes[0]), glm::dot(offset, axes[1]),
+                  glm::dot(offset, axes[2])};
+    const glm::vec3& a = halfExtents;
+    const glm::vec3& b = other.halfExtents;
+    float ra, rb;
+
+    // This box's face normals
+    for (int i = 0; i < 3; i++) {
+        ra = a[i];
+        rb = b[0] * AbsR[i][0] + b[1] * AbsR[i][1] + b[2] * AbsR[i][2];
+        if (std::abs(t[i]) > ra + rb)
+            return false;
+    }
+
+    // The other box's face normals
+    for (int j = 0; j < 3; j++) {
+        ra = a[0] * AbsR[0][j] + a[1] * AbsR[1][j] + a[2] * AbsR[2][j];
+        rb = b[j];
+        if (std::abs(t[0] * R[0][j] + t[1] * R[1][j] + t[2] * R[2][j]) > ra + rb)
+            return false;
+    }
+
+    // Edge cross products axes[i] x other.axes[j]
+    for (int i = 0; i < 3; i++) {
+        int i1 = (i + 1) % 3;
+        int i2 = (i + 2) % 3;
+        for (int j = 0; j < 3; j++) {
+            int j1 = (j + 1) % 3;
+            int j2 = (j + 2) % 3;
+            ra = a[i1] * AbsR[i2][j] + a[i2] * AbsR[i1][j];
+            rb = b[j1] * AbsR[i][j2] + b[j2] * AbsR[i][j1];
+            if (std::abs(t[i2] * R[i1][j] - t[i1] * R[i2][j]) > ra + rb)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+Frustum::Frustum() {
+    for (int i = 0; i < 6; i++) {
+        planes[i] = glm::vec4(0.0f);
+    }
+}
+
+Frustum Frustum::fromMatrix(const glm::mat4& viewProjection) {
+    // Gribb/Hartmann: each plane is the last row plus or minus another row
+    // (glm is column-major, so row i is m[0][i], m[1][i], ...)
+    glm::vec4 rows[4];
+    for (int i = 0; i < 4; i++) {
+        rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i],
+                            viewProjection[2][i], viewProjection[3][i]);
+    }
+
+    Frustum frustum;
+    frustum.planes[0] = rows[3] + rows[0]; // Left
+    frustum.planes[1] = rows[3] - rows[0]; // Right
+    frustum.planes[2] = rows[3] + rows[1]; // Bottom
+    frustum.planes[3] = rows[3] - rows[1]; // Top
+    frustum.planes[4] = rows[3] + rows[2]; // Near
+    frustum.planes[5] = rows[3] - rows[2]; // Far
+    return frustum;
+}
+
+bool Frustum::intersects(const AABB& box) const {
+    for (int i = 0; i < 6; i++) {
+        // The box corner furthest along the plane normal
+        const glm::vec4& plane = planes[i];
+        glm::vec3 corner(plane.x >= 0.0f ? box.max.x : box.min.x,
+                         plane.y >= 0.0f ? box.max.y : box.min.y,
+                         plane.z >= 0.0f ? box.max.z : box.min.z);
+        if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f)
+            return false;
+    }
+    return true;
+}
+
+void AABBArray::resize(size_t count) {
+    for (int c = 0; c < 3; c++) {
+        min[c].resize(count);
+        max[c].resize(count);
+    }
+}
+
+void AABBArray::set(size_t index, const AABB& box) {
+    for (int c = 0; c < 3; c++) {
+        min[c][index] = box.min[c];
+        max[c][index] = box.max[c];
+    }
+}
+
+void OBBArray::resize(size_t count) {
+    for (int c = 0; c < 3; c++) {
+        center[c].resize(count);
+        halfExtent[c].resize(count);
+        for (int k = 0; k < 3; k++) {
+            axis[k][c].resize(count);
+        }
+    }
+}
+
+void OBBArray::set(size_t index, const OBB& box) {
+    for (int c = 0; c < 3; c++) {
+        center[c][index] = box.center[c];
+        halfExtent[c][index] = box.halfExtents[c];
+        for (int k = 0; k < 3; k++) {
+            axis[k][c][index] = box.axes[k][c];
+        }
+    }
+}
+
 bool Physics::checkAABBCollision(const AABB& a, const AABB& b) {
     return a.intersects(b);
 }
@@ -30,6 +261,157 @@ bool Physics::checkSphereAABBCollision(const Sphere& sphere, const AABB& box) {
     return sphere.intersects(box);
 }
 
+bool Physics::checkSphereOBBCollision(const Sphere& sphere, const OBB& box) {
+    return sphere.intersects(box);
+}
+
+bool Physics::checkOBBCollision(const OBB& a, const OBB& b) {
+    return a.intersects(b);
+}
+
+size_t Physics::sphereOBBBatch(const Sphere& sphere, const OBBArray& boxes,
+                               std::vector<uint32_t>& hitMask) {
+    size_t count = boxes.size();
+    hitMask.assign((count + 31) / 32, 0u);
+
+    // Squared distance from the sphere center to each box: the offset along
+    // each box axis, minus the part inside the box, squared and summed
+    float radiusSq = sphere.radius * sphere.radius;
+    size_t hits = 0;
+    size_t i = 0;
+
+#ifdef PHYSICS_USE_SSE
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 limit = _mm_set1_ps(radiusSq);
+    const __m128 px = _mm_set1_ps(sphere.center.x);
+    const __m128 py = _mm_set1_ps(sphere.center.y);
+    const __m128 pz = _mm_set1_ps(sphere.center.z);
+
+    for (; i + 4 <= count; i += 4) {
+        __m128 dx = _mm_sub_ps(px, _mm_loadu_ps(&boxes.center[0][i]));
+        __m128 dy = _mm_sub_ps(py, _mm_loadu_ps(&boxes.center[1][i]));
+        __m128 dz = _mm_sub_ps(pz, _mm_loadu_ps(&boxes.center[2][i]));
+
+        __m128 distSq = zero;
+        for (int k = 0; k < 3; k++) {
+            __m128 along = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(dx, _mm_loadu_ps(&boxes.axis[k][0][i])),
+                           _mm_mul_ps(dy, _mm_loadu_ps(&boxes.axis[k][1][i]))),
+                _mm_mul_ps(dz, _mm_loadu_ps(&boxes.axis[k][2][i])));
+            __m128 half = _mm_loadu_ps(&boxes.halfExtent[k][i]);
+            __m128 inside = _mm_min_ps(_mm_max_ps(along, _mm_sub_ps(zero, half)), half);
+            __m128 outside = _mm_sub_ps(along, inside);
+            distSq = _mm_add_ps(distSq, _mm_mul_ps(outside, outside));
+        }
+
+        int mask = _mm_movemask_ps(_mm_cmplt_ps(distSq, limit));
+        hitMask[i / 32] |= (uint32_t)mask << (i % 32);
+        for (int bits = mask; bits != 0; bits &= bits - 1) {
+            hits++;
+        }
+    }
+#endif
+
+    // Remainder (or everything without SSE)
+    for (; i < count; i++) {
+        float d[3] = {sphere.center.x - boxes.center[0][i],
+                      sphere.center.y - boxes.center[1][i],
+                      sphere.center.z - boxes.center[2][i]};
+        float distSq = 0.0f;
+        for (int k = 0; k < 3; k++) {
+            float along = d[0] * boxes.axis[k][0][i] + d[1] * boxes.axis[k][1][i] +
+                          d[2] * boxes.axis[k][2][i];
+            float half = boxes.halfExtent[k][i];
+            float outside = along - std::min(std::max(along, -half), half);
+            distSq += outside * outside;
+        }
+        if (distSq < radiusSq) {
+            hitMask[i / 32] |= 1u << (i % 32);
+            hits++;
+        }
+    }
+
+    return hits;
+}
+
+size_t Physics::sphereAABBBatch(const Sphere& sphere, const AABBArray& boxes,
+                                std::vector<uint32_t>& hitMask) {
+    size_t count = boxes.size();
+    hitMask.assign((count + 31) / 32, 0u);
+
+    // Squared distance from the sphere center to the clamped point, per
+    // axis: (c - clamp(c, min, max))^2. No square root needed.
+    float radiusSq = sphere.radius * sphere.radius;
+    size_t hits = 0;
+    size_t i = 0;
+
+#if defined(PHYSICS_USE_AVX)
+    {
+        const __m256 limit = _mm256_set1_ps(radiusSq);
+        const __m256 p[3] = {_mm256_set1_ps(sphere.center.x),
+                             _mm256_set1_ps(sphere.center.y),
+                             _mm256_set1_ps(sphere.center.z)};
+
+        for (; i + 8 <= count; i += 8) {
+            __m256 distSq = _mm256_setzero_ps();
+            for (int c = 0; c < 3; c++) {
+                __m256 clamped = _mm256_min_ps(
+                    _mm256_max_ps(p[c], _mm256_loadu_ps(&boxes.min[c][i])),
+                    _mm256_loadu_ps(&boxes.max[c][i]));
+                __m256 d = _mm256_sub_ps(p[c], clamped);
+                distSq = _mm256_add_ps(distSq, _mm256_mul_ps(d, d));
+            }
+
+            int mask = _mm256_movemask_ps(_mm256_cmp_ps(distSq, limit, _CMP_LT_OQ));
+            hitMask[i / 32] |= (uint32_t)mask << (i % 32);
+            for (int bits = mask; bits != 0; bits &= bits - 1) {
+                hits++;
+            }
+        }
+    }
+#endif
+
+#if defined(PHYSICS_USE_SSE)
+    {
+        const __m128 limit = _mm_set1_ps(radiusSq);
+        const __m128 p[3] = {_mm_set1_ps(sphere.center.x), _mm_set1_ps(sphere.center.y),
+                             _mm_set1_ps(sphere.center.z)};
+
+        for (; i + 4 <= count; i += 4) {
+            __m128 distSq = _mm_setzero_ps();
+            for (int c = 0; c < 3; c++) {
+                __m128 clamped = _mm_min_ps(_mm_max_ps(p[c], _mm_loadu_ps(&boxes.min[c][i])),
+                                            _mm_loadu_ps(&boxes.max[c][i]));
+                __m128 d = _mm_sub_ps(p[c], clamped);
+                distSq = _mm_add_ps(distSq, _mm_mul_ps(d, d));
+            }
+
+            int mask = _mm_movemask_ps(_mm_cmplt_ps(distSq, limit));
+            hitMask[i / 32] |= (uint32_t)mask << (i % 32);
+            for (int bits = mask; bits != 0; bits &= bits - 1) {
+                hits++;
+            }
+        }
+    }
+#endif
+
+    // Remainder (or everything without SIMD)
+    for (; i < count; i++) {
+        float distSq = 0.0f;
+        for (int c = 0; c < 3; c++) {
+            float p = sphere.center[c];
+            float d = p - std::min(std::max(p, boxes.min[c][i]), boxes.max[c][i]);
+            distSq += d * d;
+        }
+        if (distSq < radiusSq) {
+            hitMask[i / 32] |= 1u << (i % 32);
+            hits++;
+        }
+    }
+
+    return hits;
+}
+
 glm::vec3 Physics::resolveAABBCollision(const AABB& moving, const AABB& stationary, const glm::vec3& velocity) {
     if (!moving.intersects(stationary)) {
         return velocity;
@@ -76,6 +458,11 @@ Sphere Physics::createSphereFromTransform(const glm::vec3& position, float radiu
     return Sphere(position, radius);
 }
 
+OBB Physics::createOBBFromTransform(const glm::vec3& position, const glm::quat& rotation,
+                                    const glm::vec3& size) {
+    return OBB(position, rotation, size * 0.5f);
+}
+
 bool Physics::rayIntersectAABB(const glm::vec3& rayOrigin, const glm::vec3& rayDir, const AABB& box, float& t) {
     // Slab method
     glm::vec3 dirInv = 1.0f / rayDir;
@@ -105,3 +492,175 @@ bool Physics::rayIntersectAABB(const glm::vec3& rayOrigin, const glm::vec3& rayD
     t = tmin;
     return true;
 }
+
+bool Physics::sweepSphereAABB(const Sphere& sphere, const glm::vec3& displacement,
+                              const AABB& box, float& t, glm::vec3& normal) {
+    float length = glm::length(displacement);
+    if (length < 1e-6f) {
+        return false;
+    }
+
+    // Already touching: block only the part of the motion heading inward
+    glm::vec3 closest = glm::clamp(sphere.center, box.min, box.max);
+    float distance = glm::length(sphere.center - closest);
+    if (distance < sphere.radius) {
+        glm::vec3 n = distance > 1e-6f ? (sphere.center - closest) / distance
+                                       : nearestFaceNormal(sphere.center, box);
+        if (glm::dot(displacement, n) >= 0.0f) {
+            return false;
+        }
+        t = 0.0f;
+        normal = n;
+        return true;
+    }
+
+    // The swept sphere can only touch the box if its center enters the box
+    // grown by the radius
+    glm::vec3 grow(sphere.radius);
+    float time;
+    if (!segmentIntersectAABB(sphere.center, displacement,
+                              AABB(box.min - grow, box.max + grow), time)) {
+        return false;
+    }
+
+    // The grown box has square edges and corners where the real swept shape
+    // is rounded, so step forward by the remaining gap until touching. Exact
+    // on faces, converges quickly near edges and corners.
+    for (int i = 0; i < kMaxAdvanceSteps; i++) {
+        glm::vec3 center = sphere.center + displacement * time;
+        closest = glm::clamp(center, box.min, box.max);
+        float gap = glm::length(center - closest) - sphere.radius;
+        if (gap <= kContactTolerance) {
+            t = time;
+            normal = glm::normalize(center - closest);
+            return true;
+        }
+        time += gap / length;
+        if (time > 1.0f) {
+            return false;
+        }
+    }
+
+    return false; // Grazing pass that never got within tolerance
+}
+
+bool Physics::sweepSphereOBB(const Sphere& sphere, const glm::vec3& displacement,
+                             const OBB& box, float& t, glm::vec3& normal) {
+    // Sweep in the box's frame, where it is an AABB centered at the origin
+    glm::vec3 offset = sphere.center - box.center;
+    glm::vec3 localCenter(glm::dot(offset, box.axes[0]), glm::dot(offset, box.axes[1]),
+                          glm::dot(offset, box.axes[2]));
+    glm::vec3 localDisplacement(glm::dot(displacement, box.axes[0]),
+                                glm::dot(displacement, box.axes[1]),
+                                glm::dot(displacement, box.axes[2]));
+
+    glm::vec3 localNormal;
+    if (!sweepSphereAABB(Sphere(localCenter, sphere.radius), localDisplacement,
+                         AABB(-box.halfExtents, box.halfExtents), t, localNormal)) {
+        return false;
+    }
+
+    normal = box.axes[0] * localNormal.x + box.axes[1] * localNormal.y +
+             box.axes[2] * localNormal.z;
+    return true;
+}
+
+UniformGrid::UniformGrid() : origin(0.0f), cellSize(1.0f), boxCount(0) {
+    dims[0] = dims[1] = dims[2] = 0;
+}
+
+void UniformGrid::clear() {
+    dims[0] = dims[1] = dims[2] = 0;
+    boxCount = 0;
+    cellStart.clear();
+    cellItems.clear();
+}
+
+void UniformGrid::build(const std::vector<AABB>& boxes, float size) {
+    clear();
+    boxCount = boxes.size();
+    if (boxes.empty()) {
+        return;
+    }
+
+    glm::vec3 lo = boxes[0].min;
+    glm::vec3 hi = boxes[0].max;
+    for (const AABB& box : boxes) {
+        lo = glm::min(lo, box.min);
+        hi = glm::max(hi, box.max);
+    }
+
+    // Grow the cells for very large levels to keep the grid bounded
+    glm::vec3 extent = hi - lo;
+    cellSize = size;
+    while (true) {
+        size_t cells = 1;
+        for (int axis = 0; axis < 3; axis++) {
+            dims[axis] = std::max(1, (int)std::ceil(extent[axis] / cellSize));
+            cells *= dims[axis];
+        }
+        if (cells <= kMaxGridCells) {
+            break;
+        }
+        cellSize *= 2.0f;
+    }
+    origin = lo;
+
+    // Counting pass, then prefix sum, then fill (compact, no per-cell vectors)
+    size_t cellCount = (size_t)dims[0] * dims[1] * dims[2];
+    cellStart.assign(cellCount + 1, 0);
+    int cLo[3], cHi[3];
+    for (const AABB& box : boxes) {
+        cellRange(box, cLo, cHi);
+        for (int z = cLo[2]; z <= cHi[2]; z++)
+            for (int y = cLo[1]; y <= cHi[1]; y++)
+                for (int x = cLo[0]; x <= cHi[0]; x++)
+                    cellStart[((size_t)z * dims[1] + y) * dims[0] + x + 1]++;
+    }
+    for (size_t c = 0; c < cellCount; c++) {
+        cellStart[c + 1] += cellStart[c];
+    }
+
+    cellItems.resize(cellStart[cellCount]);
+    std::vector<uint32_t> fill(cellStart.begin(), cellStart.end() - 1);
+    for (size_t i = 0; i < boxes.size(); i++) {
+        cellRange(boxes[i], cLo, cHi);
+        for (int z = cLo[2]; z <= cHi[2]; z++)
+            for (int y = cLo[1]; y <= cHi[1]; y++)
+                for (int x = cLo[0]; x <= cHi[0]; x++)
+                    cellItems[fill[((size_t)z * dims[1] + y) * dims[0] + x]++] = (uint32_t)i;
+    }
+}
+
+void UniformGrid::query(const AABB& region, std::vector<uint32_t>& results) const {
+    results.clear();
+    if (cellStart.empty()) {
+        return;
+    }
+
+    int cLo[3], cHi[3];
+    cellRange(region, cLo, cHi);
+    for (int z = cLo[2]; z <= cHi[2]; z++) {
+        for (int y = cLo[1]; y <= cHi[1]; y++) {
+            for (int x = cLo[0]; x <= cHi[0]; x++) {
+                size_t cell = ((size_t)z * dims[1] + y) * dims[0] + x;
+                results.insert(results.end(), cellItems.begin() + cellStart[cell],
+                               cellItems.begin() + cellStart[cell + 1]);
+            }
+        }
+    }
+
+    // Boxes spanning several cells show up once per cell
+    std::sort(results.begin(), results.end());
+    results.erase(std::unique(results.begin(), results.end()), results.end());
+}
+
+void UniformGrid::cellRange(const AABB& box, int lo[3], int hi[3]) const {
+    // Clamped, so regions outside the grid map onto its border cells
+    for (int axis = 0; axis < 3; axis++) {
+        lo[axis] = (int)std::floor((box.min[axis] - origin[axis]) / cellSize);
+        hi[axis] = (int)std::floor((box.max[axis] - origin[axis]) / cellSize);
+        lo[axis] = std::min(std::max(lo[axis], 0), dims[axis] - 1);
+        hi[axis] = std::min(std::max(hi[axis], 0), dims[axis] - 1);
+    }
+}
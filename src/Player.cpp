@@ -1,14 +1,14 @@
 #include "Player.h"
 #include "AudioManager.h"
-#include "Input.h"
-#include "Shader.h"
+#include "RenderSnapshot.h"
 #include <GLFW/glfw3.h>
 #include <cmath>
 #include <iostream>
 
 Player::Player()
     : moveSpeed(8.0f), hoverHeight(1.0f), bobSpeed(2.0f), bobAmount(0.1f),
-      velocity(0.0f), isFlashing(false), flashTimer(0.0f),
+      velocity(0.0f), previousPosition(0.0f, hoverHeight, 0.0f),
+      isFlashing(false), flashTimer(0.0f),
       fragmentRotationSpeed(1.0f), currentBobOffset(0.0f), walkBobOffset(0.0f),
       cameraYaw(0.0f), controlsEnabled(true), damageFlashIntensity(0.0f),
       collisionCooldown(0.0f), hearts(4), maxHearts(4) {
@@ -55,7 +55,8 @@ Player::Player()
 
 Player::~Player() {}
 
-void Player::update(float deltaTime, const glm::vec3 &moveInput) {
+void Player::update(float deltaTime, const glm::vec3 &moveInput,
+                    bool jumpPressed) {
   // Update damage flash
   if (damageFlashIntensity > 0.0f) {
     damageFlashIntensity -= deltaTime * 2.0f; // Fade out over 0.5 seconds
@@ -117,8 +118,7 @@ void Player::update(float deltaTime, const glm::vec3 &moveInput) {
       (std::abs(velocity.y) < 0.1f && transform.position.y >= groundLevel);
 
   // Jump input (SPACE key) - only if controls enabled
-  if (controlsEnabled && Input::getInstance().isKeyJustPressed(KEY_SPACE) &&
-      isGrounded) {
+  if (controlsEnabled && jumpPressed && isGrounded) {
     velocity.y = 8.0f; // Jump force
   }
 
@@ -197,24 +197,15 @@ void Player::updateFragments(float deltaTime, float movementMagnitude) {
   }
 }
 
-void Player::draw(Shader *shader) {
+void Player::draw(RenderSnapshot &snapshot) const {
   // Draw core (Ancient Gold)
   glm::vec3 coreColor =
       isFlashing ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.8f, 0.7f, 0.2f);
 
-  shader->setMat4("model", transform.getModelMatrix());
-  shader->setVec3("objectColor", coreColor);
-  shader->setBool("useTexture", false);
-  shader->setFloat("shininess", 64.0f);
-  shader->setFloat("shininess", 64.0f);
-
   if (playerModel && !playerModel->meshes.empty()) {
-    // Draw the imported model
-
-    // 1. Disable culling temporarily (fixes inside-out models)
-    glDisable(GL_CULL_FACE);
-
-    glm::mat4 modelMatrix = transform.getModelMatrix();
+    // Draw the imported model. The fixed offsets below go into `post` so the
+    // player transform itself can still be interpolated.
+    glm::mat4 modelMatrix = glm::mat4(1.0f);
 
     // Apply camera yaw rotation first (rotate the model to face camera
     // direction)
@@ -240,41 +231,36 @@ void Player::draw(Shader *shader) {
     // Fix upright orientation (X-axis rotation)
     modelMatrix =
         glm::rotate(modelMatrix, glm::radians(-90.0f), glm::vec3(1, 0, 0));
-    shader->setMat4("model", modelMatrix);
-
-    // 4. Set a bright default color (white) so it's visible even without
-    // textures
-    shader->setVec3("objectColor", glm::vec3(1.0f, 1.0f, 1.0f));
 
-    playerModel->draw(shader);
-
-    // Re-enable culling
-    glEnable(GL_CULL_FACE);
+    // Bright default color (white) so it's visible even without textures.
+    // Culling is disabled for the model (fixes inside-out models).
+    RenderInstance &body =
+        snapshot.addInstance(this, transform, glm::vec3(1.0f, 1.0f, 1.0f));
+    body.model = playerModel.get();
+    body.post = modelMatrix;
+    body.shininess = 64.0f;
+    body.doubleSided = true;
   } else {
     // Fallback to procedural mesh
-    shader->setVec3("objectColor", coreColor);
-    coreMesh->draw();
-  }
-
-  // Draw Head (Floating above) - Only if no model loaded
-  if (!playerModel || playerModel->meshes.empty()) {
-    glm::mat4 headModel = transform.getModelMatrix();
-    headModel =
-        glm::translate(headModel, glm::vec3(0.0f, 0.6f, 0.0f)); // Float above
-
-    shader->setMat4("model", headModel);
-    shader->setVec3("objectColor", coreColor); // Same gold color
-    headMesh->draw();
+    RenderInstance &core = snapshot.addInstance(this, transform, coreColor);
+    core.mesh = coreMesh.get();
+    core.shininess = 64.0f;
+
+    // Draw Head (Floating above) - Only if no model loaded
+    RenderInstance &head = snapshot.addInstance(this, transform, coreColor, 1);
+    head.mesh = headMesh.get();
+    head.post = glm::translate(glm::mat4(1.0f),
+                               glm::vec3(0.0f, 0.6f, 0.0f)); // Float above
+    head.shininess = 64.0f;
   }
 
   // Draw fragments (Ancient Stone/Energy)
   glm::vec3 fragmentColor =
       glm::vec3(0.4f, 0.8f, 1.0f); // Glowing blue energy stones
   for (const auto &frag : fragments) {
-    shader->setMat4("model", frag.transform.getModelMatrix());
-    shader->setVec3("objectColor", fragmentColor);
-    shader->setFloat("shininess", 32.0f);
-    frag.mesh->draw();
+    RenderInstance &instance =
+        snapshot.addInstance(&frag, frag.transform, fragmentColor);
+    instance.mesh = frag.mesh.get();
   }
 }
 
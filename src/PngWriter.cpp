@@ -0,0 +1,114 @@
+#include "PngWriter.h"
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace {
+// Largest payload of one stored deflate block
+const size_t kMaxStoredBlock = 65535;
+
+uint32_t crc32(const unsigned char *data, size_t size, uint32_t crc) {
+  static uint32_t table[256];
+  static bool tableReady = false;
+  if (!tableReady) {
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t value = i;
+      for (int bit = 0; bit < 8; bit++)
+        value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+      table[i] = value;
+    }
+    tableReady = true;
+  }
+
+  crc = ~crc;
+  for (size_t i = 0; i < size; i++)
+    crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  return ~crc;
+}
+
+void putBigEndian(std::vector<unsigned char> &out, uint32_t value) {
+  out.push_back((unsigned char)(value >> 24));
+  out.push_back((unsigned char)(value >> 16));
+  out.push_back((unsigned char)(value >> 8));
+  out.push_back((unsigned char)value);
+}
+
+// Length, type, data, CRC of type and data
+void putChunk(std::vector<unsigned char> &out, const char *type,
+              const std::vector<unsigned char> &data) {
+  putBigEndian(out, (uint32_t)data.size());
+  size_t typeStart = out.size();
+  out.insert(out.end(), type, type + 4);
+  out.insert(out.end(), data.begin(), data.end());
+  putBigEndian(out, crc32(out.data() + typeStart, out.size() - typeStart, 0));
+}
+} // namespace
+
+bool writePng(const std::string &path, int width, int height,
+              const unsigned char *pixels, bool flipVertically) {
+  if (width <= 0 || height <= 0 || !pixels)
+    return false;
+
+  // Scanlines, each prefixed with filter type 0 (none)
+  const size_t rowBytes = (size_t)width * 4;
+  std::vector<unsigned char> raw;
+  raw.reserve((rowBytes + 1) * height);
+  for (int y = 0; y < height; y++) {
+    int row = flipVertically ? height - 1 - y : y;
+    const unsigned char *source = pixels + row * rowBytes;
+    raw.push_back(0);
+    raw.insert(raw.end(), source, source + rowBytes);
+  }
+
+  // zlib stream of stored blocks, then the Adler-32 of the raw data
+  std::vector<unsigned char> idat;
+  idat.reserve(raw.size() + raw.size() / kMaxStoredBlock * 5 + 16);
+  idat.push_back(0x78); // Deflate, 32K window
+  idat.push_back(0x01); // No preset dictionary, fastest; header % 31 == 0
+  uint32_t adlerA = 1, adlerB = 0;
+  size_t offset = 0;
+  do {
+    size_t blockSize = std::min(kMaxStoredBlock, raw.size() - offset);
+    bool last = offset + blockSize == raw.size();
+    idat.push_back(last ? 1 : 0);
+    idat.push_back((unsigned char)blockSize);
+    idat.push_back((unsigned char)(blockSize >> 8));
+    idat.push_back((unsigned char)~blockSize);
+    idat.push_back((unsigned char)(~blockSize >> 8));
+    idat.insert(idat.end(), raw.begin() + offset,
+                raw.begin() + offset + blockSize);
+    for (size_t i = offset; i < offset + blockSize; i++) {
+      adlerA = (adlerA + raw[i]) % 65521;
+      adlerB = (adlerB + adlerA) % 65521;
+    }
+    offset += blockSize;
+  } while (offset < raw.size());
+  putBigEndian(idat, (adlerB << 16) | adlerA);
+
+  std::vector<unsigned char> header;
+  putBigEndian(header, (uint32_t)width);
+  putBigEndian(header, (uint32_t)height);
+  header.push_back(8); // Bit depth
+  header.push_back(6); // Color type: RGBA
+  header.push_back(0); // Compression: deflate
+  header.push_back(0); // Filter method
+  header.push_back(0); // No interlace
+
+  static const unsigned char signature[8] = {0x89, 'P',  'N',  'G',
+                                             '\r', '\n', 0x1A, '\n'};
+  std::vector<unsigned char> file(signature, signature + 8);
+  putChunk(file, "IHDR", header);
+  putChunk(file, "IDAT", idat);
+  putChunk(file, "IEND", std::vector<unsigned char>());
+
+  std::ofstream output(path, std::ios::binary | std::ios::trunc);
+  output.write(reinterpret_cast<const char *>(file.data()),
+               (std::streamsize)file.size());
+  if (!output) {
+    std::cerr << "ERROR::PNG::CANNOT_WRITE " << path << std::endl;
+    return false;
+  }
+  return true;
+}
@@ -1 +1,741 @@
-// Renderer implementation placeholder
+#include "Renderer.h"
+#include "ParticleSystem.h"
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+namespace {
+// Uniform names for the light array, built once instead of every frame
+const int kMaxLights = 32;
+
+struct LightUniformNames {
+  std::string position[kMaxLights];
+  std::string color[kMaxLights];
+  std::string intensity[kMaxLights];
+
+  LightUniformNames() {
+    for (int i = 0; i < kMaxLights; i++) {
+      std::string base = "lights[" + std::to_string(i) + "]";
+      position[i] = base + ".position";
+      color[i] = base + ".color";
+      intensity[i] = base + ".intensity";
+    }
+  }
+};
+
+const LightUniformNames &lightUniformNames() {
+  static const LightUniformNames names;
+  return names;
+}
+
+// Specialized builds of the main shader: one per procedural material, plus
+// one for textured objects (textures replace the procedural materials)
+const uint32_t kMaterialCount = 6;
+const uint32_t kTexturedVariant = kMaterialCount;
+const uint32_t kGenericVariant = kMaterialCount + 1; // Uniform-driven shader
+
+uint32_t materialVariant(const RenderInstance &instance) {
+  if (instance.texture)
+    return kTexturedVariant;
+  if (instance.materialType >= 0 &&
+      instance.materialType < (int)kMaterialCount)
+    return (uint32_t)instance.materialType;
+  return kGenericVariant;
+}
+
+std::string materialDefines(uint32_t variant) {
+  if (variant == kTexturedVariant)
+    return "#define MATERIAL_TYPE 0\n#define USE_TEXTURE true\n";
+  return "#define MATERIAL_TYPE " + std::to_string(variant) +
+         "\n#define USE_TEXTURE false\n";
+}
+
+Transform interpolate(const Transform &from, const Transform &to,
+                      float alpha) {
+  Transform result;
+  result.position = glm::mix(from.position, to.position, alpha);
+  result.rotation = glm::slerp(from.rotation, to.rotation, alpha);
+  result.scale = glm::mix(from.scale, to.scale, alpha);
+  return result;
+}
+} // namespace
+
+Renderer::Renderer()
+    : shaderDirectory("shaders"), screenQuadVAO(0), screenQuadVBO(0), screenScale(1.0f), screenFBO(0),
+      screenColor(0), screenTargetWidth(0), screenTargetHeight(0),
+      frameNumber(0), sceneTime(-1.0),
+      gpuTiming(false), nextTimerQuery(0) {
+  for (int i = 0; i < kTimerQueryCount; i++) {
+    timerQueries[i] = 0;
+    timerFrames[i] = 0;
+    timerPending[i] = false;
+  }
+  for (int i = 0; i < kShaderCount; i++)
+    shaders[i] = nullptr;
+}
+
+Renderer::~Renderer() { cleanup(); }
+
+bool Renderer::init() {
+  // Load shaders. These only submit the compiles (or load cached binaries);
+  // drivers with parallel shader compile build them while the rest loads.
+  const std::string dir = shaderDirectory + "/";
+  mainShader = std::make_unique<Shader>((dir + "vertex.glsl").c_str(),
+                                        (dir + "fragment.glsl").c_str());
+  materialShaders = std::make_unique<ShaderPermutations>(
+      (dir + "vertex.glsl").c_str(), (dir + "fragment.glsl").c_str(),
+      materialDefines);
+  particleShader =
+      std::make_unique<Shader>((dir + "particle_vertex.glsl").c_str(),
+                               (dir + "particle_fragment.glsl").c_str());
+  startScreenShader =
+      std::make_unique<Shader>((dir + "start_screen_vertex.glsl").c_str(),
+                               (dir + "start_screen_fragment.glsl").c_str());
+  gameOverShader =
+      std::make_unique<Shader>((dir + "game_over_vertex.glsl").c_str(),
+                               (dir + "game_over_fragment.glsl").c_str());
+  winScreenShader =
+      std::make_unique<Shader>((dir + "win_screen_vertex.glsl").c_str(),
+                               (dir + "win_screen_fragment.glsl").c_str());
+
+  // Fullscreen quad for the start / game over / win screens
+  initScreenQuad();
+
+  // Load heart model for UI
+  heartModel = std::make_unique<Model>("assets/models/aztec_stone_heart.glb");
+
+  // Overlay meshes are built once up front rather than on first use
+  flashQuad = std::unique_ptr<Mesh>(Mesh::createCube(1.0f));
+  heartMesh = std::unique_ptr<Mesh>(Mesh::createHeart(1.0f));
+
+  // Wait for the shaders; errors are printed, the game still runs
+  shaders[0] = mainShader.get();
+  shaders[1] = particleShader.get();
+  shaders[2] = startScreenShader.get();
+  shaders[3] = gameOverShader.get();
+  shaders[4] = winScreenShader.get();
+  for (Shader *shader : shaders)
+    shader->finish();
+
+  return true;
+}
+
+void Renderer::setShaderHotReload(bool enabled) {
+  if (!enabled) {
+    shaderWatcher.reset();
+    return;
+  }
+  if (shaderWatcher || !mainShader)
+    return;
+  shaderWatcher = std::make_unique<ShaderWatcher>();
+  for (Shader *shader : shaders) {
+    shaderWatcher->watch(shader->getVertexPath());
+    shaderWatcher->watch(shader->getFragmentPath());
+  }
+  std::cout << "Watching shaders for changes" << std::endl;
+}
+
+void Renderer::updateShaders() {
+  if (!shaderWatcher)
+    return;
+
+  changedShaderFiles.clear();
+  shaderWatcher->poll(changedShaderFiles);
+  for (const std::string &path : changedShaderFiles) {
+    for (Shader *shader : shaders) {
+      if (shader->usesFile(path))
+        shader->reload();
+    }
+    if (materialShaders->usesFile(path))
+      materialShaders->reload();
+  }
+
+  // Builds still compiling are picked up on a later frame
+  for (Shader *shader : shaders)
+    shader->update();
+  materialShaders->update();
+}
+
+void Renderer::cleanup() {
+  shaderWatcher.reset();
+  if (timerQueries[0]) {
+    glDeleteQueries(kTimerQueryCount, timerQueries);
+    for (int i = 0; i < kTimerQueryCount; i++) {
+      timerQueries[i] = 0;
+      timerPending[i] = false;
+    }
+  }
+  if (screenQuadVAO) {
+    glDeleteVertexArrays(1, &screenQuadVAO);
+    screenQuadVAO = 0;
+  }
+  if (screenQuadVBO) {
+    glDeleteBuffers(1, &screenQuadVBO);
+    screenQuadVBO = 0;
+  }
+  if (screenFBO) {
+    glDeleteFramebuffers(1, &screenFBO);
+    glDeleteRenderbuffers(1, &screenColor);
+    screenFBO = 0;
+    screenColor = 0;
+    screenTargetWidth = 0;
+    screenTargetHeight = 0;
+  }
+
+  // These own GL objects, release them while the context is alive
+  flashQuad.reset();
+  heartMesh.reset();
+  heartModel.reset();
+  mainShader.reset();
+  materialShaders.reset();
+  particleShader.reset();
+  startScreenShader.reset();
+  gameOverShader.reset();
+  winScreenShader.reset();
+}
+
+void Renderer::render(const RenderSnapshot *previous,
+                      const RenderSnapshot &current, float alpha, int width,
+                      int height, ParticleSystem *particles) {
+  stats = RenderStats();
+
+  int slot = nextTimerQuery;
+  if (gpuTiming) {
+    // The slot's last query is kTimerQueryCount frames old by now
+    if (timerPending[slot])
+      readTimerQuery(slot);
+    glBeginQuery(GL_TIME_ELAPSED, timerQueries[slot]);
+  }
+
+  renderContents(previous, current, alpha, width, height, particles);
+
+  if (gpuTiming) {
+    glEndQuery(GL_TIME_ELAPSED);
+    timerFrames[slot] = frameNumber;
+    timerPending[slot] = true;
+    nextTimerQuery = (slot + 1) % kTimerQueryCount;
+  }
+  frameNumber++;
+}
+
+void Renderer::setGpuTiming(bool enabled) {
+  if (enabled && !timerQueries[0])
+    glGenQueries(kTimerQueryCount, timerQueries);
+  gpuTiming = enabled;
+}
+
+void Renderer::readTimerQuery(int slot) {
+  GLuint64 nanoseconds = 0;
+  glGetQueryObjectui64v(timerQueries[slot], GL_QUERY_RESULT, &nanoseconds);
+  readyGpuTimes.push_back(
+      std::make_pair(timerFrames[slot], nanoseconds * 1e-9));
+  timerPending[slot] = false;
+}
+
+void Renderer::collectGpuTimes(std::vector<std::pair<uint64_t, double>> &times,
+                               bool wait) {
+  // Oldest first, so frames come out in order
+  for (int i = 0; i < kTimerQueryCount; i++) {
+    int slot = (nextTimerQuery + i) % kTimerQueryCount;
+    if (!timerPending[slot])
+      continue;
+    if (!wait) {
+      GLint available = 0;
+      glGetQueryObjectiv(timerQueries[slot], GL_QUERY_RESULT_AVAILABLE,
+                         &available);
+      if (!available)
+        break;
+    }
+    readTimerQuery(slot);
+  }
+
+  times.insert(times.end(), readyGpuTimes.begin(), readyGpuTimes.end());
+  readyGpuTimes.clear();
+}
+
+void Renderer::countDraw(const Mesh &mesh) {
+  stats.drawCalls++;
+  stats.triangles += mesh.indexCount / 3;
+}
+
+void Renderer::renderContents(const RenderSnapshot *previous,
+                              const RenderSnapshot &current, float alpha,
+                              int width, int height,
+                              ParticleSystem *particles) {
+  // Only blend between two ticks of the same screen
+  if (previous && previous->state != current.state)
+    previous = nullptr;
+
+  switch (current.state) {
+  case GameState::START_SCREEN:
+    renderScreen(startScreenShader.get(), current.screenTime, width, height);
+    return;
+  case GameState::GAME_OVER:
+    renderScreen(gameOverShader.get(), current.screenTime, width, height);
+    return;
+  case GameState::WIN:
+    renderScreen(winScreenShader.get(), current.screenTime, width, height);
+    return;
+  default:
+    break;
+  }
+
+  // Normal sky blue background
+  glClearColor(0.1f, 0.1f, 0.15f, 1.0f);
+  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+  if (current.state == GameState::LEVEL1 ||
+      current.state == GameState::LEVEL2) {
+    renderScene(previous, current, alpha, width, height, particles);
+  }
+}
+
+void Renderer::renderScene(const RenderSnapshot *previous,
+                           const RenderSnapshot &current, float alpha,
+                           int width, int height, ParticleSystem *particles) {
+  // Camera
+  camera.position = current.cameraPosition;
+  camera.front = current.cameraFront;
+  camera.up = current.cameraUp;
+  camera.fov = current.cameraFov;
+  camera.mode = current.cameraMode;
+  if (previous && previous->cameraMode == current.cameraMode) {
+    camera.position =
+        glm::mix(previous->cameraPosition, current.cameraPosition, alpha);
+    glm::vec3 front = glm::mix(previous->cameraFront, current.cameraFront, alpha);
+    if (glm::length(front) > 0.001f) {
+      camera.front = glm::normalize(front);
+    }
+  }
+
+  glm::mat4 projection = camera.getProjectionMatrix((float)width / height);
+  glm::mat4 view = camera.getViewMatrix();
+  float time = sceneTime >= 0.0 ? (float)sceneTime : (float)glfwGetTime();
+
+  // Draw in batches of one shader variant each, so every material only
+  // runs its own code and each variant is bound once. Transparency is
+  // dithered rather than blended, so the order does not matter otherwise.
+  drawOrder.clear();
+  for (size_t i = 0; i < current.instances.size(); i++) {
+    drawOrder.push_back(
+        ((uint64_t)materialVariant(current.instances[i]) << 32) | i);
+  }
+  std::sort(drawOrder.begin(), drawOrder.end());
+
+  // Variants seen for the first time all start compiling before the first
+  // one is waited on
+  for (size_t i = 0; i < drawOrder.size(); i++) {
+    uint32_t variant = (uint32_t)(drawOrder[i] >> 32);
+    if (variant != kGenericVariant &&
+        (i == 0 || variant != (uint32_t)(drawOrder[i - 1] >> 32)))
+      materialShaders->prepare(variant);
+  }
+
+  // Instances are paired with the previous tick by position in the list,
+  // falling back to the current transform when the lists no longer line up
+  // (objects added or removed).
+  Shader *shader = nullptr;
+  uint32_t boundVariant = kGenericVariant + 1;
+  bool genericUsed = false;
+  for (uint64_t entry : drawOrder) {
+    uint32_t variant = (uint32_t)(entry >> 32);
+    size_t i = (size_t)(entry & 0xFFFFFFFFu);
+    if (variant != boundVariant) {
+      shader = variant == kGenericVariant ? nullptr
+                                          : materialShaders->get(variant);
+      if (!shader)
+        shader = mainShader.get(); // Uniform-driven fallback
+      beginMaterialBatch(shader, projection, view, time, current);
+      boundVariant = variant;
+      genericUsed = genericUsed || shader == mainShader.get();
+    }
+
+    const RenderInstance &instance = current.instances[i];
+    if (previous && i < previous->instances.size() &&
+        previous->instances[i].key == instance.key) {
+      drawInstance(shader, instance,
+                   interpolate(previous->instances[i].transform,
+                               instance.transform, alpha));
+    } else {
+      drawInstance(shader, instance, instance.transform);
+    }
+  }
+
+  // The overlays below draw with the generic shader and take the scene's
+  // clock and ambient light from it
+  if (!genericUsed) {
+    mainShader->use();
+    stats.stateChanges++;
+    mainShader->setFloat("time", time);
+    mainShader->setVec3("ambientLight", current.ambientLight);
+    mainShader->setInt("materialType", 0);
+  }
+
+  // Draw particles
+  particleShader->use();
+  particleShader->setMat4("projection", projection);
+  particleShader->setMat4("view", view);
+  particles->draw(current.particles.data(), (int)current.particles.size());
+  stats.stateChanges++;
+  if (!current.particles.empty()) {
+    stats.drawCalls++;
+    stats.stateChanges += 4; // Blend and point size, on and off
+  }
+
+  // Draw damage flash overlay (CoD style - thin edges with blood splatter
+  // lines)
+  if (current.damageFlash > 0.0f) {
+    renderDamageFlash(current.damageFlash);
+  }
+
+  // Render hearts UI
+  renderHearts(current.hearts, current.maxHearts);
+}
+
+void Renderer::beginMaterialBatch(Shader *shader, const glm::mat4 &projection,
+                                  const glm::mat4 &view, float time,
+                                  const RenderSnapshot &snapshot) {
+  shader->use();
+  stats.stateChanges++;
+
+  // Initialize texture sampler to use texture unit 0
+  shader->setInt("textureSampler", 0);
+
+  shader->setMat4("projection", projection);
+  shader->setMat4("view", view);
+  shader->setVec3("viewPos", camera.position);
+  shader->setFloat("time", time);
+
+  // Set lighting
+  applyLights(shader, snapshot);
+}
+
+void Renderer::applyLights(Shader *shader, const RenderSnapshot &snapshot) {
+  shader->setVec3("ambientLight", snapshot.ambientLight);
+  // Increased limit to 32 to match shader update
+  int numLights = std::min((int)snapshot.lights.size(), kMaxLights);
+  shader->setInt("numLights", numLights);
+
+  const LightUniformNames &names = lightUniformNames();
+  for (int i = 0; i < numLights; i++) {
+    const LightState &light = snapshot.lights[i];
+    shader->setVec3(names.position[i], light.position);
+    shader->setVec3(names.color[i], light.color);
+    shader->setFloat(names.intensity[i], light.intensity);
+  }
+}
+
+void Renderer::drawInstance(Shader *shader, const RenderInstance &instance,
+                            const Transform &transform) {
+  glm::mat4 modelMat = transform.getModelMatrix() * instance.post;
+  shader->setMat4("model", modelMat);
+
+  // Calculate normal matrix for correct lighting with non-uniform scaling
+  glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(modelMat)));
+  shader->setMat3("normalMatrix", normalMatrix);
+  shader->setVec3("objectColor", instance.color);
+  shader->setFloat("transparency", instance.transparency);
+  shader->setFloat("emissive", instance.emissive);
+  shader->setFloat("shininess", instance.shininess);
+
+  // Specialized variants have these built in
+  bool generic = shader == mainShader.get();
+  if (generic)
+    shader->setInt("materialType", instance.materialType);
+
+  // Use texture if available
+  if (instance.texture) {
+    instance.texture->bind(0);
+    if (generic)
+      shader->setBool("useTexture", true);
+    stats.stateChanges++;
+  } else if (generic) {
+    shader->setBool("useTexture", false);
+  }
+
+  if (instance.doubleSided) {
+    glDisable(GL_CULL_FACE);
+    stats.stateChanges += 2;
+  }
+
+  if (instance.model) {
+    instance.model->draw(shader);
+    for (const auto &mesh : instance.model->meshes)
+      countDraw(*mesh);
+  } else if (instance.mesh) {
+    instance.mesh->draw();
+    countDraw(*instance.mesh);
+  }
+
+  if (instance.doubleSided)
+    glEnable(GL_CULL_FACE);
+
+  // Unbind texture
+  if (instance.texture) {
+    instance.texture->unbind();
+  }
+}
+
+void Renderer::renderDamageFlash(float intensity) {
+  glEnable(GL_BLEND);
+  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  glDisable(GL_DEPTH_TEST); // Draw on top of everything
+
+  mainShader->use();
+  stats.stateChanges += 4; // Blend on, depth off and back on, program
+  glm::mat4 identity = glm::mat4(1.0f);
+  mainShader->setMat4("projection", identity);
+  mainShader->setMat4("view", identity);
+  mainShader->setVec3("objectColor", glm::vec3(0.8f, 0.0f, 0.0f)); // Dark red
+  mainShader->setBool("useTexture", false);
+  mainShader->setFloat("emissive", 1.0f); // Make it glow (no lighting calc)
+  mainShader->setVec3("viewPos", glm::vec3(0, 0, 1)); // Dummy
+  mainShader->setInt("numLights", 0); // No lights for overlay
+
+  float alpha = intensity * 0.35f; // More transparent (max 35%)
+  mainShader->setFloat("transparency", alpha);
+
+  float edgeWidth = 0.08f; // Thinner edges
+
+  // Left edge (main)
+  mainShader->setMat4(
+      "model",
+      glm::translate(identity, glm::vec3(-1.0f + edgeWidth, 0.0f, 0.0f)) *
+          glm::scale(identity, glm::vec3(edgeWidth * 2.0f, 2.0f, 0.01f)));
+  flashQuad->draw();
+
+  // Right edge (main)
+  mainShader->setMat4(
+      "model",
+      glm::translate(identity, glm::vec3(1.0f - edgeWidth, 0.0f, 0.0f)) *
+          glm::scale(identity, glm::vec3(edgeWidth * 2.0f, 2.0f, 0.01f)));
+  flashQuad->draw();
+
+  // Blood splatter lines - diagonal streaks from corners
+  float lineAlpha = alpha * 0.7f; // Slightly more transparent
+  mainShader->setFloat("transparency", lineAlpha);
+
+  // Top-left diagonal lines
+  for (int i = 0; i < 3; i++) {
+    float offset = i * 0.12f;
+    glm::mat4 lineModel = glm::translate(
+        identity, glm::vec3(-0.85f + offset, 0.75f - offset * 0.5f, 0.0f));
+    lineModel =
+        glm::rotate(lineModel, glm::radians(-45.0f), glm::vec3(0, 0, 1));
+    lineModel =
+        glm::scale(lineModel, glm::vec3(0.25f - i * 0.05f, 0.015f, 0.01f));
+    mainShader->setMat4("model", lineModel);
+    flashQuad->draw();
+  }
+
+  // Top-right diagonal lines
+  for (int i = 0; i < 3; i++) {
+    float offset = i * 0.12f;
+    glm::mat4 lineModel = glm::translate(
+        identity, glm::vec3(0.85f - offset, 0.75f - offset * 0.5f, 0.0f));
+    lineModel = glm::rotate(lineModel, glm::radians(45.0f), glm::vec3(0, 0, 1));
+    lineModel =
+        glm::scale(lineModel, glm::vec3(0.25f - i * 0.05f, 0.015f, 0.01f));
+    mainShader->setMat4("model", lineModel);
+    flashQuad->draw();
+  }
+
+  // Bottom-left diagonal lines
+  for (int i = 0; i < 2; i++) {
+    float offset = i * 0.15f;
+    glm::mat4 lineModel = glm::translate(
+        identity, glm::vec3(-0.8f + offset, -0.7f + offset * 0.4f, 0.0f));
+    lineModel = glm::rotate(lineModel, glm::radians(35.0f), glm::vec3(0, 0, 1));
+    lineModel =
+        glm::scale(lineModel, glm::vec3(0.2f - i * 0.04f, 0.012f, 0.01f));
+    mainShader->setMat4("model", lineModel);
+    flashQuad->draw();
+  }
+
+  // Bottom-right diagonal lines
+  for (int i = 0; i < 2; i++) {
+    float offset = i * 0.15f;
+    glm::mat4 lineModel = glm::translate(
+        identity, glm::vec3(0.8f - offset, -0.7f + offset * 0.4f, 0.0f));
+    lineModel =
+        glm::rotate(lineModel, glm::radians(-35.0f), glm::vec3(0, 0, 1));
+    lineModel =
+        glm::scale(lineModel, glm::vec3(0.2f - i * 0.04f, 0.012f, 0.01f));
+    mainShader->setMat4("model", lineModel);
+    flashQuad->draw();
+  }
+
+  // 2 edges and 10 splatter lines, all the same quad
+  for (int i = 0; i < 12; i++)
+    countDraw(*flashQuad);
+
+  // Restore state
+  glEnable(GL_DEPTH_TEST);
+  mainShader->setFloat("emissive", 0.0f);
+  mainShader->setFloat("transparency", 1.0f);
+}
+
+void Renderer::renderHearts(int hearts, int maxHearts) {
+  mainShader->use();
+  stats.stateChanges += 5; // Program, depth and cull off and back on
+
+  // Set up orthographic-like projection for UI rendering
+  glm::mat4 identity = glm::mat4(1.0f);
+  mainShader->setMat4("projection", identity);
+  mainShader->setMat4("view", identity);
+  mainShader->setBool("useTexture", false);
+  mainShader->setFloat("transparency", 1.0f);
+  mainShader->setVec3("viewPos", glm::vec3(0, 0, 1));
+  mainShader->setInt("numLights", 0);
+
+  glDisable(GL_DEPTH_TEST); // Draw on top
+  glDisable(GL_CULL_FACE);  // Hearts are 2D, render both sides
+
+  // Draw hearts in top-right corner - MUCH BIGGER
+  float heartSize = 0.05f; // MUCH bigger hearts
+  float startX = 0.35f;    // Start position
+  float startY = 0.80f;    // Position from top
+  float spacing = 0.15f;   // Spacing between hearts
+
+  // Draw max hearts (4) - grey for lost hearts, red for current hearts
+  for (int i = 0; i < maxHearts; i++) {
+    float xPos = startX + i * spacing;
+    float yPos = startY;
+
+    glm::mat4 model = glm::translate(identity, glm::vec3(xPos, yPos, 0.0f));
+    model = glm::scale(model, glm::vec3(heartSize, heartSize, 1.0f));
+
+    if (i < hearts) {
+      // Full heart - bright red with strong glow
+      mainShader->setVec3("objectColor", glm::vec3(1.0f, 0.0f, 0.1f));
+      mainShader->setFloat("emissive", 1.0f);
+    } else {
+      // Empty heart - dark outline
+      mainShader->setVec3("objectColor", glm::vec3(0.3f, 0.15f, 0.15f));
+      mainShader->setFloat("emissive", 0.1f);
+    }
+
+    mainShader->setMat4("model", model);
+    heartMesh->draw();
+    countDraw(*heartMesh);
+  }
+
+  glEnable(GL_DEPTH_TEST);
+  glEnable(GL_CULL_FACE);
+  mainShader->setFloat("emissive", 0.0f);
+}
+
+void Renderer::initScreenQuad() {
+  // Create a fullscreen quad for the start screen
+  float quadVertices[] = {// positions   // texCoords
+                          -1.0f, 1.0f, 0.0f, 1.0f,  -1.0f, -1.0f,
+                          0.0f,  0.0f, 1.0f, -1.0f, 1.0f,  0.0f,
+
+                          -1.0f, 1.0f, 0.0f, 1.0f,  1.0f,  -1.0f,
+                          1.0f,  0.0f, 1.0f, 1.0f,  1.0f,  1.0f};
+
+  glGenVertexArrays(1, &screenQuadVAO);
+  glGenBuffers(1, &screenQuadVBO);
+
+  glBindVertexArray(screenQuadVAO);
+  glBindBuffer(GL_ARRAY_BUFFER, screenQuadVBO);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices,
+               GL_STATIC_DRAW);
+
+  // Position attribute
+  glEnableVertexAttribArray(0);
+  glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void *)0);
+  // TexCoord attribute
+  glEnableVertexAttribArray(1);
+  glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float),
+                        (void *)(2 * sizeof(float)));
+
+  glBindVertexArray(0);
+}
+
+void Renderer::setScreenScale(float scale) {
+  screenScale = std::min(std::max(scale, 0.1f), 1.0f);
+}
+
+void Renderer::renderScreen(Shader *shader, float time, int width,
+                            int height) {
+  // The menu shaders only depend on the quad's texture coordinates, so a
+  // smaller target shows the same picture, slightly softer
+  int targetWidth = std::max(1, (int)(width * screenScale + 0.5f));
+  int targetHeight = std::max(1, (int)(height * screenScale + 0.5f));
+  if (screenScale >= 1.0f || !resizeScreenTarget(targetWidth, targetHeight)) {
+    drawScreen(shader, time);
+    return;
+  }
+
+  // Render into the small target, then stretch it over whatever was bound
+  // (the window, or the flythrough's offscreen framebuffer)
+  GLint outputFBO = 0;
+  glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &outputFBO);
+  glBindFramebuffer(GL_FRAMEBUFFER, screenFBO);
+  glViewport(0, 0, targetWidth, targetHeight);
+  drawScreen(shader, time);
+
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, screenFBO);
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, (GLuint)outputFBO);
+  glBlitFramebuffer(0, 0, targetWidth, targetHeight, 0, 0, width, height,
+                    GL_COLOR_BUFFER_BIT, GL_LINEAR);
+  glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)outputFBO);
+  glViewport(0, 0, width, height);
+  stats.stateChanges += 3; // Framebuffer binds
+}
+
+void Renderer::drawScreen(Shader *shader, float time) {
+  glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+  glDisable(GL_DEPTH_TEST);
+
+  shader->use();
+  shader->setFloat("time", time);
+
+  // All menu screens share the same fullscreen quad
+  glBindVertexArray(screenQuadVAO);
+  glDrawArrays(GL_TRIANGLES, 0, 6);
+  glBindVertexArray(0);
+  stats.drawCalls++;
+  stats.triangles += 2;
+  stats.stateChanges += 3; // Program, depth off and back on
+
+  glEnable(GL_DEPTH_TEST);
+}
+
+bool Renderer::resizeScreenTarget(int width, int height) {
+  if (screenFBO && width == screenTargetWidth && height == screenTargetHeight)
+    return true;
+
+  if (!screenFBO) {
+    glGenFramebuffers(1, &screenFBO);
+    glGenRenderbuffers(1, &screenColor);
+  }
+  // Color only: the screens draw without depth testing
+  glBindRenderbuffer(GL_RENDERBUFFER, screenColor);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+  glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+  GLint outputFBO = 0;
+  glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &outputFBO);
+  glBindFramebuffer(GL_FRAMEBUFFER, screenFBO);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                            GL_RENDERBUFFER, screenColor);
+  bool complete =
+      glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+  glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)outputFBO);
+
+  if (!complete) {
+    std::cerr << "ERROR::RENDERER::SCREEN_TARGET_INCOMPLETE, drawing menus "
+                 "at full resolution"
+              << std::endl;
+    screenScale = 1.0f;
+    return false;
+  }
+  screenTargetWidth = width;
+  screenTargetHeight = height;
+  return true;
+}
@@ -1,8 +1,176 @@
 #include "Shader.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <vector>
 
-Shader::Shader(const char* vertexPath, const char* fragmentPath) {
+namespace {
+const char* const kCacheDirectory = "shader_cache";
+const char kCacheMagic[4] = {'C', 'G', 'S', 'B'};
+// Bump when anything baked into a binary changes outside the sources, like
+// the attribute bindings below
+const uint32_t kCacheVersion = 1;
+
+struct CacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t key;
+    uint32_t format;
+    uint32_t length;
+};
+
+uint64_t hashBytes(uint64_t hash, const void* data, size_t size) {
+    // FNV-1a
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+uint64_t hashString(uint64_t hash, const char* text) {
+    // The terminator too, so "ab" + "c" differs from "a" + "bc"
+    if (!text)
+        text = "";
+    return hashBytes(hash, text, std::strlen(text) + 1);
+}
+
+bool binaryCacheSupported() {
+    static int supported = -1;
+    if (supported < 0) {
+        GLint formats = 0;
+        if (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary)
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        supported = formats > 0;
+    }
+    return supported == 1;
+}
+
+bool parallelCompileSupported() {
+    static int supported = -1;
+    if (supported < 0) {
+        // Let the driver use as many compiler threads as it likes
+        if (GLEW_KHR_parallel_shader_compile) {
+            glMaxShaderCompilerThreadsKHR(0xFFFFFFFFu);
+            supported = 1;
+        } else if (GLEW_ARB_parallel_shader_compile) {
+            glMaxShaderCompilerThreadsARB(0xFFFFFFFFu);
+            supported = 1;
+        } else {
+            supported = 0;
+        }
+    }
+    return supported == 1;
+}
+
+// Current values of the plain uniforms of `from`, set on `to` by name.
+// Uniforms the new program dropped or renamed are skipped.
+void copyUniforms(GLuint from, GLuint to) {
+    GLint count = 0;
+    glGetProgramiv(from, GL_ACTIVE_UNIFORMS, &count);
+    GLint previous = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previous);
+    glUseProgram(to);
+
+    for (GLint i = 0; i < count; i++) {
+        char name[256];
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(from, (GLuint)i, sizeof(name), &length, &size, &type, name);
+
+        // Arrays are reported once as "name[0]"
+        std::string base(name, length);
+        if (size > 1 && base.size() > 3 && base.compare(base.size() - 3, 3, "[0]") == 0)
+            base.resize(base.size() - 3);
+
+        for (GLint element = 0; element < size; element++) {
+            std::string elementName = size > 1 ? base + "[" + std::to_string(element) + "]" : base;
+            GLint source = glGetUniformLocation(from, elementName.c_str());
+            GLint target = glGetUniformLocation(to, elementName.c_str());
+            if (source < 0 || target < 0)
+                continue;
+
+            GLfloat f[16];
+            GLint n[4];
+            switch (type) {
+            case GL_FLOAT:
+                glGetUniformfv(from, source, f);
+                glUniform1fv(target, 1, f);
+                break;
+            case GL_FLOAT_VEC2:
+                glGetUniformfv(from, source, f);
+                glUniform2fv(target, 1, f);
+                break;
+            case GL_FLOAT_VEC3:
+                glGetUniformfv(from, source, f);
+                glUniform3fv(target, 1, f);
+                break;
+            case GL_FLOAT_VEC4:
+                glGetUniformfv(from, source, f);
+                glUniform4fv(target, 1, f);
+                break;
+            case GL_FLOAT_MAT3:
+                glGetUniformfv(from, source, f);
+                glUniformMatrix3fv(target, 1, GL_FALSE, f);
+                break;
+            case GL_FLOAT_MAT4:
+                glGetUniformfv(from, source, f);
+                glUniformMatrix4fv(target, 1, GL_FALSE, f);
+                break;
+            case GL_INT:
+            case GL_BOOL:
+            case GL_SAMPLER_2D:
+            case GL_SAMPLER_3D:
+            case GL_SAMPLER_CUBE:
+            case GL_SAMPLER_2D_SHADOW:
+                glGetUniformiv(from, source, n);
+                glUniform1iv(target, 1, n);
+                break;
+            default:
+                break; // Not used by the game's shaders
+            }
+        }
+    }
+    glUseProgram((GLuint)previous);
+}
+
+// #version has to stay the first line; #line keeps compiler messages
+// pointing at the lines of the file
+void insertDefines(std::string& code, const std::string& defines) {
+    size_t position = 0;
+    if (code.compare(0, 8, "#version") == 0) {
+        position = code.find('\n');
+        position = position == std::string::npos ? code.size() : position + 1;
+    }
+    code.insert(position, defines + "#line " + (position ? "2" : "1") + "\n");
+}
+
+std::string cachePath(uint64_t key) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)key);
+    return std::string(kCacheDirectory) + "/" + name;
+}
+} // namespace
+
+Shader::Shader(const char* vertexPath, const char* fragmentPath,
+               const std::string& defines)
+    : ID(0), vertexPath(vertexPath), fragmentPath(fragmentPath),
+      defines(defines), buildProgram(0), vertexShader(0), fragmentShader(0), pending(false),
+      linked(false), cacheKey(0) {
     std::string vertexCode;
     std::string fragmentCode;
+    readSources(vertexCode, fragmentCode);
+    build(vertexCode, fragmentCode);
+}
+
+Shader::~Shader() {
+    discardBuild();
+    glDeleteProgram(ID);
+}
+
+bool Shader::readSources(std::string& vertexCode, std::string& fragmentCode) const {
     std::ifstream vShaderFile;
     std::ifstream fShaderFile;
 
@@ -25,44 +193,223 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath) {
     }
     catch (std::ifstream::failure& e) {
         std::cerr << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << e.what() << std::endl;
+        return false;
     }
 
+    if (!defines.empty()) {
+        insertDefines(vertexCode, defines);
+        insertDefines(fragmentCode, defines);
+    }
+    return true;
+}
+
+void Shader::build(const std::string& vertexCode, const std::string& fragmentCode) {
+    // A binary only fits the driver that produced it
+    uint64_t key = 14695981039346656037ull;
+    key = hashBytes(key, &kCacheVersion, sizeof(kCacheVersion));
+    key = hashString(key, vertexCode.c_str());
+    key = hashString(key, fragmentCode.c_str());
+    key = hashString(key, (const char*)glGetString(GL_VENDOR));
+    key = hashString(key, (const char*)glGetString(GL_RENDERER));
+    key = hashString(key, (const char*)glGetString(GL_VERSION));
+    cacheKey = key;
+
+    if (loadBinary())
+        return;
+    compile(vertexCode, fragmentCode);
+}
+
+void Shader::compile(const std::string& vertexCode, const std::string& fragmentCode) {
+    parallelCompileSupported();
+
     const char* vShaderCode = vertexCode.c_str();
     const char* fShaderCode = fragmentCode.c_str();
 
-    GLuint vertex, fragment;
-
     // Vertex shader
-    vertex = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertex, 1, &vShaderCode, NULL);
-    glCompileShader(vertex);
-    checkCompileErrors(vertex, "VERTEX");
+    vertexShader = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vertexShader, 1, &vShaderCode, NULL);
+    glCompileShader(vertexShader);
 
     // Fragment shader
-    fragment = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragment, 1, &fShaderCode, NULL);
-    glCompileShader(fragment);
-    checkCompileErrors(fragment, "FRAGMENT");
+    fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fragmentShader, 1, &fShaderCode, NULL);
+    glCompileShader(fragmentShader);
 
     // Shader program
-    ID = glCreateProgram();
-    glAttachShader(ID, vertex);
-    glAttachShader(ID, fragment);
+    buildProgram = glCreateProgram();
+    glAttachShader(buildProgram, vertexShader);
+    glAttachShader(buildProgram, fragmentShader);
     
     // Bind attribute locations BEFORE linking (required for GLSL 1.20)
-    glBindAttribLocation(ID, 0, "aPos");
-    glBindAttribLocation(ID, 1, "aNormal");
-    glBindAttribLocation(ID, 2, "aTexCoord");
-    
-    glLinkProgram(ID);
-    checkCompileErrors(ID, "PROGRAM");
+    glBindAttribLocation(buildProgram, 0, "aPos");
+    glBindAttribLocation(buildProgram, 1, "aNormal");
+    glBindAttribLocation(buildProgram, 2, "aTexCoord");
+    glBindAttribLocation(buildProgram, 3, "aPosScale");
+    glBindAttribLocation(buildProgram, 4, "aPosOffset");
 
-    glDeleteShader(vertex);
-    glDeleteShader(fragment);
+    if (binaryCacheSupported())
+        glProgramParameteri(buildProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+    // No status queries here: they would wait for the compile, finish()
+    // checks once every program was submitted
+    glLinkProgram(buildProgram);
+    pending = true;
 }
 
-Shader::~Shader() {
-    glDeleteProgram(ID);
+void Shader::discardBuild() {
+    if (vertexShader)
+        glDeleteShader(vertexShader);
+    if (fragmentShader)
+        glDeleteShader(fragmentShader);
+    if (buildProgram)
+        glDeleteProgram(buildProgram);
+    vertexShader = 0;
+    fragmentShader = 0;
+    buildProgram = 0;
+    pending = false;
+}
+
+bool Shader::isReady() const {
+    if (!pending || !parallelCompileSupported())
+        return true;
+    GLint complete = GL_TRUE;
+    glGetProgramiv(buildProgram, GL_COMPLETION_STATUS_KHR, &complete);
+    return complete == GL_TRUE;
+}
+
+bool Shader::finish() {
+    if (!pending)
+        return linked;
+    pending = false;
+
+    bool compiled = checkCompileErrors(vertexShader, "VERTEX");
+    compiled = checkCompileErrors(fragmentShader, "FRAGMENT") && compiled;
+    bool success = compiled && checkCompileErrors(buildProgram, "PROGRAM");
+
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+    vertexShader = 0;
+    fragmentShader = 0;
+
+    GLuint program = buildProgram;
+    buildProgram = 0;
+    if (success) {
+        adopt(program);
+        saveBinary();
+    } else if (ID == 0) {
+        // Nothing older to fall back to, keep the broken program
+        ID = program;
+    } else {
+        glDeleteProgram(program);
+        std::cerr << "ERROR::SHADER::RELOAD_FAILED keeping the previous program: "
+                  << vertexPath << ", " << fragmentPath << std::endl;
+        return false;
+    }
+    linked = success;
+    return success;
+}
+
+bool Shader::usesFile(const std::string& path) const {
+    return path == vertexPath || path == fragmentPath;
+}
+
+void Shader::reload() {
+    std::string vertexCode;
+    std::string fragmentCode;
+    if (!readSources(vertexCode, fragmentCode))
+        return;
+
+    // A newer edit replaces a build that is still compiling
+    discardBuild();
+    build(vertexCode, fragmentCode);
+    if (!pending)
+        std::cout << "Reloaded shader from cache: " << fragmentPath << std::endl;
+}
+
+bool Shader::update() {
+    if (!pending || !isReady())
+        return false;
+    if (!finish())
+        return false;
+    std::cout << "Reloaded shader: " << fragmentPath << std::endl;
+    return true;
+}
+
+void Shader::adopt(GLuint program) {
+    if (ID) {
+        // Values set once (samplers, constants) carry over to the new program
+        copyUniforms(ID, program);
+        glDeleteProgram(ID);
+    }
+    ID = program;
+    linked = true;
+}
+
+bool Shader::loadBinary() {
+    if (!binaryCacheSupported())
+        return false;
+
+    std::ifstream file(cachePath(cacheKey), std::ios::binary);
+    if (!file)
+        return false;
+    CacheHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, kCacheMagic, sizeof(kCacheMagic)) != 0 ||
+        header.version != kCacheVersion || header.key != cacheKey)
+        return false;
+    std::vector<char> binary(header.length);
+    if (!file.read(binary.data(), binary.size()))
+        return false;
+
+    // Drivers may reject their own binaries after an update; compiling from
+    // source replaces the stale file
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, header.format, binary.data(), (GLsizei)binary.size());
+    GLint success = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        glDeleteProgram(program);
+        return false;
+    }
+    adopt(program);
+    return true;
+}
+
+void Shader::saveBinary() const {
+    if (!binaryCacheSupported())
+        return;
+
+    GLint length = 0;
+    glGetProgramiv(ID, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(ID, length, &length, &format, binary.data());
+
+    CacheHeader header;
+    std::memcpy(header.magic, kCacheMagic, sizeof(kCacheMagic));
+    header.version = kCacheVersion;
+    header.key = cacheKey;
+    header.format = format;
+    header.length = (uint32_t)length;
+
+    // Written aside and renamed, so another instance never reads half a file.
+    // Failing to write only costs the next launch a compile.
+    std::error_code error;
+    std::filesystem::create_directories(kCacheDirectory, error);
+    std::string path = cachePath(cacheKey);
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file)
+            return;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(binary.data(), length);
+        if (!file)
+            return;
+    }
+    std::filesystem::rename(temporary, path, error);
 }
 
 void Shader::use() const {
@@ -97,7 +444,7 @@ void Shader::setMat3(const std::string& name, const glm::mat3& mat) const {
     glUniformMatrix3fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
 }
 
-void Shader::checkCompileErrors(GLuint shader, const std::string& type) {
+bool Shader::checkCompileErrors(GLuint shader, const std::string& type) {
     GLint success;
     GLchar infoLog[1024];
     if (type != "PROGRAM") {
@@ -116,4 +463,40 @@ void Shader::checkCompileErrors(GLuint shader, const std::string& type) {
                       << infoLog << std::endl;
         }
     }
+    return success == GL_TRUE;
+}
+
+ShaderPermutations::ShaderPermutations(const char* vertexPath, const char* fragmentPath,
+                                       DefinesFunction definesFor)
+    : vertexPath(vertexPath), fragmentPath(fragmentPath), definesFor(definesFor) {}
+
+void ShaderPermutations::prepare(uint32_t key) {
+    std::unique_ptr<Shader>& variant = variants[key];
+    if (!variant) {
+        variant = std::make_unique<Shader>(vertexPath.c_str(), fragmentPath.c_str(),
+                                           definesFor(key));
+    }
+}
+
+Shader* ShaderPermutations::get(uint32_t key) {
+    prepare(key);
+    Shader* variant = variants[key].get();
+    // Only a first build is waited for; reloads finish through update()
+    if (variant->ID == 0)
+        variant->finish();
+    return variant->isLinked() ? variant : nullptr;
+}
+
+bool ShaderPermutations::usesFile(const std::string& path) const {
+    return path == vertexPath || path == fragmentPath;
+}
+
+void ShaderPermutations::reload() {
+    for (auto& variant : variants)
+        variant.second->reload();
+}
+
+void ShaderPermutations::update() {
+    for (auto& variant : variants)
+        variant.second->update();
 }
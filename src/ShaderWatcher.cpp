@@ -0,0 +1,132 @@
+#include "ShaderWatcher.h"
+#include <algorithm>
+#include <iostream>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace {
+const std::chrono::milliseconds kScanInterval(500);
+
+std::filesystem::file_time_type modificationTime(const std::string &path) {
+  std::error_code error;
+  std::filesystem::file_time_type time =
+      std::filesystem::last_write_time(path, error);
+  return error ? std::filesystem::file_time_type::min() : time;
+}
+
+void addOnce(std::vector<std::string> &changed, const std::string &path) {
+  if (std::find(changed.begin(), changed.end(), path) == changed.end())
+    changed.push_back(path);
+}
+} // namespace
+
+ShaderWatcher::ShaderWatcher()
+    : inotifyFd(-1), nextScan(std::chrono::steady_clock::now()) {
+#ifdef __linux__
+  inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (inotifyFd < 0) {
+    std::cerr << "ERROR::SHADER_WATCHER::INOTIFY_FAILED, polling file times"
+              << std::endl;
+  }
+#endif
+}
+
+ShaderWatcher::~ShaderWatcher() {
+#ifdef __linux__
+  if (inotifyFd >= 0)
+    close(inotifyFd);
+#endif
+}
+
+void ShaderWatcher::watch(const std::string &path) {
+  for (const File &file : files) {
+    if (file.path == path)
+      return;
+  }
+
+  std::filesystem::path fsPath(path);
+  File file;
+  file.path = path;
+  file.directory = fsPath.has_parent_path() ? fsPath.parent_path().string()
+                                            : std::string(".");
+  file.name = fsPath.filename().string();
+  file.modified = modificationTime(path);
+  files.push_back(file);
+
+#ifdef __linux__
+  if (inotifyFd < 0)
+    return;
+  for (const auto &directory : watchedDirectories) {
+    if (directory.second == file.directory)
+      return;
+  }
+  // Watch the directory rather than the file: editors that save by writing
+  // a new file and renaming it over the old one replace the watched inode.
+  int wd = inotify_add_watch(inotifyFd, file.directory.c_str(),
+                             IN_CLOSE_WRITE | IN_MOVED_TO);
+  if (wd < 0) {
+    std::cerr << "ERROR::SHADER_WATCHER::WATCH_FAILED " << file.directory
+              << ", polling file times" << std::endl;
+    close(inotifyFd);
+    inotifyFd = -1;
+    return;
+  }
+  watchedDirectories.push_back(std::make_pair(wd, file.directory));
+#endif
+}
+
+void ShaderWatcher::poll(std::vector<std::string> &changed) {
+  if (inotifyFd >= 0)
+    pollInotify(changed);
+  else
+    pollModificationTimes(changed);
+}
+
+void ShaderWatcher::pollInotify(std::vector<std::string> &changed) {
+#ifdef __linux__
+  alignas(struct inotify_event) char buffer[4096];
+  while (true) {
+    ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+    if (length <= 0)
+      return; // EAGAIN: nothing more queued
+
+    for (ssize_t offset = 0; offset < length;) {
+      const struct inotify_event *event =
+          reinterpret_cast<const struct inotify_event *>(buffer + offset);
+      offset += sizeof(struct inotify_event) + event->len;
+      if (event->len == 0)
+        continue;
+
+      std::string directory;
+      for (const auto &watched : watchedDirectories) {
+        if (watched.first == event->wd)
+          directory = watched.second;
+      }
+      for (const File &file : files) {
+        if (file.directory == directory && file.name == event->name)
+          addOnce(changed, file.path);
+      }
+    }
+  }
+#else
+  (void)changed;
+#endif
+}
+
+void ShaderWatcher::pollModificationTimes(std::vector<std::string> &changed) {
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  if (now < nextScan)
+    return;
+  nextScan = now + kScanInterval;
+
+  for (File &file : files) {
+    std::filesystem::file_time_type modified = modificationTime(file.path);
+    if (modified != file.modified) {
+      file.modified = modified;
+      addOnce(changed, file.path);
+    }
+  }
+}
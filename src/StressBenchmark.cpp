@@ -0,0 +1,233 @@
+#include "StressBenchmark.h"
+#include "Camera.h"
+#include "FrameAllocator.h"
+#include "HeadlessContext.h"
+#include "RenderSnapshot.h"
+#include "StressLevel.h"
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+const float kScaleSteps[] = {1.0f / 16, 1.0f / 8, 1.0f / 4, 1.0f / 2, 1.0f};
+
+// Untimed ticks before measuring (first-touch allocations, job warm-up)
+const int kWarmupTicks = 30;
+
+// The scripted player walks a slow circle through the level
+const float kTurnRate = 0.5f; // Radians per second
+
+enum Subsystem {
+  LEVEL_OBJECTS,
+  LEVEL_HAZARDS,
+  LEVEL_EFFECTS,
+  LEVEL_COLLISIONS,
+  LEVEL_UPDATE,
+  PARTICLES_UPDATE,
+  LEVEL_DRAW,
+  LEVEL_DRAW_LIGHTS,
+  SUBSYSTEM_COUNT
+};
+
+const char *const kSubsystemNames[SUBSYSTEM_COUNT] = {
+    "level_objects", "level_hazards",    "level_effects", "level_collisions",
+    "level_update",  "particles_update", "level_draw",    "level_draw_lights"};
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
+struct Summary {
+  double mean;
+  double p95;
+  double max;
+};
+
+// Per-tick samples in seconds to a summary in milliseconds
+Summary summarize(std::vector<double> &samples) {
+  Summary summary = {0.0, 0.0, 0.0};
+  if (samples.empty())
+    return summary;
+  std::sort(samples.begin(), samples.end());
+  double total = 0.0;
+  for (double sample : samples)
+    total += sample;
+  summary.mean = 1000.0 * total / samples.size();
+  summary.p95 = 1000.0 * samples[(samples.size() - 1) * 95 / 100];
+  summary.max = 1000.0 * samples.back();
+  return summary;
+}
+
+// Invisible window, only for its GL context
+GLFWwindow *createHiddenContext() {
+  if (!glfwInit()) {
+    std::cerr << "Failed to initialize GLFW" << std::endl;
+    return nullptr;
+  }
+  glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+  glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef __APPLE__
+  glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+  GLFWwindow *window = glfwCreateWindow(64, 64, "Chrono Guardian benchmark",
+                                        nullptr, nullptr);
+  if (!window) {
+    std::cerr << "Failed to create GL context" << std::endl;
+    glfwTerminate();
+    return nullptr;
+  }
+  glfwMakeContextCurrent(window);
+  glewExperimental = GL_TRUE;
+  if (glewInit() != GLEW_OK) {
+    std::cerr << "Failed to initialize GLEW" << std::endl;
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return nullptr;
+  }
+  return window;
+}
+
+// Runs one stress level size and appends its rows to the CSV
+void runStep(const StressLevelConfig &config, const GameSettings &settings,
+             ParticleSystem &particles, std::ofstream &csv) {
+  const float dt = 1.0f / settings.tickRate;
+  const float aspect = (float)settings.windowWidth / settings.windowHeight;
+
+  auto buildStart = std::chrono::steady_clock::now();
+  StressLevel level(config);
+  level.init();
+  double buildTime = secondsSince(buildStart);
+  level.setProfiling(true);
+
+  Player player;
+  player.reset(level.playerStartPosition);
+  particles.clear();
+  Camera camera;
+  camera.mode = CameraMode::THIRD_PERSON;
+  RenderSnapshot snapshot;
+
+  std::vector<double> samples[SUBSYSTEM_COUNT];
+  for (auto &subsystem : samples)
+    subsystem.reserve(settings.benchmarkTicks);
+
+  for (int tick = 0; tick < kWarmupTicks + settings.benchmarkTicks; tick++) {
+    FrameAllocator::getInstance().reset();
+
+    float heading = tick * dt * kTurnRate;
+    player.update(dt, glm::vec3(std::cos(heading), 0.0f, std::sin(heading)),
+                  false);
+    camera.setThirdPersonMode(player.getPosition());
+    camera.updateCameraVectors();
+    level.setActivityView(Frustum::fromMatrix(
+        camera.getProjectionMatrix(aspect) * camera.getViewMatrix()));
+
+    auto start = std::chrono::steady_clock::now();
+    level.update(dt, &player, &particles);
+    double updateTime = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    particles.update(dt);
+    double particleTime = secondsSince(start);
+
+    snapshot.clear();
+    start = std::chrono::steady_clock::now();
+    level.drawLights(snapshot);
+    double lightsTime = secondsSince(start);
+    start = std::chrono::steady_clock::now();
+    level.draw(snapshot);
+    double drawTime = secondsSince(start);
+
+    // Keep the run going through deaths and falls
+    if (player.isDead() || level.shouldRestart ||
+        player.getPosition().y < -5.0f) {
+      player.reset(level.playerStartPosition);
+      player.resetHealth();
+      level.shouldRestart = false;
+    }
+
+    if (tick < kWarmupTicks)
+      continue;
+    const Level::UpdateProfile &profile = level.getLastProfile();
+    samples[LEVEL_OBJECTS].push_back(profile.objects);
+    samples[LEVEL_HAZARDS].push_back(profile.hazards);
+    samples[LEVEL_EFFECTS].push_back(profile.effects);
+    samples[LEVEL_COLLISIONS].push_back(profile.collisions);
+    samples[LEVEL_UPDATE].push_back(updateTime);
+    samples[PARTICLES_UPDATE].push_back(particleTime);
+    samples[LEVEL_DRAW].push_back(drawTime);
+    samples[LEVEL_DRAW_LIGHTS].push_back(lightsTime);
+  }
+
+  std::printf("\n%d walls, %d pendulums, %d stalactites, %d geysers, "
+              "%d lights, %d particles (built in %.1f ms)\n",
+              config.walls, config.pendulums, config.stalactites,
+              config.geysers, config.lights, config.particles,
+              1000.0 * buildTime);
+  std::printf("  %-18s %10s %10s %10s\n", "subsystem", "mean ms", "p95 ms",
+              "max ms");
+  for (int i = 0; i < SUBSYSTEM_COUNT; i++) {
+    Summary summary = summarize(samples[i]);
+    std::printf("  %-18s %10.4f %10.4f %10.4f\n", kSubsystemNames[i],
+                summary.mean, summary.p95, summary.max);
+    csv << config.walls << ',' << config.pendulums << ','
+        << config.stalactites << ',' << config.geysers << ','
+        << config.lights << ',' << config.particles << ','
+        << kSubsystemNames[i] << ',' << summary.mean << ',' << summary.p95
+        << ',' << summary.max << '\n';
+  }
+}
+} // namespace
+
+int runStressBenchmark(const GameSettings &settings) {
+  std::ofstream csv(settings.stressBenchmarkPath);
+  if (!csv) {
+    std::cerr << "Cannot write " << settings.stressBenchmarkPath << std::endl;
+    return 1;
+  }
+  csv << "walls,pendulums,stalactites,geysers,lights,particles,subsystem,"
+         "mean_ms,p95_ms,max_ms\n";
+
+  // Meshes upload on creation, so a GL context is needed even though
+  // nothing is drawn: a hidden window, or EGL with --headless
+  HeadlessContext headless;
+  GLFWwindow *window = nullptr;
+  if (settings.headless) {
+    if (!headless.create())
+      return 1;
+  } else {
+    window = createHiddenContext();
+    if (!window)
+      return 1;
+  }
+
+  std::cout << "Stress benchmark: seed " << settings.stress.seed << ", "
+            << settings.benchmarkTicks << " ticks per size at "
+            << settings.tickRate << " Hz" << std::endl;
+
+  {
+    // Sized for the largest step; GL objects go before the context
+    ParticleSystem particles(std::max(1, settings.stress.particles));
+    for (float scale : kScaleSteps) {
+      runStep(settings.stress.scaled(scale), settings, particles, csv);
+      csv.flush();
+    }
+  }
+
+  if (window) {
+    glfwDestroyWindow(window);
+    glfwTerminate();
+  }
+  std::cout << "\nWrote " << settings.stressBenchmarkPath << std::endl;
+  return 0;
+}
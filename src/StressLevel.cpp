@@ -0,0 +1,142 @@
+#include "StressLevel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+// Floor area per wall, about what the shipped levels have
+const float kAreaPerWall = 36.0f;
+const float kMinHalfSize = 30.0f;
+
+// Nothing spawns this close to the player start
+const float kStartClearance = 6.0f;
+
+// One wall in this many is rotated, to exercise the oriented-box paths
+const int kRotatedWallEvery = 8;
+
+const float kWallHeight = 4.0f;
+} // namespace
+
+StressLevel::StressLevel(const StressLevelConfig &config)
+    : config(config), halfSize(kMinHalfSize), rng(config.seed) {
+  playerStartPosition = glm::vec3(0.0f, 1.0f, 0.0f);
+  halfSize = std::max(kMinHalfSize,
+                      0.5f * std::sqrt(config.walls * kAreaPerWall));
+}
+
+void StressLevel::init() {
+  // Hazards and collectibles seed their own randomness from rand()
+  srand(config.seed);
+
+  // Floor with its top at y = 0
+  createWall(glm::vec3(0.0f, -0.5f, 0.0f),
+             glm::vec3(2.0f * halfSize, 1.0f, 2.0f * halfSize),
+             glm::vec3(0.45f, 0.45f, 0.5f));
+
+  createWalls();
+  createHazards();
+  createLights();
+
+  std::cout << "Generated stress level (seed " << config.seed << "): "
+            << walls.size() << " walls, " << entities.size() << " hazards, "
+            << lights.size() << " lights on a " << 2.0f * halfSize << "x"
+            << 2.0f * halfSize << " floor" << std::endl;
+}
+
+glm::vec3 StressLevel::randomPosition(float y, float clearance) {
+  std::uniform_real_distribution<float> coordinate(-halfSize + 1.0f,
+                                                   halfSize - 1.0f);
+  glm::vec3 position;
+  do {
+    position = glm::vec3(coordinate(rng), y, coordinate(rng));
+  } while (glm::length(glm::vec2(position.x - playerStartPosition.x,
+                                 position.z - playerStartPosition.z)) <
+           clearance);
+  return position;
+}
+
+void StressLevel::createWalls() {
+  std::uniform_real_distribution<float> length(2.0f, 8.0f);
+  std::uniform_real_distribution<float> shade(0.3f, 0.7f);
+  std::uniform_real_distribution<float> yaw(0.0f, glm::radians(180.0f));
+  std::bernoulli_distribution alongX(0.5);
+
+  walls.reserve(walls.size() + config.walls);
+  for (int i = 0; i < config.walls; i++) {
+    glm::vec3 position = randomPosition(kWallHeight / 2, kStartClearance);
+    float wallLength = length(rng);
+    glm::vec3 color(shade(rng), 0.35f, 0.3f);
+
+    if (i % kRotatedWallEvery == kRotatedWallEvery - 1) {
+      auto wall = arena.make<GameObject>(GameObjectType::STATIC_WALL);
+      wall->transform.position = position;
+      wall->transform.scale = glm::vec3(1.0f, kWallHeight, wallLength);
+      wall->transform.rotate(yaw(rng), glm::vec3(0.0f, 1.0f, 0.0f));
+      wall->mesh.reset(Mesh::createCube(1.0f));
+      wall->color = color;
+      wall->materialType = 1;
+      wall->updateBoundingBox();
+      walls.push_back(std::move(wall));
+    } else {
+      glm::vec3 size = alongX(rng) ? glm::vec3(wallLength, kWallHeight, 1.0f)
+                                   : glm::vec3(1.0f, kWallHeight, wallLength);
+      createWall(position, size, color, 1);
+    }
+  }
+}
+
+void StressLevel::createHazards() {
+  std::uniform_real_distribution<float> swingSpeed(1.5f, 2.5f);
+  std::uniform_real_distribution<float> phase(0.0f, glm::radians(360.0f));
+
+  entities.reserve(config.pendulums, config.stalactites, config.geysers);
+  for (int i = 0; i < config.pendulums; i++) {
+    entities.addPendulum(randomPosition(8.0f, kStartClearance), 6.0f,
+                         swingSpeed(rng), phase(rng),
+                         glm::vec3(5.0f, 3.0f, 0.5f));
+  }
+  for (int i = 0; i < config.stalactites; i++) {
+    entities.addStalactite(randomPosition(13.0f, kStartClearance),
+                           glm::vec3(0.8f, 4.0f, 0.8f));
+  }
+  for (int i = 0; i < config.geysers; i++) {
+    entities.addGeyser(randomPosition(0.0f, kStartClearance));
+  }
+}
+
+void StressLevel::createLights() {
+  std::uniform_real_distribution<float> warmth(0.6f, 1.0f);
+  std::uniform_real_distribution<float> intensity(2.0f, 4.0f);
+  std::uniform_real_distribution<float> flickerSpeed(1.0f, 2.0f);
+
+  lights.reserve(lights.size() + config.lights);
+  for (int i = 0; i < config.lights; i++) {
+    Light light;
+    light.position = randomPosition(10.0f, 0.0f);
+    light.color = glm::vec3(1.0f, warmth(rng), 0.6f);
+    light.baseIntensity = intensity(rng);
+    light.intensity = light.baseIntensity;
+    if (i % 2 == 0) { // Half of them flicker like torches
+      light.flickerSpeed = flickerSpeed(rng);
+      light.flickerAmount = 0.3f;
+    }
+    lights.push_back(light);
+  }
+}
+
+void StressLevel::update(float deltaTime, Player *player,
+                         ParticleSystem *particles) {
+  Level::update(deltaTime, player, particles);
+
+  // Keep the particle system at the configured load: replace whatever
+  // expired this tick with slow, long-lived sparks around the level
+  int missing = config.particles - particles->getParticleCount();
+  std::uniform_real_distribution<float> height(0.5f, 6.0f);
+  std::uniform_real_distribution<float> lifetime(2.0f, 6.0f);
+  for (int i = 0; i < missing; i++) {
+    particles->emit(randomPosition(height(rng), 0.0f),
+                    glm::vec3(0.0f, 0.5f, 0.0f),
+                    glm::vec4(1.0f, 0.7f, 0.3f, 1.0f), 2.0f, lifetime(rng));
+  }
+}
@@ -0,0 +1,141 @@
+#include "WavDecoder.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace {
+uint16_t readU16(const unsigned char *bytes) {
+  return (uint16_t)(bytes[0] | (bytes[1] << 8));
+}
+
+uint32_t readU32(const unsigned char *bytes) {
+  return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) |
+         ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+// The data chunk's payload to 16-bit samples
+bool decodeSamples(const unsigned char *data, size_t size,
+                   uint16_t audioFormat, uint16_t bitsPerSample,
+                   std::vector<short> &samples, const std::string &name) {
+  if (bitsPerSample == 8) {
+    // 8-bit is unsigned 0..255, center at 128
+    samples.resize(size);
+    for (size_t i = 0; i < size; ++i) {
+      // Convert [0, 255] -> [-32768, 32767]
+      samples[i] = (short)((static_cast<int>(data[i]) - 128) * 256);
+    }
+  } else if (bitsPerSample == 16) {
+    // Standard signed 16-bit
+    samples.resize(size / 2);
+    for (size_t i = 0; i < samples.size(); ++i)
+      samples[i] = (short)readU16(data + i * 2);
+  } else if (bitsPerSample == 24) {
+    // 24-bit PCM: 3 bytes per sample, keep the top 16 bits
+    samples.resize(size / 3);
+    for (size_t i = 0; i < samples.size(); ++i) {
+      const unsigned char *sample = data + i * 3;
+      int32_t value = sample[0] | (sample[1] << 8) | (sample[2] << 16);
+      // Sign extend if negative
+      if (value & 0x800000)
+        value |= (int32_t)0xFF000000;
+      samples[i] = static_cast<short>(value >> 8);
+    }
+  } else if (bitsPerSample == 32) {
+    samples.resize(size / 4);
+    if (audioFormat == 3) { // IEEE Float
+      for (size_t i = 0; i < samples.size(); ++i) {
+        uint32_t bits = readU32(data + i * 4);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        value = std::max(-1.0f, std::min(1.0f, value));
+        samples[i] = static_cast<short>(value * 32767.0f);
+      }
+    } else if (audioFormat == 1 ||
+               audioFormat == 65534) { // PCM (standard or extensible)
+      for (size_t i = 0; i < samples.size(); ++i) {
+        // Scale down 32-bit to 16-bit (drop lower 16 bits)
+        samples[i] = static_cast<short>((int32_t)readU32(data + i * 4) >> 16);
+      }
+    } else {
+      std::cerr << "Unsupported 32-bit format (" << audioFormat
+                << "): " << name << std::endl;
+      samples.clear();
+      return false;
+    }
+  } else {
+    std::cerr << "Unsupported bit depth: " << bitsPerSample << " in " << name
+              << std::endl;
+    samples.clear();
+    return false;
+  }
+  return !samples.empty();
+}
+} // namespace
+
+bool decodeWav(const unsigned char *data, size_t size,
+               std::vector<short> &samples, int &sampleRate,
+               const std::string &name) {
+  if (size < 12 || std::memcmp(data, "RIFF", 4) != 0) {
+    std::cerr << "Invalid WAV file (no RIFF): " << name << std::endl;
+    return false;
+  }
+  if (std::memcmp(data + 8, "WAVE", 4) != 0) {
+    std::cerr << "Invalid WAV file (no WAVE): " << name << std::endl;
+    return false;
+  }
+
+  // Walk the chunks for the format, then the samples
+  uint16_t audioFormat = 0;
+  uint16_t bitsPerSample = 0;
+  bool formatFound = false;
+
+  size_t offset = 12;
+  while (offset + 8 <= size) {
+    const unsigned char *chunk = data + offset;
+    uint32_t chunkSize = readU32(chunk + 4);
+    size_t available = std::min<size_t>(chunkSize, size - offset - 8);
+
+    if (std::memcmp(chunk, "fmt ", 4) == 0) {
+      if (available < 16) {
+        std::cerr << "WAV format chunk too short: " << name << std::endl;
+        return false;
+      }
+      audioFormat = readU16(chunk + 8);
+      sampleRate = (int)readU32(chunk + 12);
+      bitsPerSample = readU16(chunk + 22);
+      formatFound = true;
+    } else if (std::memcmp(chunk, "data", 4) == 0) {
+      if (!formatFound) {
+        std::cerr << "WAV data chunk before format chunk: " << name
+                  << std::endl;
+        return false;
+      }
+      return decodeSamples(chunk + 8, available, audioFormat, bitsPerSample,
+                           samples, name);
+    }
+
+    // Chunks are padded to an even size
+    offset += 8 + (size_t)chunkSize + (chunkSize & 1);
+  }
+  return false;
+}
+
+bool loadWav(const std::string &path, std::vector<short> &samples,
+             int &sampleRate) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    std::cerr << "Failed to open WAV file: " << path << std::endl;
+    return false;
+  }
+  std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(file)),
+                                   std::istreambuf_iterator<char>());
+
+  if (!decodeWav(bytes.data(), bytes.size(), samples, sampleRate, path))
+    return false;
+  std::cout << "Loaded WAV file: " << path << " (" << samples.size()
+            << " samples, " << sampleRate << " Hz)" << std::endl;
+  return true;
+}
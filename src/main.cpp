@@ -1,14 +1,26 @@
 #include "Game.h"
+#include "GameSettings.h"
+#include "StressBenchmark.h"
 #include <iostream>
 
 int main(int argc, char **argv) {
+  GameSettings settings = GameSettings::fromArgs(argc, argv);
+  if (settings.showHelp) {
+    GameSettings::printUsage(argv[0]);
+    return 0;
+  }
+
   std::cout << "====================================" << std::endl;
   std::cout << "    CHRONO GUARDIAN" << std::endl;
   std::cout << "    3D Puzzle Platformer" << std::endl;
   std::cout << "====================================" << std::endl;
   std::cout << std::endl;
 
-  Game game;
+  if (!settings.stressBenchmarkPath.empty()) {
+    return runStressBenchmark(settings);
+  }
+
+  Game game(settings);
 
   if (!game.init()) {
     std::cerr << "Failed to initialize game!" << std::endl;
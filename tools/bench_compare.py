@@ -0,0 +1,253 @@
+#!/usr/bin/env python3
+"""Compare two benchmark result files and flag performance regressions.
+
+Reads a baseline and a candidate result of the same kind:
+
+  * engine_bench / Google Benchmark JSON (--benchmark_out). Every
+    repetition is one sample; aggregate rows are ignored and recomputed.
+  * flythrough CSV (--flythrough). Every frame is one sample of each
+    column: cpu_ms, gpu_ms, draw_calls, triangles, state_changes.
+  * stress benchmark CSV (--stress-benchmark). One summary value per row
+    and subsystem, so only the threshold applies, without a significance
+    test.
+
+For each benchmark present in both files it reports the median change, the
+noise of each side as the median absolute deviation (MAD), and a two-sided
+Mann-Whitney U test p-value. A benchmark regresses when its median got
+slower by more than --threshold percent AND the difference is significant
+(p < --alpha). When a side has fewer than --min-samples samples there is no
+meaningful test, and the threshold alone decides.
+
+Lower is better for every metric. Exit status is 1 when anything regressed,
+so the script can gate a merge (see the bench_gate CMake target).
+
+Usage:
+  bench_compare.py BASELINE CANDIDATE [--threshold 5] [--alpha 0.01]
+                   [--min-samples 5] [--metric real_time|cpu_time]
+                   [--filter TEXT]
+"""
+
+import argparse
+import csv
+import json
+import math
+import os
+import sys
+
+
+# --- Loading -----------------------------------------------------------------
+
+
+def load_google_benchmark(path, metric):
+    with open(path) as f:
+        data = json.load(f)
+    samples = {}
+    for entry in data.get("benchmarks", []):
+        if entry.get("run_type", "iteration") != "iteration":
+            continue
+        if entry.get("error_occurred"):
+            continue
+        name = entry.get("run_name", entry["name"])
+        samples.setdefault(name, []).append(float(entry[metric]))
+    return samples, "ns"
+
+
+def load_flythrough(rows):
+    samples = {}
+    columns = [c for c in rows[0].keys() if c != "frame"]
+    for row in rows:
+        for column in columns:
+            value = row[column].strip()
+            if value:  # gpu_ms is empty until its timer query reported
+                samples.setdefault("flythrough/" + column, []).append(
+                    float(value))
+    return samples, ""
+
+
+def load_stress(rows):
+    samples = {}
+    counts = ["walls", "pendulums", "stalactites", "geysers", "lights",
+              "particles"]
+    for row in rows:
+        size = "x".join(row[c] for c in counts)
+        for stat in ("mean_ms", "p95_ms"):
+            name = "stress/%s/%s/%s" % (size, row["subsystem"], stat)
+            samples[name] = [float(row[stat])]
+    return samples, "ms"
+
+
+def load(path, metric):
+    if not os.path.exists(path):
+        sys.exit("%s not found (record a baseline with the bench_baseline "
+                 "target first)" % path)
+    if path.endswith(".json"):
+        return load_google_benchmark(path, metric)
+    with open(path, newline="") as f:
+        rows = list(csv.DictReader(f))
+    if not rows:
+        sys.exit("%s: no rows" % path)
+    if "frame" in rows[0]:
+        return load_flythrough(rows)
+    if "subsystem" in rows[0]:
+        return load_stress(rows)
+    sys.exit("%s: unrecognized CSV columns %s" % (path, list(rows[0].keys())))
+
+
+# --- Statistics --------------------------------------------------------------
+
+
+def median(values):
+    ordered = sorted(values)
+    middle = len(ordered) // 2
+    if len(ordered) % 2:
+        return ordered[middle]
+    return 0.5 * (ordered[middle - 1] + ordered[middle])
+
+
+def mad(values):
+    center = median(values)
+    return median([abs(v - center) for v in values])
+
+
+def normal_sf(z):
+    """P(Z > z) for a standard normal."""
+    return 0.5 * math.erfc(z / math.sqrt(2.0))
+
+
+def exact_u_cdf(u, n1, n2):
+    """P(U <= u) without ties, by counting rank arrangements."""
+    # counts[i][j][k]: arrangements of i and j samples with U statistic k
+    max_u = n1 * n2
+    previous = [[0] * (max_u + 1) for _ in range(n2 + 1)]
+    for j in range(n2 + 1):
+        previous[j][0] = 1
+    for i in range(1, n1 + 1):
+        current = [[0] * (max_u + 1) for _ in range(n2 + 1)]
+        current[0][0] = 1
+        for j in range(1, n2 + 1):
+            for k in range(max_u + 1):
+                # Largest value is from the first sample (beats all j) or not
+                total = current[j - 1][k]
+                if k >= j:
+                    total += previous[j][k - j]
+                current[j][k] = total
+        previous = current
+    arrangements = previous[n2]
+    return sum(arrangements[: int(u) + 1]) / float(sum(arrangements))
+
+
+def mann_whitney(a, b):
+    """Two-sided Mann-Whitney U test p-value for samples a and b."""
+    n1, n2 = len(a), len(b)
+    combined = sorted([(v, 0) for v in a] + [(v, 1) for v in b])
+
+    # Ranks with ties averaged, plus the tie correction term
+    ranks = [0.0] * len(combined)
+    tie_term = 0.0
+    i = 0
+    while i < len(combined):
+        j = i
+        while j + 1 < len(combined) and combined[j + 1][0] == combined[i][0]:
+            j += 1
+        rank = 0.5 * (i + j) + 1.0
+        for k in range(i, j + 1):
+            ranks[k] = rank
+        ties = j - i + 1
+        tie_term += ties ** 3 - ties
+        i = j + 1
+
+    rank_sum = sum(r for r, (_, group) in zip(ranks, combined) if group == 0)
+    u1 = rank_sum - n1 * (n1 + 1) / 2.0
+    u = min(u1, n1 * n2 - u1)
+
+    if tie_term == 0.0 and n1 <= 12 and n2 <= 12:
+        return min(1.0, 2.0 * exact_u_cdf(u, n1, n2))
+
+    n = n1 + n2
+    variance = n1 * n2 / 12.0 * ((n + 1) - tie_term / (n * (n - 1)))
+    if variance <= 0.0:
+        return 1.0  # Every value identical
+    z = (n1 * n2 / 2.0 - u - 0.5) / math.sqrt(variance)  # Continuity corrected
+    return min(1.0, 2.0 * normal_sf(max(z, 0.0)))
+
+
+# --- Report ------------------------------------------------------------------
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Flag regressions between two benchmark result files.")
+    parser.add_argument("baseline")
+    parser.add_argument("candidate")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="slowdown in percent that counts (default 5)")
+    parser.add_argument("--alpha", type=float, default=0.01,
+                        help="significance level (default 0.01)")
+    parser.add_argument("--min-samples", type=int, default=5,
+                        help="fewer samples per side skips the test "
+                             "(default 5)")
+    parser.add_argument("--metric", default="real_time",
+                        choices=["real_time", "cpu_time"],
+                        help="JSON time to compare (default real_time)")
+    parser.add_argument("--filter", default="",
+                        help="only benchmarks whose name contains this")
+    args = parser.parse_args()
+
+    baseline, unit = load(args.baseline, args.metric)
+    candidate, _ = load(args.candidate, args.metric)
+    names = [n for n in baseline if n in candidate and args.filter in n]
+    if not names:
+        sys.exit("No benchmarks in common between %s and %s"
+                 % (args.baseline, args.candidate))
+
+    header = "%-44s %12s %12s %8s %10s %10s %8s  %s" % (
+        "benchmark", "base med", "cand med", "change", "base MAD",
+        "cand MAD", "p", "verdict")
+    print(header)
+    print("-" * len(header))
+
+    regressions = []
+    for name in names:
+        a, b = baseline[name], candidate[name]
+        base, cand = median(a), median(b)
+        change = 100.0 * (cand - base) / base if base else 0.0
+
+        tested = len(a) >= args.min_samples and len(b) >= args.min_samples
+        p = mann_whitney(a, b) if tested else None
+        significant = p is not None and p < args.alpha
+        if not tested:
+            significant = True  # Threshold only
+
+        if change > args.threshold and significant:
+            verdict = "REGRESSION"
+            regressions.append(name)
+        elif change < -args.threshold and significant:
+            verdict = "improved"
+        elif abs(change) > args.threshold:
+            verdict = "noise"
+        else:
+            verdict = ""
+        if not tested:
+            verdict += " (n<%d)" % args.min_samples
+
+        print("%-44s %12.4g %12.4g %+7.1f%% %10.3g %10.3g %8s  %s" % (
+            name, base, cand, change, mad(a), mad(b),
+            "%.3g" % p if p is not None else "-", verdict))
+
+    missing = sorted(set(baseline) ^ set(candidate))
+    if missing:
+        print("\nOnly in one file (not compared): %s" % ", ".join(missing))
+
+    unit_note = " (%s)" % unit if unit else ""
+    if regressions:
+        print("\n%d regression(s) over %.1f%%%s: %s" % (
+            len(regressions), args.threshold, unit_note,
+            ", ".join(regressions)))
+        return 1
+    print("\nNo regressions over %.1f%% across %d benchmarks%s." % (
+        args.threshold, len(names), unit_note))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
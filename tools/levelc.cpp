@@ -0,0 +1,55 @@
+// Level compiler: turns a level text source into the binary layout the game
+// maps at load time (format in include/LevelData.h). Run by the build for
+// every levels/*.txt; can also be run by hand while editing a layout.
+//
+// Usage: levelc <input.txt> <output.lvl>
+
+#include "LevelData.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+int main(int argc, char **argv) {
+  if (argc != 3) {
+    std::fprintf(stderr, "Usage: %s <input.txt> <output.lvl>\n", argv[0]);
+    return 1;
+  }
+
+  std::ifstream input(argv[1]);
+  if (!input) {
+    std::fprintf(stderr, "levelc: cannot open %s\n", argv[1]);
+    return 1;
+  }
+  std::stringstream source;
+  source << input.rdbuf();
+
+  std::vector<unsigned char> binary;
+  std::string error;
+  if (!LevelData::compile(source.str(), binary, error)) {
+    std::fprintf(stderr, "%s:%s\n", argv[1], error.c_str());
+    return 1;
+  }
+
+  // Closed before the check below reads the file back
+  {
+    std::ofstream output(argv[2], std::ios::binary | std::ios::trunc);
+    output.write(reinterpret_cast<const char *>(binary.data()),
+                 static_cast<std::streamsize>(binary.size()));
+    output.close();
+    if (!output) {
+      std::fprintf(stderr, "levelc: cannot write %s\n", argv[2]);
+      return 1;
+    }
+  }
+
+  // Sanity check: the output must load back
+  LevelData data;
+  if (!data.loadBinary(argv[2]))
+    return 1;
+  std::printf("%s: %u walls, %u pendulums, %u stalactites, %u geysers, "
+              "%u lights, %u props, %u coins (%zu bytes)\n",
+              argv[2], data.wallCount, data.pendulumCount,
+              data.stalactiteCount, data.geyserCount, data.lightCount,
+              data.propCount, data.coinCount, data.getByteSize());
+  return 0;
+}